@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2025.05.10
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -69,6 +69,13 @@ namespace gte
             return result.intersect;
         }
 
+        T GetSurfaceArea() const
+        {
+            T const two = static_cast<T>(2);
+            Vector3<T> diff = box.max - box.min;
+            return two * (diff[0] * diff[1] + diff[1] * diff[2] + diff[2] * diff[0]);
+        }
+
         AlignedBox3<T> box;
     };
 
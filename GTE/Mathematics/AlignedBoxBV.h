@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.3.2026.08.08
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -13,6 +13,10 @@
 #include <Mathematics/IntrLine3AlignedBox3.h>
 #include <Mathematics/IntrRay3AlignedBox3.h>
 #include <Mathematics/IntrSegment3AlignedBox3.h>
+#include <Mathematics/IntrAlignedBox3AlignedBox3.h>
+#include <Mathematics/IntrOrientedBox3OrientedBox3.h>
+#include <Mathematics/Matrix3x3.h>
+#include <algorithm>
 #include <cstdint>
 
 namespace gte
@@ -81,6 +85,66 @@ namespace gte
             return output.intersect;
         }
 
+        // Test for overlap of bounding volumes in the same coordinate
+        // system.
+        static bool Overlap(
+            AlignedBoxBV<T> const& boundingVolume0,
+            AlignedBoxBV<T> const& boundingVolume1)
+        {
+            TIQuery<T, AlignedBox3<T>, AlignedBox3<T>> query{};
+            auto output = query(boundingVolume0.box, boundingVolume1.box);
+            return output.intersect;
+        }
+
+        // Test for overlap when boundingVolume1 is transformed by the rigid
+        // motion X' = rotate * X + translate. The transformed box is no
+        // longer axis aligned, so the test is between oriented boxes.
+        static bool Overlap(
+            AlignedBoxBV<T> const& boundingVolume0,
+            AlignedBoxBV<T> const& boundingVolume1,
+            Matrix3x3<T> const& rotate,
+            Vector3<T> const& translate)
+        {
+            OrientedBox3<T> box0{}, box1{};
+            boundingVolume0.box.GetCenteredForm(box0.center, box0.extent);
+            boundingVolume1.box.GetCenteredForm(box1.center, box1.extent);
+            box1.center = rotate * box1.center + translate;
+            for (std::int32_t i = 0; i < 3; ++i)
+            {
+                box0.axis[i] = Vector3<T>::Unit(i);
+                box1.axis[i] = rotate.GetCol(i);
+            }
+
+            TIQuery<T, OrientedBox3<T>, OrientedBox3<T>> query{};
+            auto output = query(box0, box1);
+            return output.intersect;
+        }
+
+        T GetSurfaceArea() const
+        {
+            T const two = static_cast<T>(2);
+            Vector3<T> diff = box.max - box.min;
+            return two * (diff[0] * diff[1] + diff[1] * diff[2] + diff[2] * diff[0]);
+        }
+
+        // The smallest aligned box containing boundingVolume0 and
+        // boundingVolume1. The output may be the same object as either
+        // input.
+        static void Merge(
+            AlignedBoxBV<T> const& boundingVolume0,
+            AlignedBoxBV<T> const& boundingVolume1,
+            AlignedBoxBV<T>& boundingVolume)
+        {
+            auto const& box0 = boundingVolume0.box;
+            auto const& box1 = boundingVolume1.box;
+            auto& box = boundingVolume.box;
+            for (std::int32_t k = 0; k < 3; ++k)
+            {
+                box.min[k] = std::min(box0.min[k], box1.min[k]);
+                box.max[k] = std::max(box0.max[k], box1.max[k]);
+            }
+        }
+
         AlignedBox3<T> box;
     };
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.3.2026.08.08
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -85,6 +85,18 @@ namespace gte
             }
         }
 
+        // The bounding volume of an interior node during a refit is the
+        // union of the bounding volumes of its children.
+        virtual void MergeBoundingVolumes(
+            std::size_t,
+            std::size_t,
+            AlignedBoxBV<T> const& boundingVolume0,
+            AlignedBoxBV<T> const& boundingVolume1,
+            AlignedBoxBV<T>& boundingVolume) override
+        {
+            AlignedBoxBV<T>::Merge(boundingVolume0, boundingVolume1, boundingVolume);
+        }
+
     private:
         friend class UnitTestAlignedBoxTreeOfSegments;
     };
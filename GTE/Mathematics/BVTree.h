@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.3.2026.08.09
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -27,6 +27,14 @@
 // to partition the primitives into two subsets of equal size or absolute size
 // difference of 1. This leads to a balanced tree, which is helpful for
 // performance of tree traversals.
+//
+// For deforming geometry, the primitives move but the partition of the
+// primitives among the nodes can be preserved. The Refit functions recompute
+// the bounding volumes bottom-up without rebuilding the tree. Over time the
+// partition can become a poor fit for the geometry, which shows up as
+// children whose bounding volumes are large relative to that of their
+// parent. The function RebuildDegradedSubtrees detects such nodes and
+// rebuilds only the subtrees rooted at them.
 
 #include <Mathematics/BitHacks.h>
 #include <Mathematics/Vector3.h>
@@ -36,6 +44,7 @@
 #include <cstdint>
 #include <limits>
 #include <numeric>
+#include <thread>
 #include <vector>
 
 namespace gte
@@ -52,15 +61,25 @@ namespace gte
     //     static bool IntersectLine(Vector3<T> const& P, Vector3<T> const& Q, BoundingVolume<T> const& boundingVolume);
     //     static bool IntersectRay(Vector3<T> const& P, Vector3<T> const& Q, BoundingVolume<T> const& boundingVolume);
     //     static bool IntersectSegment(Vector3<T> const& P, Vector3<T> const& Q, BoundingVolume<T> const& boundingVolume);
+    //     static bool Overlap(BoundingVolume<T> const& bv0, BoundingVolume<T> const& bv1);
+    //     static bool Overlap(BoundingVolume<T> const& bv0, BoundingVolume<T> const& bv1, Matrix3x3<T> const& rotate, Vector3<T> const& translate);
+    //     T GetSurfaceArea() const;
     // };
     // The line is parameterized by P+t*Q for all real t. The ray is
     // parameterized by P+t*Q for nonnegative t. The segment is parameterized
-    // by (1-t)*P+t*Q for t in [0,1].
+    // by (1-t)*P+t*Q for t in [0,1]. The second Overlap function transforms
+    // bv1 by X' = rotate * X + translate before the test. The Overlap
+    // functions are required only by the tree-versus-tree queries.
     //
     // To support building the tree, derived classes of BVTree must implement
     // virtual functions
     //     void ComputeInteriorBoundingVolume(std::size_t i0, std::size_t i1, BoundingVolume& boundingVolume);
     //     void ComputeLeafBoundingVolume(std::size_t i, BoundingVolume& boundingVolume);
+    // Derived classes may override the virtual function
+    //     void MergeBoundingVolumes(std::size_t i0, std::size_t i1, BoundingVolume const& boundingVolume0, BoundingVolume const& boundingVolume1, BoundingVolume& boundingVolume);
+    // to compute the bounding volume of an interior node from those of its
+    // children. The default implementation calls
+    // ComputeInteriorBoundingVolume(i0, i1, boundingVolume).
 
     template <typename T, typename BoundingVolume>
     class BVTree
@@ -83,6 +102,7 @@ namespace gte
             mHeight(0),
             mNodes{},
             mPartition{},
+            mBuildQuality{},
             mLinearBoundingVolumeQuery{
                 BoundingVolume::IntersectLine,
                 BoundingVolume::IntersectRay,
@@ -178,6 +198,230 @@ namespace gte
             std::size_t const i0 = 0;
             std::size_t const i1 = mCentroids.size() - 1;
             BuildTree(depth, nodeIndex, i0, i1);
+
+            // Record the quality of the interior nodes for the freshly built
+            // tree. RebuildDegradedSubtrees compares against these.
+            mBuildQuality.resize(numNodes);
+            std::fill(mBuildQuality.begin(), mBuildQuality.end(), static_cast<T>(0));
+            RecordBuildQuality(nodeIndex);
+        }
+
+        // The derived classes must recompute the centroids of the moved
+        // primitives and pass them to this function. The number of centroids
+        // must be the number passed to Create(...). The tree topology and
+        // the partition of primitives are unchanged; only the bounding
+        // volumes are updated, leaves first and then interior nodes from
+        // their children. Set numThreads to 0 or 1 to refit in the main
+        // thread. Set numThreads to 2 or larger to refit independent
+        // subtrees in that many threads.
+        void Refit(
+            std::vector<Vector3<T>>&& centroids,
+            std::size_t numThreads)
+        {
+            LogAssert(
+                centroids.size() == mCentroids.size(),
+                "The number of centroids must not change during a refit.");
+
+            mCentroids = std::move(centroids);
+
+            if (numThreads <= 1)
+            {
+                RefitSubtree(0);
+                return;
+            }
+
+            // Choose the smallest depth that has at least numThreads nodes.
+            // The subtrees rooted at that depth are disjoint and are refit
+            // concurrently.
+            std::size_t splitDepth = 0;
+            while ((static_cast<std::size_t>(1) << splitDepth) < numThreads &&
+                splitDepth < mHeight)
+            {
+                ++splitDepth;
+            }
+
+            std::size_t const nmin = (static_cast<std::size_t>(1) << splitDepth) - 1;
+            std::size_t const nsup = 2 * nmin + 1;
+            std::size_t const numSubtrees = nsup - nmin;
+            numThreads = std::min(numThreads, numSubtrees);
+            std::vector<std::thread> process(numThreads);
+            for (std::size_t t = 0; t < numThreads; ++t)
+            {
+                process[t] = std::thread([this, t, nmin, nsup, numThreads]()
+                {
+                    for (std::size_t n = nmin + t; n < nsup; n += numThreads)
+                    {
+                        RefitSubtree(n);
+                    }
+                });
+            }
+            for (std::size_t t = 0; t < numThreads; ++t)
+            {
+                process[t].join();
+            }
+
+            // Refit the nodes above the split depth, deepest first.
+            for (std::size_t n = nmin; n > 0; --n)
+            {
+                RefitNode(n - 1);
+            }
+        }
+
+        // The quality of an interior node is the sum of the surface areas of
+        // the bounding volumes of its children divided by the surface area
+        // of its bounding volume. Smaller is better. Children that overlap
+        // heavily or that are nearly as large as the parent lead to larger
+        // values, and traversals then visit both children more often. The
+        // quality of a leaf node (or an unused node when the tree height was
+        // limited) is 0.
+        T GetQuality(std::size_t nodeIndex) const
+        {
+            T const zero = static_cast<T>(0);
+            auto const& node = mNodes[nodeIndex];
+            if (node.leftChild == Node::invalid || node.rightChild == Node::invalid)
+            {
+                return zero;
+            }
+
+            T area = node.boundingVolume.GetSurfaceArea();
+            if (area > zero)
+            {
+                T area0 = mNodes[node.leftChild].boundingVolume.GetSurfaceArea();
+                T area1 = mNodes[node.rightChild].boundingVolume.GetSurfaceArea();
+                return (area0 + area1) / area;
+            }
+            return zero;
+        }
+
+        // The degradation of a node is its current quality divided by its
+        // quality when the subtree rooted at the node was last built. A
+        // value of 1 means no change. When the build quality is 0, the
+        // degradation is 1 if the current quality is 0 and is the maximum
+        // finite T otherwise.
+        T GetDegradation(std::size_t nodeIndex) const
+        {
+            T const zero = static_cast<T>(0);
+            T const one = static_cast<T>(1);
+            T quality = GetQuality(nodeIndex);
+            T const& buildQuality = mBuildQuality[nodeIndex];
+            if (buildQuality > zero)
+            {
+                return quality / buildQuality;
+            }
+            return (quality > zero ? std::numeric_limits<T>::max() : one);
+        }
+
+        // Rebuild the subtrees rooted at the shallowest interior nodes whose
+        // degradation exceeds maxDegradation, typically called after Refit.
+        // The primitives of a subtree are re-partitioned using the current
+        // centroids. Because the number of primitives of the subtree is
+        // unchanged, the shape of the subtree is unchanged. The ancestors of
+        // the rebuilt subtrees are then refit. Set numThreads to 0 or 1 to
+        // rebuild in the main thread. Set numThreads to 2 or larger to
+        // rebuild the subtrees concurrently. The function returns the node
+        // indices of the roots of the rebuilt subtrees.
+        std::vector<std::size_t> RebuildDegradedSubtrees(
+            T const& maxDegradation,
+            std::size_t numThreads)
+        {
+            std::vector<std::size_t> subtrees{};
+            std::vector<std::size_t> subtreeDepths{};
+            std::vector<std::size_t> indexStack(2 * mHeight + 1);
+            std::vector<std::size_t> depthStack(2 * mHeight + 1);
+            std::size_t top = 0;
+            indexStack[0] = 0;
+            depthStack[0] = 0;
+            while (top != std::numeric_limits<std::size_t>::max())
+            {
+                std::size_t nodeIndex = indexStack[top];
+                std::size_t depth = depthStack[top];
+                --top;
+
+                auto const& node = mNodes[nodeIndex];
+                if (node.leftChild != Node::invalid &&
+                    node.rightChild != Node::invalid)
+                {
+                    if (GetDegradation(nodeIndex) > maxDegradation)
+                    {
+                        subtrees.push_back(nodeIndex);
+                        subtreeDepths.push_back(depth);
+                    }
+                    else
+                    {
+                        ++top;
+                        indexStack[top] = node.rightChild;
+                        depthStack[top] = depth + 1;
+                        ++top;
+                        indexStack[top] = node.leftChild;
+                        depthStack[top] = depth + 1;
+                    }
+                }
+            }
+
+            if (subtrees.size() == 0)
+            {
+                return subtrees;
+            }
+
+            auto rebuild = [this, &subtrees, &subtreeDepths](std::size_t i)
+            {
+                std::size_t nodeIndex = subtrees[i];
+                auto const& node = mNodes[nodeIndex];
+                BuildTree(subtreeDepths[i], nodeIndex, node.minIndex, node.maxIndex);
+                RecordBuildQuality(nodeIndex);
+            };
+
+            if (numThreads <= 1)
+            {
+                for (std::size_t i = 0; i < subtrees.size(); ++i)
+                {
+                    rebuild(i);
+                }
+            }
+            else
+            {
+                numThreads = std::min(numThreads, subtrees.size());
+                std::vector<std::thread> process(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t] = std::thread([&subtrees, &rebuild, t, numThreads]()
+                    {
+                        for (std::size_t i = t; i < subtrees.size(); i += numThreads)
+                        {
+                            rebuild(i);
+                        }
+                    });
+                }
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+
+            // Refit the ancestors of the rebuilt subtrees. The parent of
+            // node n > 0 is (n - 1) / 2. Refitting the nodes in decreasing
+            // index order guarantees children are refit before parents.
+            std::vector<bool> visited(mNodes.size(), false);
+            std::vector<std::size_t> ancestors{};
+            for (auto nodeIndex : subtrees)
+            {
+                while (nodeIndex > 0)
+                {
+                    nodeIndex = (nodeIndex - 1) / 2;
+                    if (visited[nodeIndex])
+                    {
+                        break;
+                    }
+                    visited[nodeIndex] = true;
+                    ancestors.push_back(nodeIndex);
+                }
+            }
+            std::sort(ancestors.begin(), ancestors.end());
+            for (auto iter = ancestors.rbegin(); iter != ancestors.rend(); ++iter)
+            {
+                RefitNode(*iter);
+            }
+            return subtrees;
         }
 
         // Member access.
@@ -217,6 +461,21 @@ namespace gte
             std::size_t i,
             BoundingVolume& boundingVolume) = 0;
 
+        // The bounding volume of an interior node during a refit. The
+        // children have already been refit. The default computes the bounding
+        // volume from the primitives [i0,i1]. A derived class should override
+        // this when the bounding volume can be computed from those of the
+        // children, which makes the refit linear in the number of nodes.
+        virtual void MergeBoundingVolumes(
+            std::size_t i0,
+            std::size_t i1,
+            BoundingVolume const&,
+            BoundingVolume const&,
+            BoundingVolume& boundingVolume)
+        {
+            ComputeInteriorBoundingVolume(i0, i1, boundingVolume);
+        }
+
         // Get the node indices for the leaf nodes whose bounding volumes are
         // intersected by the linear component.
         void GetLeafIndices(
@@ -270,9 +529,66 @@ namespace gte
         std::size_t mHeight;
         std::vector<Node> mNodes;
         std::vector<std::size_t> mPartition;
+        std::vector<T> mBuildQuality;
         std::array<LinearBoundingVolumeQuery, 3> mLinearBoundingVolumeQuery;
 
     private:
+        // Support for refitting. RefitNode requires the children of the node
+        // to have been refit.
+        void RefitNode(std::size_t nodeIndex)
+        {
+            auto& node = mNodes[nodeIndex];
+            if (node.minIndex == Node::invalid)
+            {
+                // The node is not used by the tree.
+                return;
+            }
+
+            if (node.leftChild != Node::invalid &&
+                node.rightChild != Node::invalid)
+            {
+                MergeBoundingVolumes(node.minIndex, node.maxIndex,
+                    mNodes[node.leftChild].boundingVolume,
+                    mNodes[node.rightChild].boundingVolume,
+                    node.boundingVolume);
+            }
+            else if (node.minIndex < node.maxIndex)
+            {
+                // The node is a leaf at the user-specified height that
+                // represents multiple primitives.
+                ComputeInteriorBoundingVolume(node.minIndex, node.maxIndex,
+                    node.boundingVolume);
+            }
+            else
+            {
+                ComputeLeafBoundingVolume(node.minIndex, node.boundingVolume);
+            }
+        }
+
+        void RefitSubtree(std::size_t nodeIndex)
+        {
+            auto const& node = mNodes[nodeIndex];
+            if (node.leftChild != Node::invalid &&
+                node.rightChild != Node::invalid)
+            {
+                RefitSubtree(node.leftChild);
+                RefitSubtree(node.rightChild);
+            }
+            RefitNode(nodeIndex);
+        }
+
+        void RecordBuildQuality(std::size_t nodeIndex)
+        {
+            auto const& node = mNodes[nodeIndex];
+            if (node.leftChild != Node::invalid &&
+                node.rightChild != Node::invalid)
+            {
+                mBuildQuality[nodeIndex] = GetQuality(nodeIndex);
+                RecordBuildQuality(node.leftChild);
+                RecordBuildQuality(node.rightChild);
+            }
+        }
+
         // Support for tree creation.
         void BuildTree(
             std::size_t depth,
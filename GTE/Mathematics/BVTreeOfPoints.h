@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.3.2026.08.08
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -52,6 +52,23 @@ namespace gte
             this->Tree::Create(std::move(centroids), height);
         }
 
+        // The vertices have moved. See BVTree::Refit for the meaning of
+        // numThreads.
+        void Refit(
+            std::vector<Vector3<T>> const& vertices,
+            std::size_t numThreads = 0)
+        {
+            LogAssert(
+                vertices.size() == mVertices.size(),
+                "The number of vertices must not change during a refit.");
+
+            mVertices = vertices;
+
+            // The vertices are already the centroids.
+            std::vector<Vector3<T>> centroids = vertices;
+            this->Tree::Refit(std::move(centroids), numThreads);
+        }
+
         // Member access.
         inline std::vector<Vector3<T>> const& GetVertices() const
         {
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.3.2026.08.08
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -48,17 +48,22 @@ namespace gte
             mVertices = vertices;
             mSegments = segments;
 
-            // Compute the segment centroids.
-            std::vector<Vector3<T>> centroids(mSegments.size());
-            T const half = static_cast<T>(0.5);
-            for (std::size_t i = 0; i < mSegments.size(); ++i)
-            {
-                auto const& seg = mSegments[i];
-                centroids[i] = half * (mVertices[seg[0]] + mVertices[seg[1]]);
-            }
-
             // Create the bounding volume tree for centroids.
-            BVTree<T, BoundingVolume>::Create(std::move(centroids), height);
+            BVTree<T, BoundingVolume>::Create(ComputeCentroids(), height);
+        }
+
+        // The vertices have moved but the segments are unchanged. See
+        // BVTree::Refit for the meaning of numThreads.
+        void Refit(
+            std::vector<Vector3<T>> const& vertices,
+            std::size_t numThreads = 0)
+        {
+            LogAssert(
+                vertices.size() == mVertices.size(),
+                "The number of vertices must not change during a refit.");
+
+            mVertices = vertices;
+            BVTree<T, BoundingVolume>::Refit(ComputeCentroids(), numThreads);
         }
 
         // Member access.
@@ -90,6 +95,18 @@ namespace gte
         std::vector<std::array<size_t, 2>> mSegments;
 
     private:
+        std::vector<Vector3<T>> ComputeCentroids() const
+        {
+            std::vector<Vector3<T>> centroids(mSegments.size());
+            T const half = static_cast<T>(0.5);
+            for (std::size_t i = 0; i < mSegments.size(); ++i)
+            {
+                auto const& seg = mSegments[i];
+                centroids[i] = half * (mVertices[seg[0]] + mVertices[seg[1]]);
+            }
+            return centroids;
+        }
+
         friend class UnitTestBVTreeOfSegments;
     };
 }
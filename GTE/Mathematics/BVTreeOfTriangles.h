@@ -3,7 +3,7 @@
 // Copyright (c) 2025 Geometric Tools LLC
 // Distributed under the Boost Software License, Version 1.0
 // https://www.boost.org/LICENSE_1_0.txt
-// File Version: 8.3.2026.08.08
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -15,11 +15,15 @@
 #include <Mathematics/IntrLine3Triangle3.h>
 #include <Mathematics/IntrRay3Triangle3.h>
 #include <Mathematics/IntrSegment3Triangle3.h>
+#include <Mathematics/IntrTriangle3Triangle3.h>
+#include <Mathematics/Matrix3x3.h>
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <set>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -58,17 +62,25 @@ namespace gte
             mVertices = vertices;
             mTriangles = triangles;
 
-            // Compute the triangle centroids.
-            std::vector<Vector3<T>> centroids(mTriangles.size());
-            T const three = static_cast<T>(3);
-            for (std::size_t t = 0; t < mTriangles.size(); ++t)
-            {
-                auto const& tri = mTriangles[t];
-                centroids[t] = (mVertices[tri[0]] + mVertices[tri[1]] + mVertices[tri[2]]) / three;
-            }
-
             // Create the bounding volume tree for centroids.
-            BVTree<T, BoundingVolume>::Create(std::move(centroids), height);
+            BVTree<T, BoundingVolume>::Create(ComputeCentroids(), height);
+        }
+
+        // The vertices have moved but the triangles are unchanged, which is
+        // the case for deforming meshes. The bounding volumes are recomputed
+        // without rebuilding the tree. See BVTree::Refit for the meaning of
+        // numThreads. After a refit, call RebuildDegradedSubtrees to repair
+        // the parts of the tree whose partition no longer fits the mesh.
+        void Refit(
+            std::vector<Vector3<T>> const& vertices,
+            std::size_t numThreads = 0)
+        {
+            LogAssert(
+                vertices.size() == mVertices.size(),
+                "The number of vertices must not change during a refit.");
+
+            mVertices = vertices;
+            BVTree<T, BoundingVolume>::Refit(ComputeCentroids(), numThreads);
         }
 
         // Member access.
@@ -145,7 +157,307 @@ namespace gte
             }
         }
 
+        // Compute the pairs of intersecting triangles, one from this mesh
+        // and one from the other mesh. The other mesh is transformed into
+        // the coordinate system of this mesh by the rigid motion
+        // X' = rotate * X + translate. The trees are traversed
+        // simultaneously and the candidate triangle pairs from overlapping
+        // leaf nodes are tested with TIQuery<T, Triangle3<T>, Triangle3<T>>.
+        // Each element of 'pairs' is {triangle index in this mesh, triangle
+        // index in the other mesh}, and 'pairs' is sorted. Set numThreads to
+        // 0 or 1 to execute in the main thread. Set numThreads to 2 or
+        // larger to split the traversal among that many threads, each
+        // writing to its own buffer.
+        void FindIntersectingTriangles(
+            BVTreeOfTriangles<T, BoundingVolume> const& other,
+            Matrix3x3<T> const& rotate,
+            Vector3<T> const& translate,
+            std::size_t numThreads,
+            std::vector<std::array<std::size_t, 2>>& pairs) const
+        {
+            FindTrianglePairs(other, rotate, translate, numThreads, true, pairs);
+        }
+
+        // The broad phase of FindIntersectingTriangles. The candidate pairs
+        // are the triangle pairs from leaf nodes whose bounding volumes
+        // overlap. The triangles are not tested for intersection, which
+        // allows the caller to run its own narrow phase. When the tree is
+        // built to full height, each leaf has a single triangle and the
+        // candidates are the pairs whose triangle bounding volumes overlap.
+        // The format of 'pairs' and the meaning of numThreads are the same
+        // as for FindIntersectingTriangles.
+        void FindOverlappingTriangles(
+            BVTreeOfTriangles<T, BoundingVolume> const& other,
+            Matrix3x3<T> const& rotate,
+            Vector3<T> const& translate,
+            std::size_t numThreads,
+            std::vector<std::array<std::size_t, 2>>& pairs) const
+        {
+            FindTrianglePairs(other, rotate, translate, numThreads, false, pairs);
+        }
+
+        // Compute the pairs of intersecting triangles of this mesh. Pairs of
+        // triangles that share a vertex are skipped because they always
+        // intersect. Each element of 'pairs' is {t0, t1} with t0 < t1, and
+        // 'pairs' is sorted. See FindIntersectingTriangles for the meaning
+        // of numThreads.
+        void FindSelfIntersectingTriangles(
+            std::size_t numThreads,
+            std::vector<std::array<std::size_t, 2>>& pairs) const
+        {
+            auto testTriangles = [this](std::size_t t0, std::size_t t1,
+                std::vector<std::array<std::size_t, 2>>& output)
+            {
+                auto const& tri0 = mTriangles[t0];
+                auto const& tri1 = mTriangles[t1];
+                for (std::size_t j0 = 0; j0 < 3; ++j0)
+                {
+                    for (std::size_t j1 = 0; j1 < 3; ++j1)
+                    {
+                        if (tri0[j0] == tri1[j1])
+                        {
+                            return;
+                        }
+                    }
+                }
+
+                TIQuery<T, Triangle3<T>, Triangle3<T>> query{};
+                Triangle3<T> triangle0(mVertices[tri0[0]], mVertices[tri0[1]], mVertices[tri0[2]]);
+                Triangle3<T> triangle1(mVertices[tri1[0]], mVertices[tri1[1]], mVertices[tri1[2]]);
+                if (query(triangle0, triangle1).intersect)
+                {
+                    output.push_back({ std::min(t0, t1), std::max(t0, t1) });
+                }
+            };
+
+            auto processPair = [this, &testTriangles](
+                std::array<std::size_t, 2> const& nodePair,
+                std::vector<std::array<std::size_t, 2>>& nodePairs,
+                std::vector<std::array<std::size_t, 2>>& output)
+            {
+                auto const& node0 = this->mNodes[nodePair[0]];
+                auto const& node1 = this->mNodes[nodePair[1]];
+                bool isLeaf0 = (node0.leftChild == Tree::Node::invalid);
+                bool isLeaf1 = (node1.leftChild == Tree::Node::invalid);
+
+                if (nodePair[0] == nodePair[1])
+                {
+                    // A node is tested against itself. Only pairs of
+                    // distinct triangles are considered.
+                    if (isLeaf0)
+                    {
+                        for (std::size_t i0 = node0.minIndex; i0 < node0.maxIndex; ++i0)
+                        {
+                            for (std::size_t i1 = i0 + 1; i1 <= node0.maxIndex; ++i1)
+                            {
+                                testTriangles(this->mPartition[i0], this->mPartition[i1], output);
+                            }
+                        }
+                    }
+                    else
+                    {
+                        nodePairs.push_back({ node0.leftChild, node0.leftChild });
+                        nodePairs.push_back({ node0.rightChild, node0.rightChild });
+                        nodePairs.push_back({ node0.leftChild, node0.rightChild });
+                    }
+                    return;
+                }
+
+                if (!BoundingVolume::Overlap(node0.boundingVolume, node1.boundingVolume))
+                {
+                    return;
+                }
+
+                if (isLeaf0 && isLeaf1)
+                {
+                    for (std::size_t i0 = node0.minIndex; i0 <= node0.maxIndex; ++i0)
+                    {
+                        for (std::size_t i1 = node1.minIndex; i1 <= node1.maxIndex; ++i1)
+                        {
+                            testTriangles(this->mPartition[i0], this->mPartition[i1], output);
+                        }
+                    }
+                }
+                else if (isLeaf0 || (!isLeaf1 &&
+                    node1.maxIndex - node1.minIndex > node0.maxIndex - node0.minIndex))
+                {
+                    nodePairs.push_back({ nodePair[0], node1.leftChild });
+                    nodePairs.push_back({ nodePair[0], node1.rightChild });
+                }
+                else
+                {
+                    nodePairs.push_back({ node0.leftChild, nodePair[1] });
+                    nodePairs.push_back({ node0.rightChild, nodePair[1] });
+                }
+            };
+
+            TraverseNodePairs(numThreads, processPair, pairs);
+        }
+
     protected:
+        using Tree = typename BVTree<T, BoundingVolume>::Tree;
+
+        // The tree-versus-tree traversal shared by FindIntersectingTriangles
+        // and FindOverlappingTriangles. The candidate pairs from overlapping
+        // leaf nodes are tested with the triangle-triangle query only when
+        // narrowPhase is true.
+        void FindTrianglePairs(
+            BVTreeOfTriangles<T, BoundingVolume> const& other,
+            Matrix3x3<T> const& rotate,
+            Vector3<T> const& translate,
+            std::size_t numThreads,
+            bool narrowPhase,
+            std::vector<std::array<std::size_t, 2>>& pairs) const
+        {
+            std::vector<Vector3<T>> otherVertices{};
+            if (narrowPhase)
+            {
+                otherVertices.resize(other.mVertices.size());
+                for (std::size_t i = 0; i < otherVertices.size(); ++i)
+                {
+                    otherVertices[i] = rotate * other.mVertices[i] + translate;
+                }
+            }
+
+            auto processPair = [this, &other, &otherVertices, &rotate, &translate, narrowPhase](
+                std::array<std::size_t, 2> const& nodePair,
+                std::vector<std::array<std::size_t, 2>>& nodePairs,
+                std::vector<std::array<std::size_t, 2>>& output)
+            {
+                auto const& node0 = this->mNodes[nodePair[0]];
+                auto const& node1 = other.mNodes[nodePair[1]];
+                if (!BoundingVolume::Overlap(node0.boundingVolume,
+                    node1.boundingVolume, rotate, translate))
+                {
+                    return;
+                }
+
+                bool isLeaf0 = (node0.leftChild == Tree::Node::invalid);
+                bool isLeaf1 = (node1.leftChild == Tree::Node::invalid);
+                if (isLeaf0 && isLeaf1 && !narrowPhase)
+                {
+                    for (std::size_t i0 = node0.minIndex; i0 <= node0.maxIndex; ++i0)
+                    {
+                        for (std::size_t i1 = node1.minIndex; i1 <= node1.maxIndex; ++i1)
+                        {
+                            output.push_back({ this->mPartition[i0], other.mPartition[i1] });
+                        }
+                    }
+                }
+                else if (isLeaf0 && isLeaf1)
+                {
+                    TIQuery<T, Triangle3<T>, Triangle3<T>> query{};
+                    for (std::size_t i0 = node0.minIndex; i0 <= node0.maxIndex; ++i0)
+                    {
+                        std::size_t t0 = this->mPartition[i0];
+                        auto const& tri0 = mTriangles[t0];
+                        Triangle3<T> triangle0(mVertices[tri0[0]],
+                            mVertices[tri0[1]], mVertices[tri0[2]]);
+                        for (std::size_t i1 = node1.minIndex; i1 <= node1.maxIndex; ++i1)
+                        {
+                            std::size_t t1 = other.mPartition[i1];
+                            auto const& tri1 = other.mTriangles[t1];
+                            Triangle3<T> triangle1(otherVertices[tri1[0]],
+                                otherVertices[tri1[1]], otherVertices[tri1[2]]);
+                            if (query(triangle0, triangle1).intersect)
+                            {
+                                output.push_back({ t0, t1 });
+                            }
+                        }
+                    }
+                }
+                else if (isLeaf0 || (!isLeaf1 &&
+                    node1.maxIndex - node1.minIndex > node0.maxIndex - node0.minIndex))
+                {
+                    // Descend the tree whose node has more primitives.
+                    nodePairs.push_back({ nodePair[0], node1.leftChild });
+                    nodePairs.push_back({ nodePair[0], node1.rightChild });
+                }
+                else
+                {
+                    nodePairs.push_back({ node0.leftChild, nodePair[1] });
+                    nodePairs.push_back({ node0.rightChild, nodePair[1] });
+                }
+            };
+
+            TraverseNodePairs(numThreads, processPair, pairs);
+        }
+
+        // Traverse pairs of nodes starting with the root pair {0,0}. The
+        // function processPair(nodePair, nodePairs, output) appends to
+        // nodePairs the child pairs that must be visited and appends to
+        // output the primitive pairs that are reported. For multithreading,
+        // the pairs are expanded breadth first in the main thread until
+        // there are enough of them to distribute among the threads. Each
+        // thread then traverses its pairs depth first and writes to its own
+        // buffer. The buffers are concatenated and sorted so that the
+        // output does not depend on the number of threads.
+        template <typename ProcessPair>
+        static void TraverseNodePairs(
+            std::size_t numThreads,
+            ProcessPair const& processPair,
+            std::vector<std::array<std::size_t, 2>>& pairs)
+        {
+            pairs.clear();
+
+            std::vector<std::array<std::size_t, 2>> frontier{ { 0, 0 } };
+            if (numThreads > 1)
+            {
+                std::size_t const minFrontierSize = 4 * numThreads;
+                std::vector<std::array<std::size_t, 2>> next{};
+                while (frontier.size() > 0 && frontier.size() < minFrontierSize)
+                {
+                    next.clear();
+                    for (auto const& nodePair : frontier)
+                    {
+                        processPair(nodePair, next, pairs);
+                    }
+                    std::swap(frontier, next);
+                }
+                numThreads = std::min(numThreads, frontier.size());
+            }
+
+            auto traverse = [&frontier, &processPair](std::size_t imin,
+                std::size_t stride, std::vector<std::array<std::size_t, 2>>& output)
+            {
+                std::vector<std::array<std::size_t, 2>> nodePairs{};
+                for (std::size_t i = imin; i < frontier.size(); i += stride)
+                {
+                    nodePairs.push_back(frontier[i]);
+                    while (nodePairs.size() > 0)
+                    {
+                        std::array<std::size_t, 2> nodePair = nodePairs.back();
+                        nodePairs.pop_back();
+                        processPair(nodePair, nodePairs, output);
+                    }
+                }
+            };
+
+            if (numThreads <= 1)
+            {
+                traverse(0, 1, pairs);
+            }
+            else
+            {
+                std::vector<std::vector<std::array<std::size_t, 2>>> buffers(numThreads);
+                std::vector<std::thread> process(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t] = std::thread([&traverse, &buffers, t, numThreads]()
+                    {
+                        traverse(t, numThreads, buffers[t]);
+                    });
+                }
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                    pairs.insert(pairs.end(), buffers[t].begin(), buffers[t].end());
+                }
+            }
+
+            std::sort(pairs.begin(), pairs.end());
+        }
+
         using LinearTriangleQuery = bool (*)(Vector3<T> const&, Vector3<T> const&,
             Triangle3<T> const&, Vector3<T>&, T&);
 
@@ -184,6 +496,18 @@ namespace gte
         std::array<LinearTriangleQuery, 3> mLinearTriangleQuery;
 
     private:
+        std::vector<Vector3<T>> ComputeCentroids() const
+        {
+            std::vector<Vector3<T>> centroids(mTriangles.size());
+            T const three = static_cast<T>(3);
+            for (std::size_t t = 0; t < mTriangles.size(); ++t)
+            {
+                auto const& tri = mTriangles[t];
+                centroids[t] = (mVertices[tri[0]] + mVertices[tri[1]] + mVertices[tri[2]]) / three;
+            }
+            return centroids;
+        }
+
         friend class UnitTestBVTreeOfTriangles;
     };
 }
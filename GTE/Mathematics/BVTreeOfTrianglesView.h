@@ -0,0 +1,536 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2026
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 8.3.2026.10.18
+
+#pragma once
+
+// BVTreeOfTrianglesView provides a flat binary layout for a tree built by a
+// class derived from BVTreeOfTriangles, for example,
+// AlignedBoxTreeOfTriangles or OrientedBoxTreeOfTriangles. The layout is
+// produced by Serialize(...) or Save(...) and can be consumed directly from
+// memory, for example a memory-mapped file, without deserialization. All
+// references between arrays are byte offsets from the start of the buffer,
+// so the buffer can be placed at any address that satisfies the alignment
+// of its arrays. A page-aligned memory map or a buffer from operator new
+// satisfies it.
+//
+// The layout is
+//   Header        (see the Header struct)
+//   nodes         numNodes elements of Node
+//   volumes       numNodes elements of BoundingVolume
+//   partition     numPrimitives elements of std::uint32_t
+//   vertices      numVertices elements of Vector3<T>
+//   triangles     numPrimitives elements of std::array<std::uint32_t, 3>
+// where each array starts at a multiple of 64 bytes. The header stores the
+// sizes of T and BoundingVolume, and a byte-order mark, so that a buffer
+// produced on one platform is rejected rather than misread when viewed
+// with different types or on a platform with different endianness.
+//
+// A typical POSIX usage is
+//   int fd = open(filename, O_RDONLY);
+//   struct stat sb; fstat(fd, &sb);
+//   void const* buffer = mmap(nullptr, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+//   BVTreeOfTrianglesView<float, AlignedBoxBV<float>> view{};
+//   bool valid = view.Set(buffer, sb.st_size);
+// The buffer must remain valid while the view is in use.
+
+#include <Mathematics/BVTreeOfTriangles.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace gte
+{
+    template <typename T, typename BoundingVolume>
+    class BVTreeOfTrianglesView
+    {
+    public:
+        static_assert(
+            std::is_trivially_copyable<BoundingVolume>::value &&
+            std::is_trivially_copyable<Vector3<T>>::value,
+            "The bounding volume and vertex types must be trivially copyable.");
+
+        static std::uint32_t constexpr version = 1;
+        static std::uint32_t constexpr byteOrderMark = 0x01020304u;
+        static std::uint32_t constexpr invalid = std::numeric_limits<std::uint32_t>::max();
+        static std::size_t constexpr arrayAlignment = 64;
+
+        struct Header
+        {
+            std::array<char, 8> magic;  // "GTBVTRI\0"
+            std::uint32_t version;
+            std::uint32_t byteOrderMark;
+            std::uint32_t realSize;
+            std::uint32_t boundingVolumeSize;
+            std::uint32_t height;
+            std::uint32_t numNodes;
+            std::uint32_t numPrimitives;
+            std::uint32_t numVertices;
+            std::uint64_t nodesOffset;
+            std::uint64_t volumesOffset;
+            std::uint64_t partitionOffset;
+            std::uint64_t verticesOffset;
+            std::uint64_t trianglesOffset;
+            std::uint64_t totalSize;
+        };
+
+        // The node indices and primitive indices have the same meaning as
+        // those of BVTree<T, BoundingVolume>::Node, but they are stored as
+        // 32-bit unsigned integers. The value 'invalid' replaces
+        // BVTree<T, BoundingVolume>::Node::invalid.
+        struct Node
+        {
+            std::uint32_t minIndex, maxIndex;
+            std::uint32_t leftChild, rightChild;
+        };
+
+        using Tree = BVTreeOfTriangles<T, BoundingVolume>;
+        using Intersection = typename Tree::Intersection;
+
+        BVTreeOfTrianglesView()
+            :
+            mHeader(nullptr),
+            mNodes(nullptr),
+            mVolumes(nullptr),
+            mPartition(nullptr),
+            mVertices(nullptr),
+            mTriangles(nullptr)
+        {
+        }
+
+        // Create the flat layout of a built tree. The number of nodes,
+        // vertices and triangles must each be smaller than 2^32-1.
+        static std::vector<std::uint8_t> Serialize(Tree const& tree)
+        {
+            auto const& treeNodes = tree.GetNodes();
+            auto const& treePartition = tree.GetPartition();
+            auto const& treeVertices = tree.GetVertices();
+            auto const& treeTriangles = tree.GetTriangles();
+            std::size_t const maxCount = static_cast<std::size_t>(invalid);
+            LogAssert(
+                treeNodes.size() > 0 &&
+                treeNodes.size() < maxCount &&
+                treeVertices.size() < maxCount &&
+                treeTriangles.size() < maxCount,
+                "The tree must be created and its sizes must fit in 32 bits.");
+
+            Header header{};
+            std::memcpy(header.magic.data(), "GTBVTRI", 8);
+            header.version = version;
+            header.byteOrderMark = byteOrderMark;
+            header.realSize = static_cast<std::uint32_t>(sizeof(T));
+            header.boundingVolumeSize = static_cast<std::uint32_t>(sizeof(BoundingVolume));
+            header.height = static_cast<std::uint32_t>(tree.GetHeight());
+            header.numNodes = static_cast<std::uint32_t>(treeNodes.size());
+            header.numPrimitives = static_cast<std::uint32_t>(treeTriangles.size());
+            header.numVertices = static_cast<std::uint32_t>(treeVertices.size());
+
+            std::uint64_t offset = RoundUp(sizeof(Header));
+            header.nodesOffset = offset;
+            offset = RoundUp(offset + header.numNodes * sizeof(Node));
+            header.volumesOffset = offset;
+            offset = RoundUp(offset + header.numNodes * sizeof(BoundingVolume));
+            header.partitionOffset = offset;
+            offset = RoundUp(offset + header.numPrimitives * sizeof(std::uint32_t));
+            header.verticesOffset = offset;
+            offset = RoundUp(offset + header.numVertices * sizeof(Vector3<T>));
+            header.trianglesOffset = offset;
+            offset = offset + header.numPrimitives * sizeof(std::array<std::uint32_t, 3>);
+            header.totalSize = offset;
+
+            std::vector<std::uint8_t> buffer(static_cast<std::size_t>(header.totalSize), 0);
+            std::uint8_t* data = buffer.data();
+            std::memcpy(data, &header, sizeof(Header));
+
+            Node* nodes = reinterpret_cast<Node*>(data + header.nodesOffset);
+            BoundingVolume* volumes = reinterpret_cast<BoundingVolume*>(data + header.volumesOffset);
+            for (std::size_t i = 0; i < treeNodes.size(); ++i)
+            {
+                auto const& treeNode = treeNodes[i];
+                nodes[i].minIndex = ToUInt32(treeNode.minIndex);
+                nodes[i].maxIndex = ToUInt32(treeNode.maxIndex);
+                nodes[i].leftChild = ToUInt32(treeNode.leftChild);
+                nodes[i].rightChild = ToUInt32(treeNode.rightChild);
+                std::memcpy(&volumes[i], &treeNode.boundingVolume, sizeof(BoundingVolume));
+            }
+
+            std::uint32_t* partition = reinterpret_cast<std::uint32_t*>(data + header.partitionOffset);
+            for (std::size_t i = 0; i < treePartition.size(); ++i)
+            {
+                partition[i] = static_cast<std::uint32_t>(treePartition[i]);
+            }
+
+            std::memcpy(data + header.verticesOffset, treeVertices.data(),
+                treeVertices.size() * sizeof(Vector3<T>));
+
+            std::array<std::uint32_t, 3>* triangles =
+                reinterpret_cast<std::array<std::uint32_t, 3>*>(data + header.trianglesOffset);
+            for (std::size_t t = 0; t < treeTriangles.size(); ++t)
+            {
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    triangles[t][j] = static_cast<std::uint32_t>(treeTriangles[t][j]);
+                }
+            }
+
+            return buffer;
+        }
+
+        static bool Save(Tree const& tree, std::string const& filename)
+        {
+            std::ofstream output(filename, std::ios::binary);
+            if (!output)
+            {
+                return false;
+            }
+
+            std::vector<std::uint8_t> buffer = Serialize(tree);
+            if (output.write((char const*)buffer.data(), buffer.size()).fail())
+            {
+                return false;
+            }
+
+            output.close();
+            return true;
+        }
+
+        // Attach the view to a buffer that contains the flat layout. The
+        // function returns false and the view is empty when the buffer is
+        // too small, has an unexpected header or is not suitably aligned.
+        // It also returns false when the buffer is not a tree that Execute
+        // can traverse safely: a node reachable from the root has a child
+        // or primitive index out of range, is reachable along two paths,
+        // or has depth larger than the height; or a partition value or
+        // triangle vertex index is out of range. The validation is linear
+        // in the buffer size, so a buffer from an untrusted source may be
+        // passed to Set.
+        bool Set(void const* buffer, std::size_t numBytes)
+        {
+            *this = BVTreeOfTrianglesView{};
+
+            if (buffer == nullptr || numBytes < sizeof(Header) ||
+                !IsAligned(buffer, alignof(Header)))
+            {
+                return false;
+            }
+
+            std::uint8_t const* data = static_cast<std::uint8_t const*>(buffer);
+            Header const* header = reinterpret_cast<Header const*>(data);
+            if (std::memcmp(header->magic.data(), "GTBVTRI", 8) != 0 ||
+                header->version != version ||
+                header->byteOrderMark != byteOrderMark ||
+                header->realSize != sizeof(T) ||
+                header->boundingVolumeSize != sizeof(BoundingVolume) ||
+                header->numNodes == 0 ||
+                header->totalSize > numBytes)
+            {
+                return false;
+            }
+
+            // Verify that the arrays lie inside the buffer and are aligned.
+            if (!IsValidArray(data, header->nodesOffset, header->numNodes, sizeof(Node), alignof(Node), header->totalSize) ||
+                !IsValidArray(data, header->volumesOffset, header->numNodes, sizeof(BoundingVolume), alignof(BoundingVolume), header->totalSize) ||
+                !IsValidArray(data, header->partitionOffset, header->numPrimitives, sizeof(std::uint32_t), alignof(std::uint32_t), header->totalSize) ||
+                !IsValidArray(data, header->verticesOffset, header->numVertices, sizeof(Vector3<T>), alignof(Vector3<T>), header->totalSize) ||
+                !IsValidArray(data, header->trianglesOffset, header->numPrimitives, sizeof(std::array<std::uint32_t, 3>), alignof(std::array<std::uint32_t, 3>), header->totalSize))
+            {
+                return false;
+            }
+
+            Node const* nodes = reinterpret_cast<Node const*>(data + header->nodesOffset);
+            std::uint32_t const* partition = reinterpret_cast<std::uint32_t const*>(data + header->partitionOffset);
+            std::array<std::uint32_t, 3> const* triangles =
+                reinterpret_cast<std::array<std::uint32_t, 3> const*>(data + header->trianglesOffset);
+            if (!IsValidTree(*header, nodes) ||
+                !IsValidIndices(*header, partition, triangles))
+            {
+                return false;
+            }
+
+            mHeader = header;
+            mNodes = nodes;
+            mVolumes = reinterpret_cast<BoundingVolume const*>(data + header->volumesOffset);
+            mPartition = partition;
+            mVertices = reinterpret_cast<Vector3<T> const*>(data + header->verticesOffset);
+            mTriangles = triangles;
+            return true;
+        }
+
+        // Member access. The pointers are null when the view is empty.
+        inline bool IsValid() const
+        {
+            return mHeader != nullptr;
+        }
+
+        inline std::size_t GetHeight() const
+        {
+            return (mHeader ? static_cast<std::size_t>(mHeader->height) : 0);
+        }
+
+        inline std::size_t GetNumNodes() const
+        {
+            return (mHeader ? static_cast<std::size_t>(mHeader->numNodes) : 0);
+        }
+
+        inline std::size_t GetNumTriangles() const
+        {
+            return (mHeader ? static_cast<std::size_t>(mHeader->numPrimitives) : 0);
+        }
+
+        inline std::size_t GetNumVertices() const
+        {
+            return (mHeader ? static_cast<std::size_t>(mHeader->numVertices) : 0);
+        }
+
+        inline Node const* GetNodes() const
+        {
+            return mNodes;
+        }
+
+        inline BoundingVolume const* GetBoundingVolumes() const
+        {
+            return mVolumes;
+        }
+
+        inline std::uint32_t const* GetPartition() const
+        {
+            return mPartition;
+        }
+
+        inline Vector3<T> const* GetVertices() const
+        {
+            return mVertices;
+        }
+
+        inline std::array<std::uint32_t, 3> const* GetTriangles() const
+        {
+            return mTriangles;
+        }
+
+        // The same query as BVTreeOfTriangles::Execute, evaluated directly
+        // on the flat arrays. The queryType is one of Tree::LINE_QUERY,
+        // Tree::RAY_QUERY or Tree::SEGMENT_QUERY.
+        void Execute(
+            std::uint32_t queryType,
+            Vector3<T> const& P,
+            Vector3<T> const& Q,
+            std::vector<std::size_t>& nodeIndices,
+            std::set<Intersection>& intersections) const
+        {
+            nodeIndices.clear();
+            intersections.clear();
+            if (!IsValid())
+            {
+                return;
+            }
+
+            std::vector<std::uint32_t> indexStack(2 * static_cast<std::size_t>(mHeader->height) + 1);
+            std::size_t top = 0;
+            indexStack[0] = 0;
+            while (top != std::numeric_limits<std::size_t>::max())
+            {
+                std::uint32_t nodeIndex = indexStack[top--];
+                Node const& node = mNodes[nodeIndex];
+                if (node.leftChild != invalid && node.rightChild != invalid)
+                {
+                    if (IntersectBoundingVolume(queryType, P, Q, mVolumes[nodeIndex]))
+                    {
+                        indexStack[++top] = node.rightChild;
+                        indexStack[++top] = node.leftChild;
+                    }
+                }
+                else
+                {
+                    nodeIndices.push_back(static_cast<std::size_t>(nodeIndex));
+                }
+            }
+
+            Vector3<T> point{};
+            T parameter{};
+            for (auto const& leafIndex : nodeIndices)
+            {
+                Node const& node = mNodes[leafIndex];
+                for (std::uint32_t i = node.minIndex; i <= node.maxIndex; ++i)
+                {
+                    std::uint32_t triangleIndex = mPartition[i];
+                    auto const& tri = mTriangles[triangleIndex];
+                    Triangle3<T> triangle(mVertices[tri[0]], mVertices[tri[1]], mVertices[tri[2]]);
+                    if (IntersectTriangle(queryType, P, Q, triangle, point, parameter))
+                    {
+                        intersections.insert(Intersection(
+                            static_cast<std::size_t>(triangleIndex), point, parameter));
+                    }
+                }
+            }
+        }
+
+    private:
+        static std::uint64_t RoundUp(std::uint64_t offset)
+        {
+            std::uint64_t const alignment = static_cast<std::uint64_t>(arrayAlignment);
+            return ((offset + alignment - 1) / alignment) * alignment;
+        }
+
+        static std::uint32_t ToUInt32(std::size_t index)
+        {
+            return (index == std::numeric_limits<std::size_t>::max() ?
+                invalid : static_cast<std::uint32_t>(index));
+        }
+
+        static bool IsAligned(void const* address, std::size_t alignment)
+        {
+            return reinterpret_cast<std::uintptr_t>(address) % alignment == 0;
+        }
+
+        static bool IsValidArray(std::uint8_t const* data, std::uint64_t offset,
+            std::uint64_t numElements, std::size_t elementSize,
+            std::size_t alignment, std::uint64_t totalSize)
+        {
+            return offset <= totalSize &&
+                numElements <= (totalSize - offset) / elementSize &&
+                IsAligned(data + offset, alignment);
+        }
+
+        // Traverse the nodes reachable from the root in the order Execute
+        // does. A node at depth d adds at most 1+d elements to the stack,
+        // so depth <= height keeps Execute within its stack of 2*height+1
+        // elements. Marking the visited nodes rejects cycles and shared
+        // children, which bounds the traversal by numNodes.
+        static bool IsValidTree(Header const& header, Node const* nodes)
+        {
+            if (header.height >= header.numNodes)
+            {
+                return false;
+            }
+
+            std::vector<bool> visited(header.numNodes, false);
+            std::vector<std::uint32_t> indexStack(2 * static_cast<std::size_t>(header.height) + 1);
+            std::vector<std::uint32_t> depthStack(indexStack.size());
+            std::size_t top = 0;
+            indexStack[0] = 0;
+            depthStack[0] = 0;
+            while (top != std::numeric_limits<std::size_t>::max())
+            {
+                std::uint32_t nodeIndex = indexStack[top];
+                std::uint32_t depth = depthStack[top];
+                --top;
+                if (visited[nodeIndex])
+                {
+                    return false;
+                }
+                visited[nodeIndex] = true;
+
+                Node const& node = nodes[nodeIndex];
+                if (node.leftChild != invalid && node.rightChild != invalid)
+                {
+                    if (depth == header.height ||
+                        node.leftChild >= header.numNodes ||
+                        node.rightChild >= header.numNodes)
+                    {
+                        return false;
+                    }
+
+                    ++top;
+                    indexStack[top] = node.rightChild;
+                    depthStack[top] = depth + 1;
+                    ++top;
+                    indexStack[top] = node.leftChild;
+                    depthStack[top] = depth + 1;
+                }
+                else if (node.minIndex > node.maxIndex ||
+                    node.maxIndex >= header.numPrimitives)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static bool IsValidIndices(Header const& header,
+            std::uint32_t const* partition,
+            std::array<std::uint32_t, 3> const* triangles)
+        {
+            for (std::uint32_t i = 0; i < header.numPrimitives; ++i)
+            {
+                if (partition[i] >= header.numPrimitives)
+                {
+                    return false;
+                }
+
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    if (triangles[i][j] >= header.numVertices)
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        static bool IntersectBoundingVolume(std::uint32_t queryType,
+            Vector3<T> const& P, Vector3<T> const& Q,
+            BoundingVolume const& boundingVolume)
+        {
+            switch (queryType)
+            {
+            case Tree::LINE_QUERY:
+                return BoundingVolume::IntersectLine(P, Q, boundingVolume);
+            case Tree::RAY_QUERY:
+                return BoundingVolume::IntersectRay(P, Q, boundingVolume);
+            default:
+                return BoundingVolume::IntersectSegment(P, Q, boundingVolume);
+            }
+        }
+
+        static bool IntersectTriangle(std::uint32_t queryType,
+            Vector3<T> const& P, Vector3<T> const& Q,
+            Triangle3<T> const& triangle, Vector3<T>& point, T& parameter)
+        {
+            switch (queryType)
+            {
+            case Tree::LINE_QUERY:
+            {
+                FIQuery<T, Line3<T>, Triangle3<T>> query{};
+                auto output = query(Line3<T>(P, Q), triangle);
+                point = output.point;
+                parameter = output.parameter;
+                return output.intersect;
+            }
+            case Tree::RAY_QUERY:
+            {
+                FIQuery<T, Ray3<T>, Triangle3<T>> query{};
+                auto output = query(Ray3<T>(P, Q), triangle);
+                point = output.point;
+                parameter = output.parameter;
+                return output.intersect;
+            }
+            default:
+            {
+                FIQuery<T, Segment3<T>, Triangle3<T>> query{};
+                auto output = query(Segment3<T>(P, Q), triangle);
+                point = output.point;
+                parameter = output.parameter;
+                return output.intersect;
+            }
+            }
+        }
+
+        Header const* mHeader;
+        Node const* mNodes;
+        BoundingVolume const* mVolumes;
+        std::uint32_t const* mPartition;
+        Vector3<T> const* mVertices;
+        std::array<std::uint32_t, 3> const* mTriangles;
+    };
+}
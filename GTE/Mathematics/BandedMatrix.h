@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2025.05.10
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -11,6 +11,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <cmath>
+#include <cstdint>
+#include <thread>
 #include <vector>
 
 namespace gte
@@ -191,56 +193,73 @@ namespace gte
                 return false;
             }
 
-            int32_t const sizeM1 = mSize - 1;
-            int32_t const numBands = static_cast<int32_t>(mLBands.size());
-
-            int32_t k, kMax;
-            for (int32_t i = 0; i < mSize; ++i)
+            // The factorization is computed in a packed copy of the lower
+            // band, where row i stores L(i,i-numBands) through L(i,i) in
+            // contiguous memory. The entries with negative column index are
+            // zero. The entry L(i,j) is the inner product of rows i and j
+            // subtracted from A(i,j), followed by a scaling, so the loops
+            // do not need the band tests of operator()(int32_t,int32_t).
+            // The subtractions are performed in the same order as in the
+            // column-oriented algorithm, so the results do not change.
+            std::size_t const size = static_cast<std::size_t>(mSize);
+            std::size_t const numBands = mLBands.size();
+            std::size_t const width = numBands + 1;
+            std::vector<Real> packed(size * width, (Real)0);
+            for (std::size_t i = 0; i < size; ++i)
             {
-                int32_t jMin = i - numBands;
-                if (jMin < 0)
+                Real* row = &packed[i * width];
+                std::size_t const bMax = std::min(i, numBands);
+                for (std::size_t b = 0; b < bMax; ++b)
                 {
-                    jMin = 0;
+                    row[numBands - 1 - b] = mLBands[b][i - 1 - b];
                 }
+                row[numBands] = mDBand[i];
+            }
 
-                int32_t j;
-                for (j = jMin; j < i; ++j)
+            std::vector<Real> invSqrt(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                // L(i,m) is rowI[m + numBands - i] for i - numBands <= m <= i.
+                Real* rowI = &packed[i * width] + numBands - i;
+                std::size_t const jMin = (i > numBands ? i - numBands : 0);
+                for (std::size_t j = jMin; j < i; ++j)
                 {
-                    kMax = j + numBands;
-                    if (kMax > sizeM1)
-                    {
-                        kMax = sizeM1;
-                    }
-
-                    for (k = i; k <= kMax; ++k)
+                    Real const* rowJ = &packed[j * width] + numBands - j;
+                    Real value = rowI[j];
+                    for (std::size_t m = jMin; m < j; ++m)
                     {
-                        operator()(k, i) -= operator()(i, j) * operator()(k, j);
+                        value -= rowI[m] * rowJ[m];
                     }
+                    rowI[j] = value * invSqrt[j];
                 }
 
-                kMax = j + numBands;
-                if (kMax > sizeM1)
-                {
-                    kMax = sizeM1;
-                }
-
-                for (k = 0; k < i; ++k)
+                Real diagonal = rowI[i];
+                for (std::size_t m = jMin; m < i; ++m)
                 {
-                    operator()(k, i) = operator()(i, k);
+                    diagonal -= rowI[m] * rowI[m];
                 }
-
-                Real diagonal = operator()(i, i);
                 if (diagonal <= (Real)0)
                 {
                     return false;
                 }
-                Real invSqrt = ((Real)1) / std::sqrt(diagonal);
-                for (k = i; k <= kMax; ++k)
+                invSqrt[i] = ((Real)1) / std::sqrt(diagonal);
+                rowI[i] = diagonal * invSqrt[i];
+            }
+
+            // Copy L to the lower band and L^T to the upper band. The
+            // entry L(r+1+b,r) is stored in both mLBands[b][r] and
+            // mUBands[b][r].
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                Real const* row = &packed[i * width];
+                std::size_t const bMax = std::min(i, numBands);
+                for (std::size_t b = 0; b < bMax; ++b)
                 {
-                    operator()(k, i) *= invSqrt;
+                    mLBands[b][i - 1 - b] = row[numBands - 1 - b];
                 }
+                mDBand[i] = row[numBands];
             }
-
+            mUBands = mLBands;
             return true;
         }
 
@@ -269,13 +288,18 @@ namespace gte
         // of A.
         //
         // 'bMatrix' must have the storage order specified by the template
-        // parameter.
+        // parameter. For row-major storage, the columns of B are solved in
+        // blocks of adjacent columns so that the rows of a block that are
+        // within the band remain in cache. For column-major storage, each
+        // column is solved as a vector. Set numThreads to 0 or 1 to execute
+        // in the main thread. Set numThreads to 2 or larger to distribute
+        // the blocks (or the columns) among that many threads. The results
+        // do not depend on the number of threads.
         template <bool RowMajor>
-        bool SolveSystem(Real* bMatrix, int32_t numBColumns)
+        bool SolveSystem(Real* bMatrix, int32_t numBColumns, std::size_t numThreads = 0)
         {
             return CholeskyFactor()
-                && SolveLower<RowMajor>(bMatrix, numBColumns)
-                && SolveUpper<RowMajor>(bMatrix, numBColumns);
+                && Solve<RowMajor>(bMatrix, numBColumns, numThreads);
         }
 
         // Compute the inverse of the banded matrix.  The return value is
@@ -392,23 +416,22 @@ namespace gte
         // operation is successful.
         bool SolveLower(Real* dataVector) const
         {
-            int32_t const size = static_cast<int32_t>(mDBand.size());
-            for (int32_t r = 0; r < size; ++r)
+            if (!IsDiagonalPositive())
             {
-                Real lowerRR = operator()(r, r);
-                if (lowerRR > (Real)0)
-                {
-                    for (int32_t c = 0; c < r; ++c)
-                    {
-                        Real lowerRC = operator()(r, c);
-                        dataVector[r] -= lowerRC * dataVector[c];
-                    }
-                    dataVector[r] /= lowerRR;
-                }
-                else
+                return false;
+            }
+
+            // L(r,r-1-b) is mLBands[b][r-1-b]. The products are subtracted
+            // in increasing column order.
+            int32_t const numBands = static_cast<int32_t>(mLBands.size());
+            for (int32_t r = 0; r < mSize; ++r)
+            {
+                Real value = dataVector[r];
+                for (int32_t b = std::min(r, numBands) - 1; b >= 0; --b)
                 {
-                    return false;
+                    value -= mLBands[b][r - 1 - b] * dataVector[r - 1 - b];
                 }
+                dataVector[r] = value / mDBand[r];
             }
             return true;
         }
@@ -418,95 +441,151 @@ namespace gte
         // is successful.
         bool SolveUpper(Real* dataVector) const
         {
-            int32_t const size = static_cast<int32_t>(mDBand.size());
-            for (int32_t r = size - 1; r >= 0; --r)
+            if (!IsDiagonalPositive())
             {
-                Real upperRR = operator()(r, r);
-                if (upperRR > (Real)0)
-                {
-                    for (int32_t c = r + 1; c < size; ++c)
-                    {
-                        Real upperRC = operator()(r, c);
-                        dataVector[r] -= upperRC * dataVector[c];
-                    }
+                return false;
+            }
 
-                    dataVector[r] /= upperRR;
-                }
-                else
+            // U(r,r+1+b) is mUBands[b][r]. The products are subtracted in
+            // increasing column order.
+            int32_t const numBands = static_cast<int32_t>(mUBands.size());
+            for (int32_t r = mSize - 1; r >= 0; --r)
+            {
+                Real value = dataVector[r];
+                int32_t const bMax = std::min(mSize - 1 - r, numBands);
+                for (int32_t b = 0; b < bMax; ++b)
                 {
-                    return false;
+                    value -= mUBands[b][r] * dataVector[r + 1 + b];
                 }
+                dataVector[r] = value / mDBand[r];
             }
             return true;
         }
 
-        // The linear system is L*U*X = B, where A = L*U and U = L^T,  Reduce
-        // this to U*X = L^{-1}*B.  The return value is 'true' iff the
-        // operation is successful.  See the comments for
-        // SolveSystem(Real*,int32_t) about the storage for dataMatrix.
+        // The number of columns in a block of a row-major right-hand side.
+        static std::size_t constexpr blockColumns = 128;
+
+        // Solve L*U*X = B, where A = L*U and U = L^T. See the comments for
+        // SolveSystem(Real*,int32_t,std::size_t) about the storage for
+        // dataMatrix. The return value is 'true' iff the operation is
+        // successful.
         template <bool RowMajor>
-        bool SolveLower(Real* dataMatrix, int32_t numColumns) const
+        bool Solve(Real* dataMatrix, int32_t numColumns, std::size_t numThreads) const
         {
-            LexicoArray2<RowMajor, Real> data(mSize, numColumns, dataMatrix);
+            if (!IsDiagonalPositive() || numColumns < 0)
+            {
+                return false;
+            }
 
-            for (int32_t r = 0; r < mSize; ++r)
+            // Block i of a row-major matrix is the columns [i*blockColumns,
+            // (i+1)*blockColumns) clamped to numColumns. Block i of a
+            // column-major matrix is column i.
+            std::size_t const size = static_cast<std::size_t>(mSize);
+            std::size_t const numBColumns = static_cast<std::size_t>(numColumns);
+            std::size_t const numBlocks = (RowMajor ?
+                (numBColumns + blockColumns - 1) / blockColumns : numBColumns);
+
+            auto solveBlocks = [this, dataMatrix, size, numBColumns](
+                std::size_t iMin, std::size_t iSup)
             {
-                Real lowerRR = operator()(r, r);
-                if (lowerRR > (Real)0)
+                for (std::size_t i = iMin; i < iSup; ++i)
                 {
-                    for (int32_t c = 0; c < r; ++c)
+                    if (RowMajor)
                     {
-                        Real lowerRC = operator()(r, c);
-                        for (int32_t bCol = 0; bCol < numColumns; ++bCol)
-                        {
-                            data(r, bCol) -= lowerRC * data(c, bCol);
-                        }
+                        std::size_t const cMin = i * blockColumns;
+                        std::size_t const cSup = std::min(cMin + blockColumns, numBColumns);
+                        SolveBlock(dataMatrix + cMin, numBColumns, cSup - cMin);
                     }
-
-                    Real inverse = ((Real)1) / lowerRR;
-                    for (int32_t bCol = 0; bCol < numColumns; ++bCol)
+                    else
                     {
-                        data(r, bCol) *= inverse;
+                        SolveBlock(dataMatrix + i * size, 1, 1);
                     }
                 }
-                else
+            };
+
+            numThreads = std::min(numThreads, numBlocks);
+            if (numThreads <= 1)
+            {
+                solveBlocks(0, numBlocks);
+            }
+            else
+            {
+                std::vector<std::thread> process(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
                 {
-                    return false;
+                    std::size_t const iMin = t * numBlocks / numThreads;
+                    std::size_t const iSup = (t + 1) * numBlocks / numThreads;
+                    process[t] = std::thread(solveBlocks, iMin, iSup);
+                }
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
                 }
             }
             return true;
         }
 
-        // The linear system is U*X = L^{-1}*B.  Reduce this to
-        // X = U^{-1}*L^{-1}*B.  The return value is 'true' iff the operation
-        // is successful.  See the comments for SolveSystem(Real*,int32_t) about
-        // the storage for dataMatrix.
-        template <bool RowMajor>
-        bool SolveUpper(Real* dataMatrix, int32_t numColumns) const
+        // Solve L*U*X = B for a block of numColumns adjacent columns of B,
+        // where the entry (r,c) of the block is data[r * rowStride + c].
+        // The innermost loops are over the columns of the block, which are
+        // contiguous in memory, so the compiler can vectorize them.
+        void SolveBlock(Real* data, std::size_t rowStride, std::size_t numColumns) const
         {
-            LexicoArray2<RowMajor, Real> data(mSize, numColumns, dataMatrix);
+            std::size_t const size = static_cast<std::size_t>(mSize);
 
-            for (int32_t r = mSize - 1; r >= 0; --r)
+            // Forward substitution for L. The products are subtracted in
+            // increasing column order of L.
+            std::size_t const numLBands = mLBands.size();
+            for (std::size_t r = 0; r < size; ++r)
             {
-                Real upperRR = operator()(r, r);
-                if (upperRR > (Real)0)
+                Real* rowR = data + r * rowStride;
+                for (std::size_t b = std::min(r, numLBands); b-- > 0; )
                 {
-                    for (int32_t c = r + 1; c < mSize; ++c)
+                    Real const lowerRC = mLBands[b][r - 1 - b];
+                    Real const* rowC = data + (r - 1 - b) * rowStride;
+                    for (std::size_t c = 0; c < numColumns; ++c)
                     {
-                        Real upperRC = operator()(r, c);
-                        for (int32_t bCol = 0; bCol < numColumns; ++bCol)
-                        {
-                            data(r, bCol) -= upperRC * data(c, bCol);
-                        }
+                        rowR[c] -= lowerRC * rowC[c];
                     }
+                }
+
+                Real const inverse = ((Real)1) / mDBand[r];
+                for (std::size_t c = 0; c < numColumns; ++c)
+                {
+                    rowR[c] *= inverse;
+                }
+            }
 
-                    Real inverse = ((Real)1) / upperRR;
-                    for (int32_t bCol = 0; bCol < numColumns; ++bCol)
+            // Backward substitution for U. The products are subtracted in
+            // increasing column order of U.
+            std::size_t const numUBands = mUBands.size();
+            for (std::size_t r = size; r-- > 0; )
+            {
+                Real* rowR = data + r * rowStride;
+                std::size_t const bMax = std::min(size - 1 - r, numUBands);
+                for (std::size_t b = 0; b < bMax; ++b)
+                {
+                    Real const upperRC = mUBands[b][r];
+                    Real const* rowC = data + (r + 1 + b) * rowStride;
+                    for (std::size_t c = 0; c < numColumns; ++c)
                     {
-                        data(r, bCol) *= inverse;
+                        rowR[c] -= upperRC * rowC[c];
                     }
                 }
-                else
+
+                Real const inverse = ((Real)1) / mDBand[r];
+                for (std::size_t c = 0; c < numColumns; ++c)
+                {
+                    rowR[c] *= inverse;
+                }
+            }
+        }
+
+        bool IsDiagonalPositive() const
+        {
+            for (auto const& diagonal : mDBand)
+            {
+                if (!(diagonal > (Real)0))
                 {
                     return false;
                 }
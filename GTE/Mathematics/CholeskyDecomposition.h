@@ -3,15 +3,18 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2026.02.18
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
 #include <Mathematics/Matrix.h>
 #include <Mathematics/GMatrix.h>
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <thread>
 #include <vector>
 
 namespace gte
@@ -92,17 +95,31 @@ namespace gte
         }
     };
 
-    // Implementation for size known only at run time.
+    // Implementation for size known only at run time. The factorization is
+    // blocked. The columns are processed in panels of 64. The diagonal block
+    // of a panel is factored as in the unblocked algorithm, the entries of
+    // the panel below the diagonal block are computed by triangular solves,
+    // and then the trailing lower-triangular submatrix is updated by the
+    // panel. The update is applied to contiguous rows (or columns when
+    // GTE_USE_COL_MAJOR is defined) of the trailing submatrix, in tiles of
+    // 256 entries so that the tile of the panel remains in cache, and these
+    // loops can be vectorized by the compiler. The rows of the panel and
+    // of the trailing submatrix are interleaved among the threads. The
+    // results are the same for any number of threads, and they are the
+    // same as those of the unblocked algorithm when N <= 64.
     template <typename Real>
     class CholeskyDecomposition<Real, 0>
     {
     public:
         int32_t const N;
 
-        // Ensure that N > 0 at run time.
-        CholeskyDecomposition(int32_t n)
+        // Ensure that N > 0 at run time. Set numThreads to 0 or 1 to factor
+        // in the main thread. Set numThreads to 2 or larger to distribute
+        // the updates of the factorization among that many threads.
+        CholeskyDecomposition(int32_t n, std::size_t numThreads = 0)
             :
-            N(n)
+            N(n),
+            mNumThreads(numThreads)
         {
         }
 
@@ -120,25 +137,70 @@ namespace gte
         {
             if (A.GetNumRows() == N && A.GetNumCols() == N)
             {
-                for (int32_t c = 0; c < N; ++c)
+                std::size_t const size = static_cast<std::size_t>(N);
+                Real* a = &A[0];
+                std::vector<Real> panel{};
+                for (std::size_t k0 = 0; k0 < size; k0 += blockSize)
                 {
-                    if (A(c, c) <= (Real)0)
-                    {
-                        return false;
-                    }
-                    A(c, c) = std::sqrt(A(c, c));
+                    std::size_t const k1 = std::min(k0 + blockSize, size);
 
-                    for (int32_t r = c + 1; r < N; ++r)
+                    // Factor the diagonal block A(k0:k1,k0:k1).
+                    for (std::size_t c = k0; c < k1; ++c)
                     {
-                        A(r, c) /= A(c, c);
+                        Real& diagonal = a[Index(c, c)];
+                        if (diagonal <= (Real)0)
+                        {
+                            return false;
+                        }
+                        diagonal = std::sqrt(diagonal);
+
+                        for (std::size_t r = c + 1; r < k1; ++r)
+                        {
+                            a[Index(r, c)] /= diagonal;
+                        }
+
+                        for (std::size_t k = c + 1; k < k1; ++k)
+                        {
+                            for (std::size_t r = k; r < k1; ++r)
+                            {
+                                a[Index(r, k)] -= a[Index(r, c)] * a[Index(k, c)];
+                            }
+                        }
                     }
 
-                    for (int32_t k = c + 1; k < N; ++k)
+                    if (k1 < size)
                     {
-                        for (int32_t r = k; r < N; ++r)
+                        // Solve L(k1:N,k0:k1) * L(k0:k1,k0:k1)^T =
+                        // A(k1:N,k0:k1) for the panel below the diagonal
+                        // block.
+                        Execute(size - k1, [this, a, size, k0, k1](std::size_t t, std::size_t numT)
                         {
-                            A(r, k) -= A(r, c) * A(k, c);
+                            for (std::size_t r = k1 + t; r < size; r += numT)
+                            {
+                                for (std::size_t c = k0; c < k1; ++c)
+                                {
+                                    Real value = a[Index(r, c)];
+                                    for (std::size_t k = k0; k < c; ++k)
+                                    {
+                                        value -= a[Index(r, k)] * a[Index(c, k)];
+                                    }
+                                    a[Index(r, c)] = value / a[Index(c, c)];
+                                }
+                            }
+                        });
+
+                        // A(k1:N,k1:N) -= L(k1:N,k0:k1) * L(k1:N,k0:k1)^T
+                        std::size_t const numPanelRows = size - k1;
+                        panel.resize((k1 - k0) * numPanelRows);
+                        for (std::size_t k = k0; k < k1; ++k)
+                        {
+                            Real* target = &panel[(k - k0) * numPanelRows];
+                            for (std::size_t r = k1; r < size; ++r)
+                            {
+                                target[r - k1] = a[Index(r, k)];
+                            }
                         }
+                        UpdateTrailing(a, size, k0, k1, panel.data());
                     }
                 }
                 return true;
@@ -186,6 +248,84 @@ namespace gte
                 LogError("Invalid size.");
             }
         }
+
+    private:
+        static std::size_t constexpr blockSize = 64;
+        static std::size_t constexpr tileSize = 256;
+
+        // The index of entry (r,c) in the storage of an NxN matrix.
+        inline std::size_t Index(std::size_t r, std::size_t c) const
+        {
+#if defined(GTE_USE_COL_MAJOR)
+            return r + static_cast<std::size_t>(N) * c;
+#else
+            return c + static_cast<std::size_t>(N) * r;
+#endif
+        }
+
+        // Subtract L(k1:N,k0:k1) * L(k1:N,k0:k1)^T from the lower-triangular
+        // part of A(k1:N,k1:N), where panel[(k - k0) * (N - k1) + r - k1]
+        // is L(r,k). For row-major storage, row r is updated for columns
+        // k1 <= c <= r. For column-major storage, column r is updated for
+        // rows r <= c < N. In both cases the entries are contiguous.
+        void UpdateTrailing(Real* a, std::size_t size, std::size_t k0,
+            std::size_t k1, Real const* panel)
+        {
+            std::size_t const numPanelRows = size - k1;
+            Execute(numPanelRows, [a, size, k0, k1, panel, numPanelRows](std::size_t t, std::size_t numT)
+            {
+                for (std::size_t c0 = k1; c0 < size; c0 += tileSize)
+                {
+                    std::size_t const c1 = std::min(c0 + tileSize, size);
+                    for (std::size_t r = k1 + t; r < size; r += numT)
+                    {
+#if defined(GTE_USE_COL_MAJOR)
+                        std::size_t const cMin = std::max(c0, r), cSup = c1;
+#else
+                        std::size_t const cMin = c0, cSup = std::min(c1, r + 1);
+#endif
+                        Real* target = a + r * size;
+                        for (std::size_t k = 0; k < k1 - k0; ++k)
+                        {
+                            Real const* source = panel + k * numPanelRows;
+                            Real const value = source[r - k1];
+                            for (std::size_t c = cMin; c < cSup; ++c)
+                            {
+                                target[c] -= value * source[c - k1];
+                            }
+                        }
+                    }
+                }
+            });
+        }
+
+        // Process the items [0,numItems) by calls function(t, numThreads),
+        // where thread t processes the items t, t + numThreads, and so on.
+        // The work per item varies with the item, so the items are
+        // interleaved to balance the work among the threads.
+        template <typename Function>
+        void Execute(std::size_t numItems, Function const& function) const
+        {
+            std::size_t const numThreads = std::min(mNumThreads, numItems);
+            if (numThreads <= 1)
+            {
+                function(0, 1);
+            }
+            else
+            {
+                std::vector<std::thread> process(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t] = std::thread(function, t, numThreads);
+                }
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+        }
+
+        std::size_t mNumThreads;
     };
 
 
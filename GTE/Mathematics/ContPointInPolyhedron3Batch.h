@@ -0,0 +1,462 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2026
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 8.3.2026.10.18
+
+#pragma once
+
+// Point-in-polyhedron classification for many points. The polyhedron is a
+// closed triangle mesh whose triangles are counterclockwise ordered when
+// viewed from outside, the same convention as the TRIANGLE faces of
+// PointInPolyhedron3. Nonconvex polygon faces must be triangulated first.
+//
+// PointInPolyhedron3 casts its rays against every face for each point. This
+// class instead casts every ray in the +x direction. The triangles are
+// projected onto the yz-plane and stored once in a uniform grid of cells,
+// so a ray from (x,y,z) is tested only against the triangles in the cell
+// containing (y,z). Each triangle crossed by the ray contributes the sign of
+// the x-component of its outer normal. The sum is the winding number of the
+// mesh about the point, which is nonzero for points inside the mesh and
+// zero for points outside.
+//
+// A ray can pass exactly through an edge or a vertex of the projected
+// triangles, for example when the sample points are aligned with an axis-
+// aligned mesh. Each (y,z) is assigned to exactly one of the projected
+// triangles sharing such an edge or vertex, using the top-left rule of
+// triangle rasterization with edge functions that are computed identically
+// for both triangles that share an edge. The winding number is therefore
+// correct for every ray, whereas the counting in PointInPolyhedron3 uses
+// multiple random rays to vote. Points exactly on the mesh surface may be
+// classified either way.
+//
+// The grid query classifies the samples of a regular 3D lattice, which is
+// the voxelization of the mesh. All samples with the same (y,z) are on one
+// scanline. The crossings of the scanline are computed and sorted once, and
+// the samples are then classified in increasing x-order by a running sum of
+// the crossing signs. The z-slabs of the lattice are distributed among
+// threads.
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/Vector2.h>
+#include <Mathematics/Vector3.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace gte
+{
+    template <typename Real>
+    class PointInPolyhedron3Batch
+    {
+    public:
+        // The triangle indices are into the vertex array. The number of
+        // cells per dimension of the yz-grid is chosen from the number of
+        // triangles when numCellsPerDimension is 0.
+        PointInPolyhedron3Batch(
+            std::vector<Vector3<Real>> const& vertices,
+            std::vector<std::array<int32_t, 3>> const& triangles,
+            std::size_t numCellsPerDimension = 0)
+            :
+            mTriangles{},
+            mNumCells(numCellsPerDimension),
+            mMin{},
+            mMax{},
+            mInvCellSize{},
+            mCellOffsets{},
+            mCellTriangles{}
+        {
+            LogAssert(
+                vertices.size() > 0 && triangles.size() > 0,
+                "The mesh must have vertices and triangles.");
+
+            // Compute the projected triangle data. Triangles that project to
+            // segments or points are never crossed by a ray and are
+            // discarded.
+            mTriangles.reserve(triangles.size());
+            for (auto const& triangle : triangles)
+            {
+                Vector3<Real> const& v0 = vertices[triangle[0]];
+                Vector3<Real> const& v1 = vertices[triangle[1]];
+                Vector3<Real> const& v2 = vertices[triangle[2]];
+                Vector3<Real> normal = Cross(v1 - v0, v2 - v0);
+                if (normal[0] == static_cast<Real>(0))
+                {
+                    continue;
+                }
+
+                ProjectedTriangle projected{};
+                projected.p[0] = { v0[1], v0[2] };
+                projected.p[1] = { v1[1], v1[2] };
+                projected.p[2] = { v2[1], v2[2] };
+                if (normal[0] > static_cast<Real>(0))
+                {
+                    projected.sign = +1;
+                }
+                else
+                {
+                    // Reorder the projected triangle to be counterclockwise.
+                    std::swap(projected.p[1], projected.p[2]);
+                    projected.sign = -1;
+                }
+                projected.x0 = v0[0];
+                projected.dxdy = -normal[1] / normal[0];
+                projected.dxdz = -normal[2] / normal[0];
+                mTriangles.push_back(projected);
+            }
+            LogAssert(
+                mTriangles.size() > 0,
+                "The mesh has no volume.");
+
+            // The grid covers the bounding rectangle of the projected mesh.
+            mMin = mTriangles[0].p[0];
+            mMax = mMin;
+            for (auto const& projected : mTriangles)
+            {
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    for (std::int32_t k = 0; k < 2; ++k)
+                    {
+                        mMin[k] = std::min(mMin[k], projected.p[j][k]);
+                        mMax[k] = std::max(mMax[k], projected.p[j][k]);
+                    }
+                }
+            }
+
+            if (mNumCells == 0)
+            {
+                mNumCells = static_cast<std::size_t>(std::sqrt(
+                    static_cast<double>(mTriangles.size())));
+                mNumCells = std::min(std::max(mNumCells, static_cast<std::size_t>(1)),
+                    static_cast<std::size_t>(4096));
+            }
+
+            for (std::int32_t k = 0; k < 2; ++k)
+            {
+                Real const extent = mMax[k] - mMin[k];
+                mInvCellSize[k] = (extent > static_cast<Real>(0) ?
+                    static_cast<Real>(mNumCells) / extent : static_cast<Real>(0));
+            }
+
+            // Store the triangles in the cells overlapped by their bounding
+            // rectangles. The cell of a point is computed by the same
+            // monotone function as the cells of the rectangle corners, so a
+            // point in a projected triangle is always in one of the cells
+            // that store the triangle. The storage is compressed: the
+            // triangles of cell c are mCellTriangles[i] for
+            // mCellOffsets[c] <= i < mCellOffsets[c + 1].
+            std::size_t const numCells = mNumCells * mNumCells;
+            std::vector<std::array<std::size_t, 4>> ranges(mTriangles.size());
+            mCellOffsets.assign(numCells + 1, 0);
+            for (std::size_t t = 0; t < mTriangles.size(); ++t)
+            {
+                auto const& p = mTriangles[t].p;
+                auto& range = ranges[t];
+                for (std::int32_t k = 0; k < 2; ++k)
+                {
+                    range[2 * k] = GetCell(k, std::min(std::min(p[0][k], p[1][k]), p[2][k]));
+                    range[2 * k + 1] = GetCell(k, std::max(std::max(p[0][k], p[1][k]), p[2][k]));
+                }
+
+                for (std::size_t c1 = range[2]; c1 <= range[3]; ++c1)
+                {
+                    for (std::size_t c0 = range[0]; c0 <= range[1]; ++c0)
+                    {
+                        ++mCellOffsets[c0 + mNumCells * c1 + 1];
+                    }
+                }
+            }
+
+            for (std::size_t c = 0; c < numCells; ++c)
+            {
+                mCellOffsets[c + 1] += mCellOffsets[c];
+            }
+
+            std::vector<std::size_t> current(mCellOffsets.begin(), mCellOffsets.end() - 1);
+            mCellTriangles.resize(mCellOffsets.back());
+            for (std::size_t t = 0; t < mTriangles.size(); ++t)
+            {
+                auto const& range = ranges[t];
+                for (std::size_t c1 = range[2]; c1 <= range[3]; ++c1)
+                {
+                    for (std::size_t c0 = range[0]; c0 <= range[1]; ++c0)
+                    {
+                        mCellTriangles[current[c0 + mNumCells * c1]++] = t;
+                    }
+                }
+            }
+        }
+
+        // Classify a single point.
+        bool Contains(Vector3<Real> const& p) const
+        {
+            Vector2<Real> q{ p[1], p[2] };
+            if (!InBounds(q))
+            {
+                return false;
+            }
+
+            std::size_t const cell = GetCell(0, q[0]) + mNumCells * GetCell(1, q[1]);
+            std::int32_t winding = 0;
+            for (std::size_t i = mCellOffsets[cell]; i < mCellOffsets[cell + 1]; ++i)
+            {
+                auto const& projected = mTriangles[mCellTriangles[i]];
+                if (Contains(projected, q) && GetCrossing(projected, q) > p[0])
+                {
+                    winding += projected.sign;
+                }
+            }
+            return winding != 0;
+        }
+
+        // Classify an array of points. The output inside[i] is 1 when
+        // points[i] is inside the mesh and 0 otherwise. Set numThreads to 0
+        // or 1 to execute in the main thread. Set numThreads to 2 or larger
+        // to distribute the points among that many threads.
+        void Contains(std::vector<Vector3<Real>> const& points,
+            std::size_t numThreads, std::vector<std::uint8_t>& inside) const
+        {
+            inside.resize(points.size());
+            numThreads = std::min(numThreads, points.size());
+            if (numThreads <= 1)
+            {
+                for (std::size_t i = 0; i < points.size(); ++i)
+                {
+                    inside[i] = (Contains(points[i]) ? 1 : 0);
+                }
+            }
+            else
+            {
+                std::size_t const numPerThread = points.size() / numThreads;
+                std::vector<std::thread> process(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    std::size_t const iMin = t * numPerThread;
+                    std::size_t const iSup = (t + 1 < numThreads ? iMin + numPerThread : points.size());
+                    process[t] = std::thread([this, &points, &inside, iMin, iSup]()
+                    {
+                        for (std::size_t i = iMin; i < iSup; ++i)
+                        {
+                            inside[i] = (Contains(points[i]) ? 1 : 0);
+                        }
+                    });
+                }
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+        }
+
+        // Classify the samples origin + (i * spacing[0], j * spacing[1],
+        // k * spacing[2]) for 0 <= i < numSamples[0], 0 <= j < numSamples[1]
+        // and 0 <= k < numSamples[2]. The output inside[i + numSamples[0] *
+        // (j + numSamples[1] * k)] is 1 when the sample is inside the mesh
+        // and 0 otherwise. The spacing[0] must be positive. Set numThreads
+        // to 0 or 1 to execute in the main thread. Set numThreads to 2 or
+        // larger to distribute the z-slabs among that many threads.
+        void Contains(Vector3<Real> const& origin, Vector3<Real> const& spacing,
+            std::array<std::size_t, 3> const& numSamples, std::size_t numThreads,
+            std::vector<std::uint8_t>& inside) const
+        {
+            LogAssert(
+                spacing[0] > static_cast<Real>(0),
+                "The x-spacing must be positive.");
+
+            inside.assign(numSamples[0] * numSamples[1] * numSamples[2], 0);
+            if (inside.size() == 0)
+            {
+                return;
+            }
+
+            auto processSlab = [this, &origin, &spacing, &numSamples, &inside](
+                std::size_t k, std::vector<std::pair<Real, std::int32_t>>& crossings)
+            {
+                for (std::size_t j = 0; j < numSamples[1]; ++j)
+                {
+                    Vector2<Real> q
+                    {
+                        origin[1] + static_cast<Real>(j) * spacing[1],
+                        origin[2] + static_cast<Real>(k) * spacing[2]
+                    };
+
+                    std::uint8_t* line = &inside[numSamples[0] * (j + numSamples[1] * k)];
+                    ClassifyScanline(origin[0], spacing[0], numSamples[0], q,
+                        crossings, line);
+                }
+            };
+
+            std::size_t const numSlabs = numSamples[2];
+            numThreads = std::min(numThreads, numSlabs);
+            if (numThreads <= 1)
+            {
+                std::vector<std::pair<Real, std::int32_t>> crossings{};
+                for (std::size_t k = 0; k < numSlabs; ++k)
+                {
+                    processSlab(k, crossings);
+                }
+            }
+            else
+            {
+                // The slabs are interleaved among the threads, which
+                // balances the work when the mesh occupies only part of the
+                // lattice.
+                std::vector<std::thread> process(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t] = std::thread([&processSlab, numSlabs, t, numThreads]()
+                    {
+                        std::vector<std::pair<Real, std::int32_t>> crossings{};
+                        for (std::size_t k = t; k < numSlabs; k += numThreads)
+                        {
+                            processSlab(k, crossings);
+                        }
+                    });
+                }
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+        }
+
+    private:
+        // The projection of a triangle onto the yz-plane, ordered
+        // counterclockwise. The sign is that of the x-component of the
+        // outer normal. The ray crosses the plane of the triangle at
+        // x = x0 + dxdy * (y - v0.y) + dxdz * (z - v0.z), where v0 is the
+        // first mesh vertex of the triangle, which is also p[0].
+        struct ProjectedTriangle
+        {
+            std::array<Vector2<Real>, 3> p;
+            Real x0, dxdy, dxdz;
+            std::int32_t sign;
+        };
+
+        inline std::size_t GetCell(std::int32_t k, Real const& u) const
+        {
+            Real const cell = (u - mMin[k]) * mInvCellSize[k];
+            if (cell <= static_cast<Real>(0))
+            {
+                return 0;
+            }
+            std::size_t const index = static_cast<std::size_t>(cell);
+            return std::min(index, mNumCells - 1);
+        }
+
+        inline bool InBounds(Vector2<Real> const& q) const
+        {
+            return mMin[0] <= q[0] && q[0] <= mMax[0]
+                && mMin[1] <= q[1] && q[1] <= mMax[1];
+        }
+
+        inline Real GetCrossing(ProjectedTriangle const& projected,
+            Vector2<Real> const& q) const
+        {
+            return projected.x0
+                + projected.dxdy * (q[0] - projected.p[0][0])
+                + projected.dxdz * (q[1] - projected.p[0][1]);
+        }
+
+        // The edge function of q relative to the directed edge <e0,e1>. It
+        // is computed with the endpoints in lexicographic order and negated
+        // when necessary, so the two directions of an edge produce values
+        // that are exact negatives of each other.
+        static Real EdgeFunction(Vector2<Real> const& e0, Vector2<Real> const& e1,
+            Vector2<Real> const& q)
+        {
+            if (e1 < e0)
+            {
+                return -DotPerp(e0 - e1, q - e1);
+            }
+            return DotPerp(e1 - e0, q - e0);
+        }
+
+        // The top-left rule for a counterclockwise triangle. Of the two
+        // directions of an edge, exactly one satisfies the rule.
+        static bool IsTopLeft(Vector2<Real> const& e0, Vector2<Real> const& e1)
+        {
+            Vector2<Real> const d = e1 - e0;
+            return d[1] < static_cast<Real>(0)
+                || (d[1] == static_cast<Real>(0) && d[0] < static_cast<Real>(0));
+        }
+
+        static bool Contains(ProjectedTriangle const& projected, Vector2<Real> const& q)
+        {
+            auto const& p = projected.p;
+            for (std::size_t i0 = 2, i1 = 0; i1 < 3; i0 = i1++)
+            {
+                Real const e = EdgeFunction(p[i0], p[i1], q);
+                if (e < static_cast<Real>(0) ||
+                    (e == static_cast<Real>(0) && !IsTopLeft(p[i0], p[i1])))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void ClassifyScanline(Real const& x0, Real const& dx, std::size_t numSamples,
+            Vector2<Real> const& q, std::vector<std::pair<Real, std::int32_t>>& crossings,
+            std::uint8_t* line) const
+        {
+            if (!InBounds(q))
+            {
+                return;
+            }
+
+            crossings.clear();
+            std::int32_t total = 0;
+            std::size_t const cell = GetCell(0, q[0]) + mNumCells * GetCell(1, q[1]);
+            for (std::size_t i = mCellOffsets[cell]; i < mCellOffsets[cell + 1]; ++i)
+            {
+                auto const& projected = mTriangles[mCellTriangles[i]];
+                if (Contains(projected, q))
+                {
+                    crossings.push_back(std::make_pair(GetCrossing(projected, q), projected.sign));
+                    total += projected.sign;
+                }
+            }
+
+            if (crossings.size() == 0)
+            {
+                return;
+            }
+
+            // The winding number at x is the sum of the signs of the
+            // crossings larger than x, which is the total minus the sum of
+            // the signs of the crossings at most x.
+            std::sort(crossings.begin(), crossings.end());
+            std::size_t c = 0;
+            std::int32_t passed = 0;
+            for (std::size_t i = 0; i < numSamples; ++i)
+            {
+                Real const x = x0 + static_cast<Real>(i) * dx;
+                while (c < crossings.size() && crossings[c].first <= x)
+                {
+                    passed += crossings[c].second;
+                    ++c;
+                }
+
+                if (passed == total && c == crossings.size())
+                {
+                    break;
+                }
+
+                line[i] = (total - passed != 0 ? 1 : 0);
+            }
+        }
+
+        std::vector<ProjectedTriangle> mTriangles;
+        std::size_t mNumCells;
+        Vector2<Real> mMin, mMax, mInvCellSize;
+        std::vector<std::size_t> mCellOffsets;
+        std::vector<std::size_t> mCellTriangles;
+    };
+}
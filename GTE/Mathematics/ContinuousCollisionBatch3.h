@@ -0,0 +1,334 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2026
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 8.3.2026.10.18
+
+#pragma once
+
+// Continuous collision detection for many pairs of moving objects during a
+// time step [0,tMax]. The objects are triangles and spheres, each moving
+// with a constant linear velocity. The candidate pairs are provided by the
+// caller, typically from a broad phase, as triangle-triangle pairs and
+// sphere-triangle pairs. For each pair, the first time of contact is
+// computed by the time-of-impact queries
+//   TIQuery<T, Triangle3<T>, Triangle3<T>> (moving triangles)
+//   FIQuery<T, Sphere3<T>, Triangle3<T>> (moving sphere and triangle)
+// and the earliest contact of each object is reported.
+//
+// Before a query is applied, the pair is rejected when the axis-aligned box
+// of the first object, swept by the velocity relative to the second object,
+// does not overlap the box of the second object. For linear motion the
+// relative swept box contains the relative swept volume, so the rejection
+// is conservative.
+//
+// The pairs are distributed among numThreads threads, each pair result is
+// written by exactly one thread and the per-object reduction is performed
+// in pair order, so the results do not depend on the number of threads.
+
+#include <Mathematics/AlignedBox.h>
+#include <Mathematics/IntrSphere3Triangle3.h>
+#include <Mathematics/IntrTriangle3Triangle3.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace gte
+{
+    template <typename T>
+    class ContinuousCollisionBatch3
+    {
+    public:
+        enum class PairType
+        {
+            TRIANGLE_TRIANGLE,
+            SPHERE_TRIANGLE
+        };
+
+        // The earliest contact of an object. If the object has no contact
+        // during [0,tMax], pair is invalid and time is max(T).
+        struct ObjectContact
+        {
+            ObjectContact()
+                :
+                time(std::numeric_limits<T>::max()),
+                type(PairType::TRIANGLE_TRIANGLE),
+                pair(invalid)
+            {
+            }
+
+            // The contact is for the pair with index 'pair' in the input
+            // list of the given type.
+            T time;
+            PairType type;
+            std::size_t pair;
+        };
+
+        // The contacts of the pairs of one type. For pair i, intersect[i]
+        // is 1 when the objects are in contact at some time in [0,tMax], in
+        // which case contactTime[i] is the first time of contact. Otherwise,
+        // intersect[i] is 0 and contactTime[i] is 0. For objects that are
+        // initially overlapping, the contact time is 0.
+        struct PairContacts
+        {
+            PairContacts()
+                :
+                intersect{},
+                contactTime{}
+            {
+            }
+
+            std::vector<std::uint8_t> intersect;
+            std::vector<T> contactTime;
+        };
+
+        struct Result
+        {
+            Result()
+                :
+                triangleTriangle{},
+                sphereTriangle{},
+                triangleContact{},
+                sphereContact{},
+                numRejected(0)
+            {
+            }
+
+            PairContacts triangleTriangle, sphereTriangle;
+            std::vector<ObjectContact> triangleContact, sphereContact;
+
+            // The number of pairs rejected by the swept-box test.
+            std::size_t numRejected;
+        };
+
+        // Each triangle-triangle pair is {triangle index, triangle index}
+        // and each sphere-triangle pair is {sphere index, triangle index}.
+        // An index out of range causes an exception before any pair is
+        // processed.
+        // Set numThreads to 0 or 1 to execute in the main thread. Set
+        // numThreads to 2 or larger to distribute the pairs among that many
+        // threads.
+        void operator()(T const& tMax,
+            std::vector<Triangle3<T>> const& triangles,
+            std::vector<Vector3<T>> const& triangleVelocities,
+            std::vector<Sphere3<T>> const& spheres,
+            std::vector<Vector3<T>> const& sphereVelocities,
+            std::vector<std::array<std::size_t, 2>> const& triangleTrianglePairs,
+            std::vector<std::array<std::size_t, 2>> const& sphereTrianglePairs,
+            std::size_t numThreads,
+            Result& result) const
+        {
+            LogAssert(
+                tMax >= static_cast<T>(0),
+                "The maximum time must be nonnegative.");
+            LogAssert(
+                triangleVelocities.size() == triangles.size() &&
+                sphereVelocities.size() == spheres.size(),
+                "Each object must have a velocity.");
+
+            // The pairs are processed by worker threads, so the object
+            // indices are validated here in the calling thread.
+            for (auto const& pair : triangleTrianglePairs)
+            {
+                LogAssert(
+                    pair[0] < triangles.size() && pair[1] < triangles.size(),
+                    "Invalid triangle index in a triangle-triangle pair.");
+            }
+            for (auto const& pair : sphereTrianglePairs)
+            {
+                LogAssert(
+                    pair[0] < spheres.size() && pair[1] < triangles.size(),
+                    "Invalid index in a sphere-triangle pair.");
+            }
+
+            // Compute the boxes of the objects at time 0.
+            std::vector<AlignedBox3<T>> triangleBoxes(triangles.size());
+            for (std::size_t i = 0; i < triangles.size(); ++i)
+            {
+                auto const& triangle = triangles[i];
+                auto& box = triangleBoxes[i];
+                for (std::int32_t k = 0; k < 3; ++k)
+                {
+                    box.min[k] = std::min(std::min(triangle.v[0][k], triangle.v[1][k]), triangle.v[2][k]);
+                    box.max[k] = std::max(std::max(triangle.v[0][k], triangle.v[1][k]), triangle.v[2][k]);
+                }
+            }
+
+            std::vector<AlignedBox3<T>> sphereBoxes(spheres.size());
+            for (std::size_t i = 0; i < spheres.size(); ++i)
+            {
+                auto const& sphere = spheres[i];
+                auto& box = sphereBoxes[i];
+                for (std::int32_t k = 0; k < 3; ++k)
+                {
+                    box.min[k] = sphere.center[k] - sphere.radius;
+                    box.max[k] = sphere.center[k] + sphere.radius;
+                }
+            }
+
+            std::size_t const numTTPairs = triangleTrianglePairs.size();
+            std::size_t const numSTPairs = sphereTrianglePairs.size();
+            std::size_t const numPairs = numTTPairs + numSTPairs;
+            Resize(numTTPairs, result.triangleTriangle);
+            Resize(numSTPairs, result.sphereTriangle);
+            std::vector<std::uint8_t> rejected(numPairs);
+
+            // Pair i < numTTPairs is triangle-triangle pair i and pair
+            // i >= numTTPairs is sphere-triangle pair i - numTTPairs.
+            auto processPair = [&](std::size_t i)
+            {
+                if (i < numTTPairs)
+                {
+                    auto const& pair = triangleTrianglePairs[i];
+                    Vector3<T> const& velocity0 = triangleVelocities[pair[0]];
+                    Vector3<T> const& velocity1 = triangleVelocities[pair[1]];
+                    if (!SweptBoxesOverlap(tMax, triangleBoxes[pair[0]], velocity0,
+                        triangleBoxes[pair[1]], velocity1))
+                    {
+                        rejected[i] = 1;
+                        return;
+                    }
+
+                    TIQuery<T, Triangle3<T>, Triangle3<T>> query{};
+                    auto output = query(tMax, triangles[pair[0]], velocity0,
+                        triangles[pair[1]], velocity1);
+                    if (output.intersect)
+                    {
+                        result.triangleTriangle.intersect[i] = 1;
+                        result.triangleTriangle.contactTime[i] = output.contactTime;
+                    }
+                }
+                else
+                {
+                    std::size_t const j = i - numTTPairs;
+                    auto const& pair = sphereTrianglePairs[j];
+                    Vector3<T> const& velocity0 = sphereVelocities[pair[0]];
+                    Vector3<T> const& velocity1 = triangleVelocities[pair[1]];
+                    if (!SweptBoxesOverlap(tMax, sphereBoxes[pair[0]], velocity0,
+                        triangleBoxes[pair[1]], velocity1))
+                    {
+                        rejected[i] = 1;
+                        return;
+                    }
+
+                    // The query computes the first time of contact for
+                    // t >= 0 without an upper bound.
+                    FIQuery<T, Sphere3<T>, Triangle3<T>> query{};
+                    auto output = query(spheres[pair[0]], velocity0,
+                        triangles[pair[1]], velocity1);
+                    if (output.intersectionType != 0 && output.contactTime <= tMax)
+                    {
+                        result.sphereTriangle.intersect[j] = 1;
+                        result.sphereTriangle.contactTime[j] = output.contactTime;
+                    }
+                }
+            };
+
+            numThreads = std::min(numThreads, numPairs);
+            if (numThreads <= 1)
+            {
+                for (std::size_t i = 0; i < numPairs; ++i)
+                {
+                    processPair(i);
+                }
+            }
+            else
+            {
+                // The pairs are interleaved among the threads, which
+                // balances the work when the rejected pairs are clustered
+                // in the input lists.
+                std::vector<std::thread> process(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t] = std::thread([&processPair, numPairs, t, numThreads]()
+                    {
+                        for (std::size_t i = t; i < numPairs; i += numThreads)
+                        {
+                            processPair(i);
+                        }
+                    });
+                }
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+
+            result.numRejected = 0;
+            for (auto r : rejected)
+            {
+                result.numRejected += r;
+            }
+
+            // Reduce the pair contacts to the earliest contact per object.
+            // On equal times, the first pair in the input order is kept.
+            result.triangleContact.assign(triangles.size(), ObjectContact{});
+            result.sphereContact.assign(spheres.size(), ObjectContact{});
+            for (std::size_t i = 0; i < numTTPairs; ++i)
+            {
+                if (result.triangleTriangle.intersect[i])
+                {
+                    T const time = result.triangleTriangle.contactTime[i];
+                    auto const& pair = triangleTrianglePairs[i];
+                    Update(time, PairType::TRIANGLE_TRIANGLE, i, result.triangleContact[pair[0]]);
+                    Update(time, PairType::TRIANGLE_TRIANGLE, i, result.triangleContact[pair[1]]);
+                }
+            }
+            for (std::size_t i = 0; i < numSTPairs; ++i)
+            {
+                if (result.sphereTriangle.intersect[i])
+                {
+                    T const time = result.sphereTriangle.contactTime[i];
+                    auto const& pair = sphereTrianglePairs[i];
+                    Update(time, PairType::SPHERE_TRIANGLE, i, result.sphereContact[pair[0]]);
+                    Update(time, PairType::SPHERE_TRIANGLE, i, result.triangleContact[pair[1]]);
+                }
+            }
+        }
+
+    private:
+        static std::size_t constexpr invalid = std::numeric_limits<std::size_t>::max();
+
+        static void Resize(std::size_t numPairs, PairContacts& contacts)
+        {
+            contacts.intersect.assign(numPairs, 0);
+            contacts.contactTime.assign(numPairs, static_cast<T>(0));
+        }
+
+        // Test whether box0, swept by the velocity of object0 relative to
+        // object1 during [0,tMax], overlaps box1.
+        static bool SweptBoxesOverlap(T const& tMax,
+            AlignedBox3<T> const& box0, Vector3<T> const& velocity0,
+            AlignedBox3<T> const& box1, Vector3<T> const& velocity1)
+        {
+            T const zero = static_cast<T>(0);
+            for (std::int32_t k = 0; k < 3; ++k)
+            {
+                T const delta = tMax * (velocity0[k] - velocity1[k]);
+                if (box0.max[k] + std::max(delta, zero) < box1.min[k] ||
+                    box0.min[k] + std::min(delta, zero) > box1.max[k])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static void Update(T const& time, PairType type, std::size_t pair,
+            ObjectContact& contact)
+        {
+            if (time < contact.time)
+            {
+                contact.time = time;
+                contact.type = type;
+                contact.pair = pair;
+            }
+        }
+    };
+}
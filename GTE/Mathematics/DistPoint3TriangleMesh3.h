@@ -0,0 +1,294 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2026
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 8.3.2026.10.18
+
+#pragma once
+
+// Compute the closest point on a triangle mesh to a query point, which is
+// the mesh-level counterpart of DCPQuery<T, Vector3<T>, Triangle3<T>>. The
+// mesh is stored in an axis-aligned bounding box tree whose leaves contain
+// up to leafSize triangles. A query traverses the tree depth first, visiting
+// the child whose box is closer to the point first, and skips every subtree
+// whose box is farther from the point than the closest triangle found so
+// far. The triangles are also stored in structure-of-arrays form in the
+// order of the tree partition, so the triangles of a leaf are contiguous and
+// are processed by the vectorizable kernel TriangleBatch3::ClosestPoint.
+//
+// The distance agrees with that of the per-triangle scalar query up to
+// rounding errors. When several triangles are at the minimum distance, for
+// example when the closest point is a shared vertex or edge, any one of them
+// is reported.
+//
+// The object is not modified by the queries, so a single object can be
+// queried concurrently. The batch query distributes the points among
+// numThreads threads.
+
+#include <Mathematics/AlignedBoxTreeOfTriangles.h>
+#include <Mathematics/Logger.h>
+#include <Mathematics/TriangleBatch3.h>
+#include <Mathematics/Vector3.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace gte
+{
+    template <typename T>
+    class DistPoint3TriangleMesh3
+    {
+    public:
+        struct Result
+        {
+            Result()
+                :
+                distance(static_cast<T>(0)),
+                sqrDistance(static_cast<T>(0)),
+                triangle(std::numeric_limits<std::size_t>::max()),
+                barycentric{ static_cast<T>(0), static_cast<T>(0), static_cast<T>(0) },
+                closest(Vector3<T>::Zero())
+            {
+            }
+
+            // The closest point is
+            //   closest = sum_{i=0}^{2} barycentric[i] * V[triangles[triangle][i]]
+            // where V are the mesh vertices.
+            T distance, sqrDistance;
+            std::size_t triangle;
+            std::array<T, 3> barycentric;
+            Vector3<T> closest;
+        };
+
+        DistPoint3TriangleMesh3()
+            :
+            mTree{},
+            mBatch{}
+        {
+        }
+
+        // The leafSize is the maximum number of triangles in a tree leaf. It
+        // must be positive. Small leaves lead to more box tests and large
+        // leaves lead to more triangle tests.
+        void Create(
+            std::vector<Vector3<T>> const& vertices,
+            std::vector<std::array<std::size_t, 3>> const& triangles,
+            std::size_t leafSize = 8)
+        {
+            LogAssert(
+                leafSize > 0,
+                "The leaf size must be positive.");
+
+            // The median splits of the tree produce leaves with at most
+            // ceil(numTriangles / 2^height) triangles.
+            std::size_t const numTriangles = triangles.size();
+            std::size_t height = 0;
+            while (height < 31 &&
+                ((numTriangles + (static_cast<std::size_t>(1) << height) - 1) >> height) > leafSize)
+            {
+                ++height;
+            }
+            mTree.Create(vertices, triangles, height);
+
+            auto const& partition = mTree.GetPartition();
+            std::vector<std::array<std::size_t, 3>> ordered(numTriangles);
+            for (std::size_t i = 0; i < numTriangles; ++i)
+            {
+                ordered[i] = triangles[partition[i]];
+            }
+            mBatch.Set(vertices, ordered);
+        }
+
+        // Member access.
+        inline AlignedBoxTreeOfTriangles<T> const& GetTree() const
+        {
+            return mTree;
+        }
+
+        // Compute the closest mesh point to a single point.
+        Result operator()(Vector3<T> const& point) const
+        {
+            using Node = typename AlignedBoxTreeOfTriangles<T>::Node;
+            auto const& nodes = mTree.GetNodes();
+
+            T bestSqrDistance = std::numeric_limits<T>::max();
+            std::size_t bestIndex = Node::invalid;
+            T bestS = static_cast<T>(0), bestT = static_cast<T>(0);
+
+            // Each entry of the stack is a node and the squared distance
+            // from the point to its box. A balanced tree has height at most
+            // 31, so at most 2 * 31 + 1 entries are on the stack.
+            std::array<std::size_t, 64> stackNode{};
+            std::array<T, 64> stackSqrDistance{};
+            stackNode[0] = 0;
+            stackSqrDistance[0] = GetSqrDistance(point, nodes[0]);
+            std::size_t top = 1;
+
+            std::array<T, numLanes> laneSqrDistance{}, laneS{}, laneT{};
+            while (top > 0)
+            {
+                --top;
+                if (stackSqrDistance[top] >= bestSqrDistance)
+                {
+                    // A closer triangle was found after this node was
+                    // pushed.
+                    continue;
+                }
+
+                Node const& node = nodes[stackNode[top]];
+                if (node.minIndex == Node::invalid)
+                {
+                    continue;
+                }
+
+                if (node.leftChild == Node::invalid)
+                {
+                    // Process the triangles of the leaf in groups.
+                    for (std::size_t i0 = node.minIndex; i0 <= node.maxIndex; i0 += numLanes)
+                    {
+                        std::size_t const count = std::min(node.maxIndex + 1 - i0,
+                            static_cast<std::size_t>(numLanes));
+                        EvaluateLanes(point, i0, count, laneSqrDistance, laneS, laneT);
+                        for (std::size_t k = 0; k < count; ++k)
+                        {
+                            if (laneSqrDistance[k] < bestSqrDistance)
+                            {
+                                bestSqrDistance = laneSqrDistance[k];
+                                bestIndex = i0 + k;
+                                bestS = laneS[k];
+                                bestT = laneT[k];
+                            }
+                        }
+                    }
+                    continue;
+                }
+
+                // Push the farther child first so that the nearer child is
+                // processed first.
+                T sqrDistance0 = GetSqrDistance(point, nodes[node.leftChild]);
+                T sqrDistance1 = GetSqrDistance(point, nodes[node.rightChild]);
+                std::size_t child0 = node.leftChild, child1 = node.rightChild;
+                if (sqrDistance1 < sqrDistance0)
+                {
+                    std::swap(sqrDistance0, sqrDistance1);
+                    std::swap(child0, child1);
+                }
+                if (sqrDistance1 < bestSqrDistance)
+                {
+                    stackNode[top] = child1;
+                    stackSqrDistance[top] = sqrDistance1;
+                    ++top;
+                }
+                if (sqrDistance0 < bestSqrDistance)
+                {
+                    stackNode[top] = child0;
+                    stackSqrDistance[top] = sqrDistance0;
+                    ++top;
+                }
+            }
+
+            Result result{};
+            if (bestIndex != Node::invalid)
+            {
+                result.triangle = mTree.GetPartition()[bestIndex];
+                auto const& tri = mTree.GetTriangles()[result.triangle];
+                auto const& vertices = mTree.GetVertices();
+                Vector3<T> const& V0 = vertices[tri[0]];
+                result.closest = V0 + bestS * (vertices[tri[1]] - V0) + bestT * (vertices[tri[2]] - V0);
+                result.sqrDistance = bestSqrDistance;
+                result.distance = std::sqrt(bestSqrDistance);
+                result.barycentric[0] = static_cast<T>(1) - bestS - bestT;
+                result.barycentric[1] = bestS;
+                result.barycentric[2] = bestT;
+            }
+            return result;
+        }
+
+        // Compute the closest mesh points to a collection of points. Set
+        // numThreads to 0 or 1 to compute in the main thread. Set numThreads
+        // to 2 or larger to distribute the points among that many threads.
+        void operator()(std::vector<Vector3<T>> const& points,
+            std::vector<Result>& results, std::size_t numThreads = 0) const
+        {
+            std::size_t const numPoints = points.size();
+            results.resize(numPoints);
+            numThreads = std::min(numThreads, numPoints);
+            if (numThreads <= 1)
+            {
+                for (std::size_t i = 0; i < numPoints; ++i)
+                {
+                    results[i] = (*this)(points[i]);
+                }
+                return;
+            }
+
+            // The points are interleaved among the threads, which balances
+            // the work when the query cost varies smoothly with the point
+            // location, as it does for grid points of a distance field.
+            std::vector<std::thread> process(numThreads);
+            for (std::size_t t = 0; t < numThreads; ++t)
+            {
+                process[t] = std::thread([this, &points, &results, t, numThreads]()
+                {
+                    for (std::size_t i = t; i < points.size(); i += numThreads)
+                    {
+                        results[i] = (*this)(points[i]);
+                    }
+                });
+            }
+            for (std::size_t t = 0; t < numThreads; ++t)
+            {
+                process[t].join();
+            }
+        }
+
+    private:
+        static std::size_t constexpr numLanes = 8;
+
+        static T GetSqrDistance(Vector3<T> const& point,
+            typename AlignedBoxTreeOfTriangles<T>::Node const& node)
+        {
+            auto const& box = node.boundingVolume.box;
+            T sqrDistance = static_cast<T>(0);
+            for (int32_t k = 0; k < 3; ++k)
+            {
+                T delta = std::max(std::max(box.min[k] - point[k], point[k] - box.max[k]),
+                    static_cast<T>(0));
+                sqrDistance += delta * delta;
+            }
+            return sqrDistance;
+        }
+
+        void EvaluateLanes(Vector3<T> const& point, std::size_t i0, std::size_t count,
+            std::array<T, numLanes>& laneSqrDistance, std::array<T, numLanes>& laneS,
+            std::array<T, numLanes>& laneT) const
+        {
+            T const px = point[0], py = point[1], pz = point[2];
+            T const* v0x = mBatch.v0[0].data() + i0;
+            T const* v0y = mBatch.v0[1].data() + i0;
+            T const* v0z = mBatch.v0[2].data() + i0;
+            T const* e1x = mBatch.edge1[0].data() + i0;
+            T const* e1y = mBatch.edge1[1].data() + i0;
+            T const* e1z = mBatch.edge1[2].data() + i0;
+            T const* e2x = mBatch.edge2[0].data() + i0;
+            T const* e2y = mBatch.edge2[1].data() + i0;
+            T const* e2z = mBatch.edge2[2].data() + i0;
+            for (std::size_t k = 0; k < count; ++k)
+            {
+                TriangleBatch3<T>::ClosestPoint(
+                    px - v0x[k], py - v0y[k], pz - v0z[k],
+                    e1x[k], e1y[k], e1z[k], e2x[k], e2y[k], e2z[k],
+                    laneSqrDistance[k], laneS[k], laneT[k]);
+            }
+        }
+
+        AlignedBoxTreeOfTriangles<T> mTree;
+        TriangleBatch3<T> mBatch;
+    };
+}
@@ -0,0 +1,398 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2026
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 8.3.2026.10.18
+
+#pragma once
+
+// Batch versions of DCPQuery<T, Segment<N, T>, Segment<N, T>>::operator()
+// for many pairs of segments or for one segment and many segments. The
+// segments are stored in structure-of-arrays form by SegmentBatch. The
+// queries evaluate the pairs in groups using the branchless function
+// ComputeParameters, which an optimizing compiler vectorizes for the target
+// instruction set; see the comments in TriangleBatch3.h about compiler
+// options.
+//
+// ComputeParameters is a restatement of the region logic of the scalar
+// operator() in terms of selects. It performs the same arithmetic operations
+// on the same inputs, so the parameters and squared distances are equal to
+// those of the scalar query up to differences in floating-point contraction
+// (fused multiply-add) that the compiler applies to one loop and not the
+// other, and except when a denominator is a positive subnormal number. In
+// particular, the parallel and nearly parallel cases are handled exactly as
+// in the scalar operator(). For nearly parallel segments where rounding
+// errors matter, use the scalar ComputeRobust instead.
+//
+// The output for pair i is stored in flat arrays. The closest points are
+// not stored; they are
+//   closest[0] = P0[i] + parameter[0][i] * (P1[i] - P0[i])
+//   closest[1] = Q0[i] + parameter[1][i] * (Q1[i] - Q0[i])
+
+#include <Mathematics/DistSegmentSegment.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace gte
+{
+    // Segments stored in structure-of-arrays form. Segment i is stored as
+    // the endpoint p[0] and the difference p[1] - p[0], with component j in
+    // origin[j][i] and direction[j][i].
+    template <int32_t N, typename T>
+    class SegmentBatch
+    {
+    public:
+        SegmentBatch()
+            :
+            origin{},
+            direction{}
+        {
+        }
+
+        SegmentBatch(std::vector<Segment<N, T>> const& segments)
+            :
+            origin{},
+            direction{}
+        {
+            Set(segments);
+        }
+
+        void Set(std::vector<Segment<N, T>> const& segments)
+        {
+            for (std::size_t j = 0; j < static_cast<std::size_t>(N); ++j)
+            {
+                origin[j].resize(segments.size());
+                direction[j].resize(segments.size());
+            }
+
+            for (std::size_t i = 0; i < segments.size(); ++i)
+            {
+                Vector<N, T> const& P0 = segments[i].p[0];
+                Vector<N, T> const P1mP0 = segments[i].p[1] - P0;
+                for (int32_t j = 0; j < N; ++j)
+                {
+                    origin[j][i] = P0[j];
+                    direction[j][i] = P1mP0[j];
+                }
+            }
+        }
+
+        inline std::size_t GetNumSegments() const
+        {
+            return origin[0].size();
+        }
+
+        Segment<N, T> GetSegment(std::size_t i) const
+        {
+            Segment<N, T> segment{};
+            for (int32_t j = 0; j < N; ++j)
+            {
+                segment.p[0][j] = origin[j][i];
+                segment.p[1][j] = origin[j][i] + direction[j][i];
+            }
+            return segment;
+        }
+
+        std::array<std::vector<T>, N> origin, direction;
+    };
+
+    template <int32_t N, typename T>
+    class DCPQuerySegmentSegmentBatch
+    {
+    public:
+        struct Result
+        {
+            Result()
+                :
+                distance{},
+                sqrDistance{},
+                parameter{}
+            {
+            }
+
+            void Resize(std::size_t numElements)
+            {
+                distance.resize(numElements);
+                sqrDistance.resize(numElements);
+                parameter[0].resize(numElements);
+                parameter[1].resize(numElements);
+            }
+
+            std::vector<T> distance, sqrDistance;
+            std::array<std::vector<T>, 2> parameter;
+        };
+
+        // Compute the closest points for the pairs (segments0[i],
+        // segments1[i]). The batches must have the same number of segments.
+        void operator()(SegmentBatch<N, T> const& segments0,
+            SegmentBatch<N, T> const& segments1, Result& result) const
+        {
+            std::size_t const numPairs = segments0.GetNumSegments();
+            LogAssert(
+                segments1.GetNumSegments() == numPairs,
+                "The batches must have the same number of segments.");
+
+            result.Resize(numPairs);
+            std::array<T const*, N> P0{}, P1mP0{}, Q0{}, Q1mQ0{};
+            for (std::size_t j = 0; j < static_cast<std::size_t>(N); ++j)
+            {
+                P0[j] = segments0.origin[j].data();
+                P1mP0[j] = segments0.direction[j].data();
+                Q0[j] = segments1.origin[j].data();
+                Q1mQ0[j] = segments1.direction[j].data();
+            }
+
+            Lanes lanes{};
+            for (std::size_t i0 = 0; i0 < numPairs; i0 += lanes.size)
+            {
+                std::size_t const numLanes = lanes.GetNumLanes(i0, numPairs);
+                lanes.ClearCoefficients(numLanes);
+                for (std::size_t j = 0; j < static_cast<std::size_t>(N); ++j)
+                {
+                    T const* p0 = P0[j] + i0;
+                    T const* p1mp0 = P1mP0[j] + i0;
+                    T const* q0 = Q0[j] + i0;
+                    T const* q1mq0 = Q1mQ0[j] + i0;
+                    for (std::size_t k = 0; k < numLanes; ++k)
+                    {
+                        lanes.AccumulateCoefficients(k, p0[k], p1mp0[k], q0[k], q1mq0[k]);
+                    }
+                }
+
+                lanes.ComputeParameters(numLanes);
+
+                for (std::size_t j = 0; j < static_cast<std::size_t>(N); ++j)
+                {
+                    T const* p0 = P0[j] + i0;
+                    T const* p1mp0 = P1mP0[j] + i0;
+                    T const* q0 = Q0[j] + i0;
+                    T const* q1mq0 = Q1mQ0[j] + i0;
+                    for (std::size_t k = 0; k < numLanes; ++k)
+                    {
+                        lanes.AccumulateSqrDistance(k, p0[k], p1mp0[k], q0[k], q1mq0[k]);
+                    }
+                }
+
+                lanes.CopyTo(i0, numLanes, result);
+            }
+        }
+
+        // Compute the closest points for the pairs (segment, segments[i]).
+        void operator()(Segment<N, T> const& segment,
+            SegmentBatch<N, T> const& segments, Result& result) const
+        {
+            std::size_t const numPairs = segments.GetNumSegments();
+            result.Resize(numPairs);
+
+            std::array<T, N> p0{}, p1mp0{};
+            std::array<T const*, N> Q0{}, Q1mQ0{};
+            for (std::size_t j = 0; j < static_cast<std::size_t>(N); ++j)
+            {
+                p0[j] = segment.p[0][j];
+                p1mp0[j] = segment.p[1][j] - segment.p[0][j];
+                Q0[j] = segments.origin[j].data();
+                Q1mQ0[j] = segments.direction[j].data();
+            }
+
+            Lanes lanes{};
+            for (std::size_t i0 = 0; i0 < numPairs; i0 += lanes.size)
+            {
+                std::size_t const numLanes = lanes.GetNumLanes(i0, numPairs);
+                lanes.ClearCoefficients(numLanes);
+                for (std::size_t j = 0; j < static_cast<std::size_t>(N); ++j)
+                {
+                    T const* q0 = Q0[j] + i0;
+                    T const* q1mq0 = Q1mQ0[j] + i0;
+                    for (std::size_t k = 0; k < numLanes; ++k)
+                    {
+                        lanes.AccumulateCoefficients(k, p0[j], p1mp0[j], q0[k], q1mq0[k]);
+                    }
+                }
+
+                lanes.ComputeParameters(numLanes);
+
+                for (std::size_t j = 0; j < static_cast<std::size_t>(N); ++j)
+                {
+                    T const* q0 = Q0[j] + i0;
+                    T const* q1mq0 = Q1mQ0[j] + i0;
+                    for (std::size_t k = 0; k < numLanes; ++k)
+                    {
+                        lanes.AccumulateSqrDistance(k, p0[j], p1mp0[j], q0[k], q1mq0[k]);
+                    }
+                }
+
+                lanes.CopyTo(i0, numLanes, result);
+            }
+        }
+
+        // The branchless form of the parameter computation of the scalar
+        // query. The inputs are the coefficients of the quadratic
+        //   R(s,t) = a*s^2 - 2*b*s*t + c*t^2 + 2*d*s - 2*e*t + f
+        // where a = Dot(P1-P0,P1-P0), b = Dot(P1-P0,Q1-Q0),
+        // c = Dot(Q1-Q0,Q1-Q0), d = Dot(P1-P0,P0-Q0) and
+        // e = Dot(Q1-Q0,P0-Q0). The outputs are the parameters of the
+        // closest points. All quotients are computed before the selects and
+        // no arithmetic is applied to a selected value. With the default
+        // -ftrapping-math, GCC does not if-convert conditional arithmetic,
+        // so other arrangements of the same logic are not vectorized.
+        inline static void ComputeParameters(T const& a, T const& b, T const& c,
+            T const& d, T const& e, T& s, T& t)
+        {
+            T const zero = static_cast<T>(0);
+
+            // The scalar query divides only in the region that contains the
+            // minimum and otherwise selects 0 or 1. Here the quotients of all
+            // regions are computed and clamped to [0,1], which produces the
+            // same values: a quotient is at most 0 exactly when the scalar
+            // query selects 0 and at least 1 exactly when it selects 1. The
+            // denominators are bounded below by the smallest normal number,
+            // which avoids divisions by zero for degenerate segments and
+            // leaves all positive denominators other than subnormal ones
+            // unchanged. The regions are classified using the numerators, as
+            // in the scalar query, and the parameters are selected from the
+            // clamped quotients.
+            T const minDenom = std::numeric_limits<T>::min();
+            T const det = a * c - b * b;
+            T const bte = b * e;
+            T const ctd = c * d;
+            T const ate = a * e;
+            T const btd = b * d;
+            T const sNumer = bte - ctd;
+            T const tNumer = ate - btd;
+            T const nd = -d;
+            T const bmd = b - d;
+            T const bpe = b + e;
+            T const safeDet = std::max(det, minDenom);
+            T const safeA = std::max(a, minDenom);
+            T const safeC = std::max(c, minDenom);
+            T const sInterior = Clamp(sNumer / safeDet);
+            T const tInterior = Clamp(tNumer / safeDet);
+            T const tForS0 = Clamp(e / safeC);
+            T const tForS1 = Clamp(bpe / safeC);
+            T const sForT0 = Clamp(nd / safeA);
+            T const sForT1 = Clamp(bmd / safeA);
+
+            // Choose s on the boundary or in the interior of [0,1] for the
+            // minimum of R on the line of critical points dR/dt = 0. For
+            // parallel segments, the scalar query starts with s = 0.
+            bool const notParallel = (det > zero);
+            bool const sIsPositive = (notParallel & (bte > ctd));
+            bool const sIsInterior = (sIsPositive & (sNumer < det));
+            bool const sIsOne = (sIsPositive & (sNumer >= det));
+            bool const sIsZero = !sIsPositive;
+
+            // Classify the t-value for the s-value. When t is clamped to 0
+            // or 1, s is recomputed as the clamped minimizer of R(s,t).
+            bool const tIsInterior =
+                (sIsInterior & (tNumer > zero) & (tNumer < det)) |
+                (sIsOne & (bpe > zero) & (bpe < c)) |
+                (sIsZero & (e > zero) & (e < c));
+            bool const tIsOne =
+                (sIsInterior & (tNumer >= det)) |
+                (sIsOne & (bpe > zero) & (bpe >= c)) |
+                (sIsZero & (e > zero) & (e >= c));
+
+            T const sFirst = (notParallel ? sInterior : zero);
+            T const tFirst = (sIsInterior ? tInterior : (sIsOne ? tForS1 : tForS0));
+            T const sClamped = (tIsOne ? sForT1 : sForT0);
+            s = (tIsInterior ? sFirst : sClamped);
+            t = tFirst;
+        }
+
+    private:
+        inline static T Clamp(T const& x)
+        {
+            return std::min(std::max(static_cast<T>(0), x), static_cast<T>(1));
+        }
+
+        // Storage for a group of pairs. The group is processed one dimension
+        // at a time, and the loops over the group write to these local
+        // arrays rather than to the result arrays, which allows the compiler
+        // to vectorize them without runtime aliasing checks. The dot products
+        // and the squared distance are accumulated in the order used by the
+        // scalar query.
+        struct Lanes
+        {
+            static std::size_t constexpr size = 64;
+
+            inline std::size_t GetNumLanes(std::size_t i0, std::size_t numElements) const
+            {
+                return (numElements - i0 < size ? numElements - i0 : size);
+            }
+
+            void ClearCoefficients(std::size_t numLanes)
+            {
+                T const zero = static_cast<T>(0);
+                for (std::size_t k = 0; k < numLanes; ++k)
+                {
+                    a[k] = zero;
+                    b[k] = zero;
+                    c[k] = zero;
+                    d[k] = zero;
+                    e[k] = zero;
+                    sqrDistance[k] = zero;
+                }
+            }
+
+            // Add the contributions of one dimension of the pair in lane k.
+            inline void AccumulateCoefficients(std::size_t k, T const& p0, T const& p1mp0,
+                T const& q0, T const& q1mq0)
+            {
+                T const p0mq0 = p0 - q0;
+                a[k] += p1mp0 * p1mp0;
+                b[k] += p1mp0 * q1mq0;
+                c[k] += q1mq0 * q1mq0;
+                d[k] += p1mp0 * p0mq0;
+                e[k] += q1mq0 * p0mq0;
+            }
+
+            void ComputeParameters(std::size_t numLanes)
+            {
+                for (std::size_t k = 0; k < numLanes; ++k)
+                {
+                    DCPQuerySegmentSegmentBatch::ComputeParameters(
+                        a[k], b[k], c[k], d[k], e[k], parameter0[k], parameter1[k]);
+                }
+            }
+
+            inline void AccumulateSqrDistance(std::size_t k, T const& p0, T const& p1mp0,
+                T const& q0, T const& q1mq0)
+            {
+                T const diff = (p0 + parameter0[k] * p1mp0) - (q0 + parameter1[k] * q1mq0);
+                sqrDistance[k] += diff * diff;
+            }
+
+            void CopyTo(std::size_t i0, std::size_t numLanes, Result& result) const
+            {
+                T* outDistance = result.distance.data() + i0;
+                T* outSqrDistance = result.sqrDistance.data() + i0;
+                T* outParameter0 = result.parameter[0].data() + i0;
+                T* outParameter1 = result.parameter[1].data() + i0;
+                for (std::size_t k = 0; k < numLanes; ++k)
+                {
+                    outSqrDistance[k] = sqrDistance[k];
+                    outParameter0[k] = parameter0[k];
+                    outParameter1[k] = parameter1[k];
+                }
+
+                // The square roots are in a separate loop. Unless errno
+                // reporting is disabled (-fno-math-errno), the compiler does
+                // not vectorize std::sqrt, and the other copies can still be
+                // vectorized.
+                for (std::size_t k = 0; k < numLanes; ++k)
+                {
+                    outDistance[k] = std::sqrt(sqrDistance[k]);
+                }
+            }
+
+            std::array<T, size> a, b, c, d, e, parameter0, parameter1, sqrDistance;
+        };
+    };
+}
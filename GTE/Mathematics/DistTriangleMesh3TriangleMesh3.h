@@ -0,0 +1,456 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2026
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 8.3.2026.10.18
+
+#pragma once
+
+// Compute the distance between two triangle meshes, which is the minimum of
+// the distances DCPQuery<T, Triangle3<T>, Triangle3<T>> over all pairs of
+// triangles, one from each mesh. The first mesh is stationary and the second
+// mesh is placed by a rigid motion. Each mesh is stored in an axis-aligned
+// bounding box tree that is built once by Create. The query is a branch and
+// bound traversal of pairs of nodes. The distance between the boxes of two
+// nodes is a lower bound for the distance between their triangles, so a
+// node pair is skipped when its lower bound is not smaller than the running
+// minimum. The child pairs are visited in the order of their lower bounds.
+//
+// When the second mesh is rotated, its boxes are no longer axis aligned and
+// the lower bound is computed for the axis-aligned box that contains the
+// rotated box. The bound is conservative, so the distance is still exact.
+//
+// With numThreads > 1, the node pairs near the roots are distributed among
+// the threads, which share the running minimum. When several triangle pairs
+// attain the minimum distance, any one of them is reported.
+//
+// The object is not modified by the queries, so a single object can be
+// queried concurrently.
+
+#include <Mathematics/AlignedBoxTreeOfTriangles.h>
+#include <Mathematics/AtomicMinMax.h>
+#include <Mathematics/DistTriangle3Triangle3.h>
+#include <Mathematics/Logger.h>
+#include <Mathematics/Matrix3x3.h>
+#include <Mathematics/Vector3.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace gte
+{
+    template <typename T>
+    class DistTriangleMesh3TriangleMesh3
+    {
+    public:
+        struct Result
+        {
+            Result()
+                :
+                distance(static_cast<T>(0)),
+                sqrDistance(static_cast<T>(0)),
+                triangle{
+                    std::numeric_limits<std::size_t>::max(),
+                    std::numeric_limits<std::size_t>::max() },
+                barycentric0{ static_cast<T>(0), static_cast<T>(0), static_cast<T>(0) },
+                barycentric1{ static_cast<T>(0), static_cast<T>(0), static_cast<T>(0) },
+                closest{ Vector3<T>::Zero(), Vector3<T>::Zero() },
+                withinTolerance(false)
+            {
+            }
+
+            // The closest pair is triangle[0] of mesh0 and triangle[1] of
+            // mesh1. The barycentric coordinates are relative to the
+            // vertices of the triangles and the closest points are in the
+            // coordinate system of mesh0. If withinTolerance is true, the
+            // query terminated early because it found a triangle pair whose
+            // distance is at most the tolerance. In this case, the reported
+            // pair is that pair and the mesh distance can be smaller.
+            T distance, sqrDistance;
+            std::array<std::size_t, 2> triangle;
+            std::array<T, 3> barycentric0;
+            std::array<T, 3> barycentric1;
+            std::array<Vector3<T>, 2> closest;
+            bool withinTolerance;
+        };
+
+        DistTriangleMesh3TriangleMesh3()
+            :
+            mTree0{},
+            mTree1{}
+        {
+        }
+
+        // The trees are built to full height, so each leaf has a single
+        // triangle.
+        void Create(
+            std::vector<Vector3<T>> const& vertices0,
+            std::vector<std::array<std::size_t, 3>> const& triangles0,
+            std::vector<Vector3<T>> const& vertices1,
+            std::vector<std::array<std::size_t, 3>> const& triangles1)
+        {
+            mTree0.Create(vertices0, triangles0);
+            mTree1.Create(vertices1, triangles1);
+        }
+
+        // Member access.
+        inline AlignedBoxTreeOfTriangles<T> const& GetTree0() const
+        {
+            return mTree0;
+        }
+
+        inline AlignedBoxTreeOfTriangles<T> const& GetTree1() const
+        {
+            return mTree1;
+        }
+
+        // Mesh1 is transformed into the coordinate system of mesh0 by the
+        // rigid motion X' = rotate * X + translate. The query terminates as
+        // soon as it finds a triangle pair whose distance is at most the
+        // nonnegative tolerance. For a clearance check, set the tolerance to
+        // the required clearance. For the exact distance, set it to 0, in
+        // which case the query still terminates as soon as it finds a pair
+        // of intersecting triangles. Set numThreads to 0 or 1 to execute in
+        // the main thread. Set numThreads to 2 or larger to distribute the
+        // traversal among that many threads.
+        Result operator()(
+            Matrix3x3<T> const& rotate,
+            Vector3<T> const& translate,
+            T const& tolerance,
+            std::size_t numThreads) const
+        {
+            Query query(mTree0, mTree1, rotate, translate, tolerance);
+
+            // Descend greedily to a pair of leaves to obtain an initial
+            // upper bound on the distance. This bound allows the threads to
+            // prune from the start.
+            Best best{};
+            NodePair nodePair{ 0, 0, query.GetSqrDistance(0, 0) };
+            while (true)
+            {
+                std::array<NodePair, 2> children{};
+                if (!query.GetChildren(nodePair, children))
+                {
+                    query.ProcessLeaves(nodePair, best);
+                    break;
+                }
+                nodePair = children[0];
+            }
+
+            std::vector<NodePair> frontier{ { 0, 0, query.GetSqrDistance(0, 0) } };
+            if (numThreads > 1)
+            {
+                // Expand the node pairs breadth first until there are
+                // enough of them to distribute among the threads. The pairs
+                // are sorted by lower bound and interleaved among the
+                // threads, so each thread starts with nearby pairs.
+                std::size_t const minFrontierSize = 4 * numThreads;
+                std::vector<NodePair> next{};
+                bool expanded = true;
+                while (expanded && frontier.size() < minFrontierSize)
+                {
+                    expanded = false;
+                    next.clear();
+                    for (auto const& pair : frontier)
+                    {
+                        std::array<NodePair, 2> children{};
+                        if (query.GetChildren(pair, children))
+                        {
+                            next.push_back(children[0]);
+                            next.push_back(children[1]);
+                            expanded = true;
+                        }
+                        else
+                        {
+                            next.push_back(pair);
+                        }
+                    }
+                    std::swap(frontier, next);
+                }
+                std::sort(frontier.begin(), frontier.end(),
+                    [](NodePair const& pair0, NodePair const& pair1)
+                    {
+                        return pair0.sqrDistance < pair1.sqrDistance;
+                    });
+                numThreads = std::min(numThreads, frontier.size());
+            }
+
+            if (numThreads <= 1)
+            {
+                query.Traverse(frontier, 0, 1, best);
+            }
+            else
+            {
+                std::vector<Best> threadBest(numThreads, best);
+                std::vector<std::thread> process(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t] = std::thread([&query, &frontier, &threadBest, t, numThreads]()
+                    {
+                        query.Traverse(frontier, t, numThreads, threadBest[t]);
+                    });
+                }
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                    if (threadBest[t].sqrDistance < best.sqrDistance)
+                    {
+                        best = threadBest[t];
+                    }
+                }
+            }
+
+            Result result{};
+            result.distance = best.result.distance;
+            result.sqrDistance = best.result.sqrDistance;
+            result.triangle = best.triangle;
+            result.barycentric0 = best.result.barycentric0;
+            result.barycentric1 = best.result.barycentric1;
+            result.closest = best.result.closest;
+            result.withinTolerance = (best.sqrDistance <= query.sqrTolerance);
+            return result;
+        }
+
+        // The query when both meshes are in the same coordinate system.
+        Result operator()(T const& tolerance, std::size_t numThreads) const
+        {
+            return (*this)(Matrix3x3<T>::Identity(), Vector3<T>::Zero(), tolerance, numThreads);
+        }
+
+    private:
+        using Node = typename AlignedBoxTreeOfTriangles<T>::Node;
+        using TTQuery = DCPQuery<T, Triangle3<T>, Triangle3<T>>;
+
+        // A pair of nodes, one from each tree, and the squared distance
+        // between their boxes.
+        struct NodePair
+        {
+            std::size_t node0, node1;
+            T sqrDistance;
+        };
+
+        // The closest triangle pair found by a thread.
+        struct Best
+        {
+            Best()
+                :
+                sqrDistance(std::numeric_limits<T>::max()),
+                triangle{
+                    std::numeric_limits<std::size_t>::max(),
+                    std::numeric_limits<std::size_t>::max() },
+                result{}
+            {
+            }
+
+            T sqrDistance;
+            std::array<std::size_t, 2> triangle;
+            typename TTQuery::Result result;
+        };
+
+        // The state of a single query, shared by the threads.
+        class Query
+        {
+        public:
+            Query(
+                AlignedBoxTreeOfTriangles<T> const& tree0,
+                AlignedBoxTreeOfTriangles<T> const& tree1,
+                Matrix3x3<T> const& rotate,
+                Vector3<T> const& translate,
+                T const& tolerance)
+                :
+                nodes0(tree0.GetNodes()),
+                nodes1(tree1.GetNodes()),
+                vertices0(tree0.GetVertices()),
+                triangles0(tree0.GetTriangles()),
+                triangles1(tree1.GetTriangles()),
+                partition0(tree0.GetPartition()),
+                partition1(tree1.GetPartition()),
+                vertices1(tree1.GetVertices().size()),
+                center1(nodes1.size()),
+                extent1(nodes1.size()),
+                sqrTolerance(tolerance * tolerance),
+                bound(std::numeric_limits<T>::max())
+            {
+                LogAssert(
+                    tolerance >= static_cast<T>(0),
+                    "The tolerance must be nonnegative.");
+
+                auto const& inVertices1 = tree1.GetVertices();
+                for (std::size_t i = 0; i < vertices1.size(); ++i)
+                {
+                    vertices1[i] = rotate * inVertices1[i] + translate;
+                }
+
+                // Transform the boxes of tree1 to the axis-aligned boxes
+                // that contain the rotated boxes.
+                Matrix3x3<T> absRotate{};
+                for (std::int32_t r = 0; r < 3; ++r)
+                {
+                    for (std::int32_t c = 0; c < 3; ++c)
+                    {
+                        absRotate(r, c) = std::fabs(rotate(r, c));
+                    }
+                }
+                for (std::size_t i = 0; i < nodes1.size(); ++i)
+                {
+                    Vector3<T> center{}, extent{};
+                    nodes1[i].boundingVolume.box.GetCenteredForm(center, extent);
+                    center1[i] = rotate * center + translate;
+                    extent1[i] = absRotate * extent;
+                }
+            }
+
+            // The squared distance between the box of nodes0[i0] and the
+            // box that contains the transformed box of nodes1[i1].
+            T GetSqrDistance(std::size_t i0, std::size_t i1) const
+            {
+                auto const& box0 = nodes0[i0].boundingVolume.box;
+                Vector3<T> const& center = center1[i1];
+                Vector3<T> const& extent = extent1[i1];
+                T sqrDistance = static_cast<T>(0);
+                for (std::int32_t k = 0; k < 3; ++k)
+                {
+                    T delta = std::max(std::max(
+                        box0.min[k] - (center[k] + extent[k]),
+                        (center[k] - extent[k]) - box0.max[k]),
+                        static_cast<T>(0));
+                    sqrDistance += delta * delta;
+                }
+                return sqrDistance;
+            }
+
+            // Split the node that has more triangles and return the two
+            // child pairs, the nearer pair first. The function returns
+            // false when both nodes are leaves.
+            bool GetChildren(NodePair const& pair, std::array<NodePair, 2>& children) const
+            {
+                Node const& node0 = nodes0[pair.node0];
+                Node const& node1 = nodes1[pair.node1];
+                bool isLeaf0 = (node0.leftChild == Node::invalid);
+                bool isLeaf1 = (node1.leftChild == Node::invalid);
+                if (isLeaf0 && isLeaf1)
+                {
+                    return false;
+                }
+
+                if (isLeaf0 || (!isLeaf1 &&
+                    node1.maxIndex - node1.minIndex > node0.maxIndex - node0.minIndex))
+                {
+                    children[0] = { pair.node0, node1.leftChild,
+                        GetSqrDistance(pair.node0, node1.leftChild) };
+                    children[1] = { pair.node0, node1.rightChild,
+                        GetSqrDistance(pair.node0, node1.rightChild) };
+                }
+                else
+                {
+                    children[0] = { node0.leftChild, pair.node1,
+                        GetSqrDistance(node0.leftChild, pair.node1) };
+                    children[1] = { node0.rightChild, pair.node1,
+                        GetSqrDistance(node0.rightChild, pair.node1) };
+                }
+
+                if (children[1].sqrDistance < children[0].sqrDistance)
+                {
+                    std::swap(children[0], children[1]);
+                }
+                return true;
+            }
+
+            // Compute the distances between the triangles of two leaves.
+            void ProcessLeaves(NodePair const& pair, Best& best)
+            {
+                Node const& node0 = nodes0[pair.node0];
+                Node const& node1 = nodes1[pair.node1];
+                TTQuery ttQuery{};
+                for (std::size_t i0 = node0.minIndex; i0 <= node0.maxIndex; ++i0)
+                {
+                    std::size_t t0 = partition0[i0];
+                    auto const& tri0 = triangles0[t0];
+                    Triangle3<T> triangle0(vertices0[tri0[0]], vertices0[tri0[1]], vertices0[tri0[2]]);
+                    for (std::size_t i1 = node1.minIndex; i1 <= node1.maxIndex; ++i1)
+                    {
+                        std::size_t t1 = partition1[i1];
+                        auto const& tri1 = triangles1[t1];
+                        Triangle3<T> triangle1(vertices1[tri1[0]], vertices1[tri1[1]], vertices1[tri1[2]]);
+                        auto ttResult = ttQuery(triangle0, triangle1);
+                        if (ttResult.sqrDistance < best.sqrDistance)
+                        {
+                            best.sqrDistance = ttResult.sqrDistance;
+                            best.triangle = { t0, t1 };
+                            best.result = ttResult;
+                            AtomicMin(bound, ttResult.sqrDistance);
+                        }
+                    }
+                }
+            }
+
+            // Traverse depth first the frontier pairs imin, imin+stride,
+            // imin+2*stride, ...
+            void Traverse(std::vector<NodePair> const& frontier,
+                std::size_t imin, std::size_t stride, Best& best)
+            {
+                std::vector<NodePair> stack{};
+                for (std::size_t i = imin; i < frontier.size(); i += stride)
+                {
+                    stack.push_back(frontier[i]);
+                    while (stack.size() > 0)
+                    {
+                        T currentBound = bound;
+                        if (currentBound <= sqrTolerance)
+                        {
+                            // A thread has found a pair within tolerance.
+                            return;
+                        }
+
+                        NodePair pair = stack.back();
+                        stack.pop_back();
+                        if (pair.sqrDistance >= currentBound)
+                        {
+                            continue;
+                        }
+
+                        std::array<NodePair, 2> children{};
+                        if (!GetChildren(pair, children))
+                        {
+                            ProcessLeaves(pair, best);
+                            continue;
+                        }
+
+                        // Push the farther pair first so that the nearer
+                        // pair is processed first.
+                        if (children[1].sqrDistance < currentBound)
+                        {
+                            stack.push_back(children[1]);
+                        }
+                        if (children[0].sqrDistance < currentBound)
+                        {
+                            stack.push_back(children[0]);
+                        }
+                    }
+                }
+            }
+
+            std::vector<Node> const& nodes0;
+            std::vector<Node> const& nodes1;
+            std::vector<Vector3<T>> const& vertices0;
+            std::vector<std::array<std::size_t, 3>> const& triangles0;
+            std::vector<std::array<std::size_t, 3>> const& triangles1;
+            std::vector<std::size_t> const& partition0;
+            std::vector<std::size_t> const& partition1;
+            std::vector<Vector3<T>> vertices1;
+            std::vector<Vector3<T>> center1, extent1;
+            T sqrTolerance;
+            std::atomic<T> bound;
+        };
+
+        AlignedBoxTreeOfTriangles<T> mTree0, mTree1;
+    };
+}
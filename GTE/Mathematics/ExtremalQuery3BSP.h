@@ -3,26 +3,32 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2025.11.01
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
 // The extremal queries for convex objects is based on the algorithm
 // described in
 // https://www.geometrictools.com/Documentation/ExtremalPolytopeQueries.pdf
+//
+// The BSP tree is built from triangle adjacency that is computed with sorted
+// arrays of edges rather than a VETManifoldMesh, and it is stored as a flat
+// array of nodes in depth-first order. Each node stores only the arc normal
+// and the two children. A child index that is negative encodes the extreme
+// vertex of a leaf region as -1 - vertex, so a query is a single loop of
+// dot products and array lookups. The batch query evaluates many directions
+// against the same tree, optionally distributed among threads.
 
 #include <Mathematics/Functions.h>
 #include <Mathematics/ExtremalQuery3.h>
-#include <Mathematics/RangeIteration.h>
-#include <Mathematics/VETManifoldMesh.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
-#include <map>
-#include <set>
-#include <stack>
 #include <queue>
-#include <unordered_set>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -36,29 +42,17 @@ namespace gte
         ExtremalQuery3BSP(Polyhedron3<Real> const& polytope)
             :
             ExtremalQuery3<Real>(polytope),
-            mTriToNormal{},
             mNodes{},
             mTreeDepth(0)
         {
             // Create the adjacency information for the polytope.
-            VETManifoldMesh mesh;
-            auto const& indices = this->mPolytope.GetIndices();
-            size_t const numTriangles = indices.size() / 3;
-            for (size_t t = 0; t < numTriangles; ++t)
-            {
-                std::array<int32_t, 3> V = { 0, 0, 0 };
-                for (size_t j = 0; j < 3; ++j)
-                {
-                    V[j] = indices[3 * t + j];
-                }
-                auto triangle = mesh.Insert(V[0], V[1], V[2]);
-                mTriToNormal.insert(std::make_pair(triangle, static_cast<int32_t>(t)));
-            }
+            Adjacency adjacency{};
+            CreateAdjacency(adjacency);
 
             // Create the set of unique arcs which are used to create the BSP
             // tree.
-            std::multiset<SphericalArc> arcs;
-            CreateSphericalArcs(mesh, arcs);
+            std::vector<SphericalArc> arcs{};
+            CreateSphericalArcs(adjacency, arcs);
 
             // Create the BSP tree to be used in the extremal query.
             CreateBSPTree(arcs);
@@ -73,59 +67,51 @@ namespace gte
         virtual void GetExtremeVertices(Vector3<Real> const& direction,
             int32_t& positiveDirection, int32_t& negativeDirection) override
         {
-            // Do a nonrecursive depth-first search of the BSP tree to
-            // determine spherical polygon contains the incoming direction D.
-            // Index 0 is the root of the BSP tree.
-            int32_t current = 0;
-            while (current >= 0)
+            positiveDirection = GetPositiveExtreme(direction);
+            negativeDirection = GetNegativeExtreme(direction);
+        }
+
+        // Compute the extreme vertices for an array of directions. The
+        // outputs positiveDirection[i] and negativeDirection[i] are the
+        // extreme vertices for directions[i]. Set numThreads to 0 or 1 to
+        // execute in the main thread. Set numThreads to 2 or larger to
+        // distribute the directions among that many threads.
+        void GetExtremeVertices(std::vector<Vector3<Real>> const& directions,
+            std::size_t numThreads, std::vector<int32_t>& positiveDirection,
+            std::vector<int32_t>& negativeDirection) const
+        {
+            std::size_t const numDirections = directions.size();
+            positiveDirection.resize(numDirections);
+            negativeDirection.resize(numDirections);
+
+            auto process = [this, &directions, &positiveDirection, &negativeDirection](
+                std::size_t iMin, std::size_t iSup)
             {
-                SphericalArc& node = mNodes[current];
-                int32_t sign = gte::isign(Dot(direction, node.normal));
-                if (sign >= 0)
-                {
-                    current = node.posChild;
-                    if (current == -1)
-                    {
-                        // At a leaf node.
-                        positiveDirection = node.posVertex;
-                    }
-                }
-                else
+                for (std::size_t i = iMin; i < iSup; ++i)
                 {
-                    current = node.negChild;
-                    if (current == -1)
-                    {
-                        // At a leaf node.
-                        positiveDirection = node.negVertex;
-                    }
+                    positiveDirection[i] = GetPositiveExtreme(directions[i]);
+                    negativeDirection[i] = GetNegativeExtreme(directions[i]);
                 }
-            }
+            };
 
-            // Do a nonrecursive depth-first search of the BSP tree to
-            // determine spherical polygon contains the reverse incoming
-            // direction -D.
-            current = 0;  // the root of the BSP tree
-            while (current >= 0)
+            numThreads = std::min(numThreads, numDirections);
+            if (numThreads <= 1)
             {
-                SphericalArc& node = mNodes[current];
-                int32_t sign = gte::isign(Dot(direction, node.normal));
-                if (sign <= 0)
+                process(0, numDirections);
+            }
+            else
+            {
+                std::size_t const numPerThread = numDirections / numThreads;
+                std::vector<std::thread> threads(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
                 {
-                    current = node.posChild;
-                    if (current == -1)
-                    {
-                        // At a leaf node.
-                        negativeDirection = node.posVertex;
-                    }
+                    std::size_t const iMin = t * numPerThread;
+                    std::size_t const iSup = (t + 1 < numThreads ? iMin + numPerThread : numDirections);
+                    threads[t] = std::thread(process, iMin, iSup);
                 }
-                else
+                for (std::size_t t = 0; t < numThreads; ++t)
                 {
-                    current = node.negChild;
-                    if (current == -1)
-                    {
-                        // At a leaf node.
-                        negativeDirection = node.negVertex;
-                    }
+                    threads[t].join();
                 }
             }
         }
@@ -142,6 +128,45 @@ namespace gte
         }
 
     private:
+        // A node of the BSP tree used by the queries. The region on the
+        // nonnegative side of the arc plane is child[0] and the region on
+        // the negative side is child[1]. A child c >= 0 is the index of a
+        // node. A child c < 0 is a leaf whose extreme vertex is -1 - c.
+        struct Node
+        {
+            Vector3<Real> normal;
+            std::array<int32_t, 2> child;
+        };
+
+        // Do a nonrecursive depth-first search of the BSP tree to determine
+        // the spherical polygon that contains the direction D. Index 0 is
+        // the root of the BSP tree.
+        int32_t GetPositiveExtreme(Vector3<Real> const& direction) const
+        {
+            int32_t current = 0;
+            do
+            {
+                Node const& node = mNodes[current];
+                current = node.child[Dot(direction, node.normal) >= static_cast<Real>(0) ? 0 : 1];
+            }
+            while (current >= 0);
+            return -1 - current;
+        }
+
+        // The same search for the spherical polygon that contains -D. The
+        // sign of each dot product is reversed rather than negating D.
+        int32_t GetNegativeExtreme(Vector3<Real> const& direction) const
+        {
+            int32_t current = 0;
+            do
+            {
+                Node const& node = mNodes[current];
+                current = node.child[Dot(direction, node.normal) <= static_cast<Real>(0) ? 0 : 1];
+            }
+            while (current >= 0);
+            return -1 - current;
+        }
+
         class SphericalArc
         {
         public:
@@ -158,16 +183,6 @@ namespace gte
             {
             }
 
-            // The arcs are stored in a multiset ordered by increasing
-            // separation.  The multiset will be traversed in reverse order.
-            // This heuristic is designed to create BSP trees whose top-most
-            // nodes can eliminate as many arcs as possible during an extremal
-            // query.
-            bool operator<(SphericalArc const& arc) const
-            {
-                return separation < arc.separation;
-            }
-
             // Indices N[] into the face normal array for the endpoints of the
             // arc.
             std::array<int32_t, 2> nIndex;
@@ -191,80 +206,140 @@ namespace gte
             int32_t posChild, negChild;
         };
 
-        typedef VETManifoldMesh::Triangle Triangle;
+        // The adjacency of the triangles of the polytope. Triangle t has
+        // vertices indices[3 * t + j] for 0 <= j <= 2. Its edge j is
+        // <V[j],V[(j+1)%3]> and the triangle sharing that edge is
+        // adjacent[3 * t + j]. The edges are listed once each, with the
+        // triangles sharing edge e being edges[e][0] < edges[e][1] and the
+        // edge being edge edges[e][2] of triangle edges[e][0]. Each vertex v
+        // has vertexTriangle[v] as an adjacent triangle and
+        // vertexValence[v] adjacent triangles; vertexValence[v] is 0 for
+        // vertices not referenced by the polytope.
+        struct Adjacency
+        {
+            std::vector<int32_t> adjacent;
+            std::vector<std::array<int32_t, 3>> edges;
+            std::vector<int32_t> vertexTriangle;
+            std::vector<int32_t> vertexValence;
+        };
 
-        void SortAdjacentTriangles(int32_t vIndex,
-            std::unordered_set<Triangle*> const& tAdj,
-            std::vector<Triangle*>& tAdjSorted)
+        void CreateAdjacency(Adjacency& adjacency) const
         {
-            // Copy the set of adjacent triangles into a vector container.
-            int32_t const numTriangles = static_cast<int32_t>(tAdj.size());
-            tAdjSorted.resize(tAdj.size());
+            auto const& indices = this->mPolytope.GetIndices();
+            int32_t const numIndices = static_cast<int32_t>(indices.size());
+            int32_t numVertices = 0;
+            for (auto index : indices)
+            {
+                numVertices = std::max(numVertices, index + 1);
+            }
+
+            // Sort the directed edges by their unordered vertex pairs, so
+            // the two occurrences of an edge are consecutive.
+            std::vector<std::pair<std::pair<int32_t, int32_t>, int32_t>> sorted(numIndices);
+            for (int32_t i = 0; i < numIndices; ++i)
+            {
+                int32_t const v0 = indices[i];
+                int32_t const v1 = indices[i % 3 < 2 ? i + 1 : i - 2];
+                sorted[i] = std::make_pair(std::make_pair(std::min(v0, v1), std::max(v0, v1)), i);
+            }
+            std::sort(sorted.begin(), sorted.end());
+
+            adjacency.adjacent.resize(numIndices);
+            adjacency.edges.resize(numIndices / 2);
+            for (int32_t e = 0, i = 0; i < numIndices; ++e, i += 2)
+            {
+                LogAssert(
+                    i + 1 < numIndices && sorted[i].first == sorted[i + 1].first &&
+                    (i + 2 == numIndices || sorted[i + 2].first != sorted[i].first),
+                    "The polytope must be a closed manifold mesh.");
+
+                int32_t const i0 = sorted[i].second;
+                int32_t const i1 = sorted[i + 1].second;
+                adjacency.adjacent[i0] = i1 / 3;
+                adjacency.adjacent[i1] = i0 / 3;
+                adjacency.edges[e] = { i0 / 3, i1 / 3, i0 % 3 };
+            }
+
+            adjacency.vertexTriangle.assign(numVertices, -1);
+            adjacency.vertexValence.assign(numVertices, 0);
+            for (int32_t i = 0; i < numIndices; ++i)
+            {
+                int32_t const v = indices[i];
+                if (adjacency.vertexValence[v]++ == 0)
+                {
+                    adjacency.vertexTriangle[v] = i / 3;
+                }
+            }
+        }
+
+        void SortAdjacentTriangles(Adjacency const& adjacency, int32_t vIndex,
+            std::vector<int32_t>& tAdjSorted) const
+        {
+            auto const& indices = this->mPolytope.GetIndices();
+            int32_t const numTriangles = adjacency.vertexValence[vIndex];
+            tAdjSorted.resize(numTriangles);
 
             // Traverse the triangles adjacent to vertex V using edge-triangle
             // adjacency information to produce a sorted array of adjacent
             // triangles.
-            Triangle* tri = *tAdj.begin();
+            int32_t tri = adjacency.vertexTriangle[vIndex];
             for (int32_t i = 0; i < numTriangles; ++i)
             {
                 for (int32_t prev = 2, curr = 0; curr < 3; prev = curr++)
                 {
-                    if (tri->V[curr] == vIndex)
+                    if (indices[3 * tri + curr] == vIndex)
                     {
                         tAdjSorted[i] = tri;
-                        tri = tri->T[prev];
+                        tri = adjacency.adjacent[3 * tri + prev];
                         break;
                     }
                 }
             }
         }
 
-        void CreateSphericalArcs(VETManifoldMesh& mesh, std::multiset<SphericalArc>& arcs)
+        void CreateSphericalArcs(Adjacency const& adjacency, std::vector<SphericalArc>& arcs) const
         {
+            auto const& indices = this->mPolytope.GetIndices();
             int32_t const prev[3] = { 2, 0, 1 };
             int32_t const next[3] = { 1, 2, 0 };
 
-            for (auto const& element : mesh.GetEdges())
+            arcs.reserve(adjacency.edges.size() + indices.size());
+            for (auto const& edge : adjacency.edges)
             {
-                auto const& edge = element.second;
-
                 SphericalArc arc{};
-                arc.nIndex[0] = mTriToNormal[edge->T[0]];
-                arc.nIndex[1] = mTriToNormal[edge->T[1]];
+                arc.nIndex[0] = edge[0];
+                arc.nIndex[1] = edge[1];
                 arc.separation = 1;
                 arc.normal = Cross(this->mFaceNormals[arc.nIndex[0]], this->mFaceNormals[arc.nIndex[1]]);
 
-                Triangle* adj = edge->T[0];
-                int32_t j;
-                for (j = 0; j < 3; ++j)
-                {
-                    if (adj->V[j] != edge->V[0] && adj->V[j] != edge->V[1])
-                    {
-                        arc.posVertex = adj->V[prev[j]];
-                        arc.negVertex = adj->V[next[j]];
-                        break;
-                    }
-                }
-                LogAssert(j < 3, "Unexpected condition.");
-
-                arcs.insert(arc);
+                // The vertex of triangle nIndex[0] opposite the edge is
+                // V[(j+2)%3] for the triangle edge j.
+                int32_t const* V = &indices[3 * static_cast<std::size_t>(edge[0])];
+                int32_t const j = (edge[2] + 2) % 3;
+                arc.posVertex = V[prev[j]];
+                arc.negVertex = V[next[j]];
+                arcs.push_back(arc);
             }
 
-            CreateSphericalBisectors(mesh, arcs);
+            CreateSphericalBisectors(adjacency, arcs);
         }
 
-        void CreateSphericalBisectors(VETManifoldMesh& mesh, std::multiset<SphericalArc>& arcs)
+        void CreateSphericalBisectors(Adjacency const& adjacency, std::vector<SphericalArc>& arcs) const
         {
             std::queue<std::pair<int32_t, int32_t>> queue;
-            for (auto const& element : mesh.GetVertices())
+            std::vector<int32_t> tAdjSorted{};
+            int32_t const numVertices = static_cast<int32_t>(adjacency.vertexValence.size());
+            for (int32_t vIndex = 0; vIndex < numVertices; ++vIndex)
             {
+                int32_t const numTriangles = adjacency.vertexValence[vIndex];
+                if (numTriangles == 0)
+                {
+                    continue;
+                }
+
                 // Sort the normals into a counterclockwise spherical polygon
                 // when viewed from outside the sphere.
-                auto const& vertex = element.second;
-                int32_t const vIndex = vertex->V;
-                std::vector<Triangle*> tAdjSorted;
-                SortAdjacentTriangles(vIndex, vertex->TAdjacent, tAdjSorted);
-                int32_t const numTriangles = static_cast<int32_t>(vertex->TAdjacent.size());
+                SortAdjacentTriangles(adjacency, vIndex, tAdjSorted);
                 queue.push(std::make_pair(0, numTriangles));
                 while (!queue.empty())
                 {
@@ -277,8 +352,8 @@ namespace gte
                         if (i1 < numTriangles)
                         {
                             SphericalArc arc{};
-                            arc.nIndex[0] = mTriToNormal[tAdjSorted[i0]];
-                            arc.nIndex[1] = mTriToNormal[tAdjSorted[i1]];
+                            arc.nIndex[0] = tAdjSorted[i0];
+                            arc.nIndex[1] = tAdjSorted[i1];
                             arc.separation = separation;
 
                             arc.normal = Cross(this->mFaceNormals[arc.nIndex[0]],
@@ -286,7 +361,7 @@ namespace gte
 
                             arc.posVertex = vIndex;
                             arc.negVertex = vIndex;
-                            arcs.insert(arc);
+                            arcs.push_back(arc);
                         }
                         int32_t imid = (i0 + i1 + 1) / 2;
                         if (imid != i1)
@@ -299,64 +374,100 @@ namespace gte
             }
         }
 
-        void CreateBSPTree(std::multiset<SphericalArc>& arcs)
+        void CreateBSPTree(std::vector<SphericalArc>& arcs)
         {
-            // The tree has at least a root.
-            mTreeDepth = 1;
+            // The arcs are inserted in order of decreasing separation. This
+            // heuristic is designed to create BSP trees whose top-most nodes
+            // can eliminate as many arcs as possible during an extremal
+            // query. Arcs of equal separation are inserted in the reverse
+            // order of their creation.
+            std::stable_sort(arcs.begin(), arcs.end(),
+                [](SphericalArc const& arc0, SphericalArc const& arc1)
+                {
+                    return arc0.separation < arc1.separation;
+                });
 
-            for (auto const& arc : gte::reverse(arcs))
+            std::vector<SphericalArc> tree{};
+            tree.reserve(2 * arcs.size());
+            std::vector<ArcPiece> candidates{};
+            for (auto arc = arcs.rbegin(); arc != arcs.rend(); ++arc)
             {
-                InsertArc(arc);
+                InsertArc(*arc, tree, candidates);
             }
 
-            // The leaf nodes are not counted in the traversal of InsertArc.
-            // The depth must be incremented to account for leaves.
-            ++mTreeDepth;
+            Flatten(tree);
+        }
+
+        // A piece of an arc being inserted into the subtree rooted at a
+        // node. The endpoints are face normals, in which case nIndex[] are
+        // their indices, or points where the arc was clipped by the plane of
+        // an ancestor node, in which case nIndex[] is -1.
+        struct ArcPiece
+        {
+            int32_t node;
+            std::array<Vector3<Real>, 2> endpoint;
+            std::array<int32_t, 2> nIndex;
+        };
+
+        int32_t GetSign(ArcPiece const& piece, int32_t i, SphericalArc const& node) const
+        {
+            if (piece.nIndex[i] >= 0 &&
+                (piece.nIndex[i] == node.nIndex[0] || piece.nIndex[i] == node.nIndex[1]))
+            {
+                return 0;
+            }
+            return gte::isign(Dot(piece.endpoint[i], node.normal));
         }
 
-        void InsertArc(SphericalArc const& arc)
+        void InsertArc(SphericalArc const& arc, std::vector<SphericalArc>& tree,
+            std::vector<ArcPiece>& candidates)
         {
             // The incoming arc is stored at the end of the nodes array.
-            if (mNodes.size() > 0)
+            if (tree.size() > 0)
             {
                 // Do a nonrecursive depth-first search of the current BSP
                 // tree to place the incoming arc.  Index 0 is the root of the
-                // BSP tree.
-                std::stack<int32_t> candidates;
-                candidates.push(0);
+                // BSP tree. When the arc straddles the plane of a node, it
+                // is split at the plane and each piece is propagated only to
+                // its side. A node is therefore created only in a region
+                // that its arc actually intersects, which guarantees that
+                // the vertex stored for a leaf region is correct. Without
+                // the clipping, an arc whose endpoints straddle the planes
+                // of two ancestors can be stored in a region it does not
+                // intersect.
+                candidates.clear();
+                ArcPiece root{};
+                root.node = 0;
+                root.endpoint[0] = this->mFaceNormals[arc.nIndex[0]];
+                root.endpoint[1] = this->mFaceNormals[arc.nIndex[1]];
+                root.nIndex = arc.nIndex;
+                candidates.push_back(root);
                 while (!candidates.empty())
                 {
-                    int32_t current = candidates.top();
-                    candidates.pop();
-                    SphericalArc* node = &mNodes[current];
-
-                    int32_t sign0;
-                    if (arc.nIndex[0] == node->nIndex[0] || arc.nIndex[0] == node->nIndex[1])
-                    {
-                        sign0 = 0;
-                    }
-                    else
-                    {
-                        Real dot = Dot(this->mFaceNormals[arc.nIndex[0]], node->normal);
-                        sign0 = gte::isign(dot);
-                    }
-
-                    int32_t sign1;
-                    if (arc.nIndex[1] == node->nIndex[0] || arc.nIndex[1] == node->nIndex[1])
-                    {
-                        sign1 = 0;
-                    }
-                    else
-                    {
-                        Real dot = Dot(this->mFaceNormals[arc.nIndex[1]], node->normal);
-                        sign1 = gte::isign(dot);
-                    }
+                    ArcPiece piece = candidates.back();
+                    candidates.pop_back();
+                    int32_t const current = piece.node;
+                    int32_t const sign0 = GetSign(piece, 0, tree[current]);
+                    int32_t const sign1 = GetSign(piece, 1, tree[current]);
 
+                    std::array<ArcPiece, 2> child{ piece, piece };
                     int32_t doTest = 0;
                     if (sign0 * sign1 < 0)
                     {
-                        // The new arc straddles the current arc, so propagate
-                        // it to both child nodes.
+                        // The new arc straddles the current arc. Split it at
+                        // the plane of the current arc and propagate the
+                        // pieces to both child nodes. The positive
+                        // combination of the endpoints is on the arc.
+                        Vector3<Real> const& normal = tree[current].normal;
+                        Real const d0 = Dot(piece.endpoint[0], normal);
+                        Real const d1 = Dot(piece.endpoint[1], normal);
+                        Vector3<Real> split = std::fabs(d0) * piece.endpoint[1] + std::fabs(d1) * piece.endpoint[0];
+                        Normalize(split);
+                        int32_t const pos = (sign0 > 0 ? 0 : 1);
+                        child[0].endpoint[1 - pos] = split;
+                        child[0].nIndex[1 - pos] = -1;
+                        child[1].endpoint[pos] = split;
+                        child[1].nIndex[pos] = -1;
                         doTest = 3;
                     }
                     else if (sign0 > 0 || sign1 > 0)
@@ -376,45 +487,31 @@ namespace gte
                     // correct partitioning of the arcs during extremal
                     // queries.
 
-                    int32_t depth;
-
                     if (doTest & 1)
                     {
-                        if (node->posChild != -1)
+                        if (tree[current].posChild != -1)
                         {
-                            candidates.push(node->posChild);
-                            depth = static_cast<int32_t>(candidates.size());
-                            if (depth > mTreeDepth)
-                            {
-                                mTreeDepth = depth;
-                            }
+                            child[0].node = tree[current].posChild;
+                            candidates.push_back(child[0]);
                         }
                         else
                         {
-                            node->posChild = static_cast<int32_t>(mNodes.size());
-                            mNodes.push_back(arc);
-
-                            // The push_back can cause a reallocation, so the
-                            // current pointer must be refreshed.
-                            node = &mNodes[current];
+                            tree[current].posChild = static_cast<int32_t>(tree.size());
+                            tree.push_back(arc);
                         }
                     }
 
                     if (doTest & 2)
                     {
-                        if (node->negChild != -1)
+                        if (tree[current].negChild != -1)
                         {
-                            candidates.push(node->negChild);
-                            depth = static_cast<int32_t>(candidates.size());
-                            if (depth > mTreeDepth)
-                            {
-                                mTreeDepth = depth;
-                            }
+                            child[1].node = tree[current].negChild;
+                            candidates.push_back(child[1]);
                         }
                         else
                         {
-                            node->negChild = static_cast<int32_t>(mNodes.size());
-                            mNodes.push_back(arc);
+                            tree[current].negChild = static_cast<int32_t>(tree.size());
+                            tree.push_back(arc);
                         }
                     }
                 }
@@ -422,17 +519,55 @@ namespace gte
             else
             {
                 // root node
-                mNodes.push_back(arc);
+                tree.push_back(arc);
             }
         }
 
-        // Lookup table for indexing into mFaceNormals.
-        std::map<Triangle*, int32_t> mTriToNormal;
+        // Copy the tree to the query nodes in depth-first order, so the
+        // positive child of a node immediately follows it in memory. The
+        // tree depth counts the nodes on the longest path and the leaf at
+        // its end.
+        void Flatten(std::vector<SphericalArc> const& tree)
+        {
+            mNodes.resize(tree.size());
+            mTreeDepth = 0;
+
+            // Each stack element is {node, 2 * parent + childIndex, depth}.
+            std::vector<std::array<int32_t, 3>> stack{};
+            stack.push_back({ 0, -1, 1 });
+            int32_t numNodes = 0;
+            while (!stack.empty())
+            {
+                int32_t const current = stack.back()[0];
+                int32_t const parentChild = stack.back()[1];
+                int32_t const depth = stack.back()[2];
+                stack.pop_back();
+                mTreeDepth = std::max(mTreeDepth, depth + 1);
+
+                int32_t const index = numNodes++;
+                if (parentChild >= 0)
+                {
+                    mNodes[parentChild / 2].child[parentChild % 2] = index;
+                }
+
+                SphericalArc const& arc = tree[current];
+                Node& node = mNodes[index];
+                node.normal = arc.normal;
+                node.child[0] = -1 - arc.posVertex;
+                node.child[1] = -1 - arc.negVertex;
+                if (arc.negChild != -1)
+                {
+                    stack.push_back({ arc.negChild, 2 * index + 1, depth + 1 });
+                }
+                if (arc.posChild != -1)
+                {
+                    stack.push_back({ arc.posChild, 2 * index, depth + 1 });
+                }
+            }
+        }
 
         // Fixed-size storage for the BSP nodes.
-        std::vector<SphericalArc> mNodes;
+        std::vector<Node> mNodes;
         int32_t mTreeDepth;
     };
 }
-
-
@@ -0,0 +1,171 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2026
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 8.3.2026.10.18
+
+#pragma once
+
+// A sequence container with the std::vector interface needed by the
+// find-intersection queries, but whose elements are stored in a std::array
+// inside the object. The container never allocates memory, which makes it
+// suitable for query results whose maximum number of elements is small and
+// known at compile time, such as the intersection of two triangles. It is
+// an error to make the size larger than Capacity.
+
+#include <Mathematics/Logger.h>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+
+namespace gte
+{
+    template <typename T, std::size_t Capacity>
+    class FixedCapacityVector
+    {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using reference = T&;
+        using const_reference = T const&;
+        using iterator = T*;
+        using const_iterator = T const*;
+
+        FixedCapacityVector()
+            :
+            mElements{},
+            mSize(0)
+        {
+        }
+
+        FixedCapacityVector(std::initializer_list<T> elements)
+            :
+            mElements{},
+            mSize(0)
+        {
+            LogAssert(
+                elements.size() <= Capacity,
+                "The number of elements exceeds the capacity.");
+
+            for (auto const& element : elements)
+            {
+                mElements[mSize++] = element;
+            }
+        }
+
+        // Member access.
+        inline std::size_t size() const
+        {
+            return mSize;
+        }
+
+        inline static constexpr std::size_t capacity()
+        {
+            return Capacity;
+        }
+
+        inline bool empty() const
+        {
+            return mSize == 0;
+        }
+
+        inline T& operator[](std::size_t i)
+        {
+            return mElements[i];
+        }
+
+        inline T const& operator[](std::size_t i) const
+        {
+            return mElements[i];
+        }
+
+        inline T& front()
+        {
+            return mElements[0];
+        }
+
+        inline T const& front() const
+        {
+            return mElements[0];
+        }
+
+        inline T& back()
+        {
+            return mElements[mSize - 1];
+        }
+
+        inline T const& back() const
+        {
+            return mElements[mSize - 1];
+        }
+
+        inline T* data()
+        {
+            return mElements.data();
+        }
+
+        inline T const* data() const
+        {
+            return mElements.data();
+        }
+
+        inline T* begin()
+        {
+            return mElements.data();
+        }
+
+        inline T const* begin() const
+        {
+            return mElements.data();
+        }
+
+        inline T* end()
+        {
+            return mElements.data() + mSize;
+        }
+
+        inline T const* end() const
+        {
+            return mElements.data() + mSize;
+        }
+
+        // Modification. As for std::vector, resize value-initializes the
+        // new elements.
+        inline void clear()
+        {
+            mSize = 0;
+        }
+
+        void resize(std::size_t size)
+        {
+            LogAssert(
+                size <= Capacity,
+                "The size exceeds the capacity.");
+
+            for (std::size_t i = mSize; i < size; ++i)
+            {
+                mElements[i] = T{};
+            }
+            mSize = size;
+        }
+
+        void push_back(T const& element)
+        {
+            LogAssert(
+                mSize < Capacity,
+                "The container is full.");
+
+            mElements[mSize++] = element;
+        }
+
+        inline void pop_back()
+        {
+            --mSize;
+        }
+
+    private:
+        std::array<T, Capacity> mElements;
+        std::size_t mSize;
+    };
+}
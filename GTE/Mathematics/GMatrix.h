@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2025.05.10
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -13,6 +13,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <thread>
 #include <vector>
 
 namespace gte
@@ -533,6 +534,18 @@ namespace gte
         LogError("Mismatched sizes.");
     }
 
+    // The matrix products are computed by a cache-tiled kernel. The common
+    // dimension is split into blocks of 128 and the columns of the product
+    // into blocks of 256. For each pair of blocks, the entries of the right
+    // operand are packed into a contiguous panel, and each row of the
+    // product is updated by the rows of the panel in a loop over
+    // contiguous columns that the compiler can vectorize. Every entry of
+    // the product is accumulated in increasing order of the common index,
+    // as in the triple loop, so the results are the same as those of the
+    // triple loop for any number of threads. Set numThreads to 0 or 1 to
+    // execute in the main thread. Set numThreads to 2 or larger to
+    // distribute the rows of the product among that many threads.
+
     // A*B
     template <typename Real>
     GMatrix<Real> operator*(GMatrix<Real> const& A, GMatrix<Real> const& B)
@@ -540,101 +553,188 @@ namespace gte
         return MultiplyAB(A, B);
     }
 
-    template <typename Real>
-    GMatrix<Real> MultiplyAB(GMatrix<Real> const& A, GMatrix<Real> const& B)
+    // Support for the matrix products. The product P = L*R is computed,
+    // where L(r,k) is left(r,k) and R(k,c) is right(k,c). If upperOnly is
+    // true, P is symmetric and only the entries P(r,c) with r <= c are
+    // computed; the others are copied from them.
+    template <typename Real, typename Left, typename Right>
+    GMatrix<Real> MultiplyTiled(int32_t numRows, int32_t numCols,
+        int32_t numCommon, Left const& left, Right const& right,
+        bool upperOnly, std::size_t numThreads)
     {
-        if (A.GetNumCols() == B.GetNumRows())
+        std::size_t constexpr kBlockSize = 128;
+        std::size_t constexpr cBlockSize = 256;
+        std::size_t const numR = static_cast<std::size_t>(numRows);
+        std::size_t const numC = static_cast<std::size_t>(numCols);
+        std::size_t const numK = static_cast<std::size_t>(numCommon);
+        std::vector<Real> product(numR * numC, (Real)0);
+
+        // Pack the right operand once, before the threads are launched.
+        // The panel for the blocks [k0,k1) and [c0,c1) starts at index
+        // k0 * numC + (k1 - k0) * c0 and stores R(k,c) at relative index
+        // (k - k0) * (c1 - c0) + (c - c0).
+        std::vector<Real> panels(numK * numC);
+        for (std::size_t k0 = 0; k0 < numK; k0 += kBlockSize)
+        {
+            std::size_t const k1 = std::min(k0 + kBlockSize, numK);
+            for (std::size_t c0 = 0; c0 < numC; c0 += cBlockSize)
+            {
+                std::size_t const c1 = std::min(c0 + cBlockSize, numC);
+                std::size_t const width = c1 - c0;
+                Real* panel = &panels[k0 * numC + (k1 - k0) * c0];
+                for (std::size_t k = k0; k < k1; ++k)
+                {
+                    for (std::size_t c = c0; c < c1; ++c)
+                    {
+                        panel[(k - k0) * width + (c - c0)] =
+                            right(static_cast<int32_t>(k), static_cast<int32_t>(c));
+                    }
+                }
+            }
+        }
+
+        auto multiply = [&](std::size_t t, std::size_t numT)
         {
-            GMatrix<Real> result(A.GetNumRows(), B.GetNumCols());
-            int32_t const numCommon = A.GetNumCols();
-            for (int32_t r = 0; r < result.GetNumRows(); ++r)
+            for (std::size_t k0 = 0; k0 < numK; k0 += kBlockSize)
             {
-                for (int32_t c = 0; c < result.GetNumCols(); ++c)
+                std::size_t const k1 = std::min(k0 + kBlockSize, numK);
+                for (std::size_t c0 = 0; c0 < numC; c0 += cBlockSize)
                 {
-                    result(r, c) = (Real)0;
-                    for (int32_t i = 0; i < numCommon; ++i)
+                    std::size_t const c1 = std::min(c0 + cBlockSize, numC);
+                    std::size_t const width = c1 - c0;
+                    Real const* panel = &panels[k0 * numC + (k1 - k0) * c0];
+                    std::size_t const rSup = (upperOnly ? std::min(c1, numR) : numR);
+                    for (std::size_t r = t; r < rSup; r += numT)
                     {
-                        result(r, c) += A(r, i) * B(i, c);
+                        std::size_t const cMin = (upperOnly ? std::max(c0, r) : c0);
+                        Real* row = &product[r * numC + c0];
+                        for (std::size_t k = k0; k < k1; ++k)
+                        {
+                            Real const value = left(static_cast<int32_t>(r), static_cast<int32_t>(k));
+                            Real const* source = &panel[(k - k0) * width];
+                            for (std::size_t c = cMin - c0; c < width; ++c)
+                            {
+                                row[c] += value * source[c];
+                            }
+                        }
                     }
                 }
             }
-            return result;
+        };
+
+        numThreads = std::min(numThreads, numR);
+        if (numThreads <= 1)
+        {
+            multiply(0, 1);
+        }
+        else
+        {
+            // The rows are interleaved among the threads, which balances
+            // the work when only the upper-triangular part is computed.
+            std::vector<std::thread> process(numThreads);
+            for (std::size_t t = 0; t < numThreads; ++t)
+            {
+                process[t] = std::thread(multiply, t, numThreads);
+            }
+            for (std::size_t t = 0; t < numThreads; ++t)
+            {
+                process[t].join();
+            }
+        }
+
+        GMatrix<Real> result(numRows, numCols);
+        for (int32_t r = 0; r < numRows; ++r)
+        {
+            Real const* row = &product[static_cast<std::size_t>(r) * numC];
+            for (int32_t c = 0; c < numCols; ++c)
+            {
+                result(r, c) = (upperOnly && c < r ? result(c, r) : row[c]);
+            }
+        }
+        return result;
+    }
+
+    template <typename Real>
+    GMatrix<Real> MultiplyAB(GMatrix<Real> const& A, GMatrix<Real> const& B,
+        std::size_t numThreads = 0)
+    {
+        if (A.GetNumCols() == B.GetNumRows())
+        {
+            return MultiplyTiled<Real>(A.GetNumRows(), B.GetNumCols(), A.GetNumCols(),
+                [&A](int32_t r, int32_t i) { return A(r, i); },
+                [&B](int32_t i, int32_t c) { return B(i, c); },
+                false, numThreads);
         }
         LogError("Mismatched sizes.");
     }
 
     // A*B^T
     template <typename Real>
-    GMatrix<Real> MultiplyABT(GMatrix<Real> const& A, GMatrix<Real> const& B)
+    GMatrix<Real> MultiplyABT(GMatrix<Real> const& A, GMatrix<Real> const& B,
+        std::size_t numThreads = 0)
     {
         if (A.GetNumCols() == B.GetNumCols())
         {
-            GMatrix<Real> result(A.GetNumRows(), B.GetNumRows());
-            int32_t const numCommon = A.GetNumCols();
-            for (int32_t r = 0; r < result.GetNumRows(); ++r)
-            {
-                for (int32_t c = 0; c < result.GetNumCols(); ++c)
-                {
-                    result(r, c) = (Real)0;
-                    for (int32_t i = 0; i < numCommon; ++i)
-                    {
-                        result(r, c) += A(r, i) * B(c, i);
-                    }
-                }
-            }
-            return result;
+            return MultiplyTiled<Real>(A.GetNumRows(), B.GetNumRows(), A.GetNumCols(),
+                [&A](int32_t r, int32_t i) { return A(r, i); },
+                [&B](int32_t i, int32_t c) { return B(c, i); },
+                false, numThreads);
         }
         LogError("Mismatched sizes.");
     }
 
     // A^T*B
     template <typename Real>
-    GMatrix<Real> MultiplyATB(GMatrix<Real> const& A, GMatrix<Real> const& B)
+    GMatrix<Real> MultiplyATB(GMatrix<Real> const& A, GMatrix<Real> const& B,
+        std::size_t numThreads = 0)
     {
         if (A.GetNumRows() == B.GetNumRows())
         {
-            GMatrix<Real> result(A.GetNumCols(), B.GetNumCols());
-            int32_t const numCommon = A.GetNumRows();
-            for (int32_t r = 0; r < result.GetNumRows(); ++r)
-            {
-                for (int32_t c = 0; c < result.GetNumCols(); ++c)
-                {
-                    result(r, c) = (Real)0;
-                    for (int32_t i = 0; i < numCommon; ++i)
-                    {
-                        result(r, c) += A(i, r) * B(i, c);
-                    }
-                }
-            }
-            return result;
+            return MultiplyTiled<Real>(A.GetNumCols(), B.GetNumCols(), A.GetNumRows(),
+                [&A](int32_t r, int32_t i) { return A(i, r); },
+                [&B](int32_t i, int32_t c) { return B(i, c); },
+                false, numThreads);
         }
         LogError("Mismatched sizes.");
     }
 
     // A^T*B^T
     template <typename Real>
-    GMatrix<Real> MultiplyATBT(GMatrix<Real> const& A, GMatrix<Real> const& B)
+    GMatrix<Real> MultiplyATBT(GMatrix<Real> const& A, GMatrix<Real> const& B,
+        std::size_t numThreads = 0)
     {
         if (A.GetNumRows() == B.GetNumCols())
         {
-            GMatrix<Real> result(A.GetNumCols(), B.GetNumRows());
-            int32_t const numCommon = A.GetNumRows();
-            for (int32_t r = 0; r < result.GetNumRows(); ++r)
-            {
-                for (int32_t c = 0; c < result.GetNumCols(); ++c)
-                {
-                    result(r, c) = (Real)0;
-                    for (int32_t i = 0; i < numCommon; ++i)
-                    {
-                        result(r, c) += A(i, r) * B(c, i);
-                    }
-                }
-            }
-            return result;
+            return MultiplyTiled<Real>(A.GetNumCols(), B.GetNumRows(), A.GetNumRows(),
+                [&A](int32_t r, int32_t i) { return A(i, r); },
+                [&B](int32_t i, int32_t c) { return B(c, i); },
+                false, numThreads);
         }
         LogError("Mismatched sizes.");
     }
 
+    // A^T*A, which is symmetric. Only the upper-triangular part is
+    // computed, which halves the work of MultiplyATB(A, A).
+    template <typename Real>
+    GMatrix<Real> MultiplyATA(GMatrix<Real> const& A, std::size_t numThreads = 0)
+    {
+        return MultiplyTiled<Real>(A.GetNumCols(), A.GetNumCols(), A.GetNumRows(),
+            [&A](int32_t r, int32_t i) { return A(i, r); },
+            [&A](int32_t i, int32_t c) { return A(i, c); },
+            true, numThreads);
+    }
+
+    // A*A^T, which is symmetric. Only the upper-triangular part is
+    // computed, which halves the work of MultiplyABT(A, A).
+    template <typename Real>
+    GMatrix<Real> MultiplyAAT(GMatrix<Real> const& A, std::size_t numThreads = 0)
+    {
+        return MultiplyTiled<Real>(A.GetNumRows(), A.GetNumRows(), A.GetNumCols(),
+            [&A](int32_t r, int32_t i) { return A(r, i); },
+            [&A](int32_t i, int32_t c) { return A(c, i); },
+            true, numThreads);
+    }
+
     // M*D, D is square diagonal (stored as vector)
     template <typename Real>
     GMatrix<Real> MultiplyMD(GMatrix<Real> const& M, GVector<Real> const& D)
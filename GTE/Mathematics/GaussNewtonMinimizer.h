@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2025.05.10
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -46,13 +46,23 @@
 // advantage; for example, 3-tuples of components of F(p) might correspond to
 // vectors that can be manipulated using an already existing mathematics
 // library.  The implementation here supports both approaches.
+//
+// When both n and m are large, as in bundle adjustment, J is typically
+// sparse because each component of F depends on only a few parameters. The
+// class SparseJacobian supports this case. The components of F and the
+// blocks of J are computed per observation, possibly in parallel, and the
+// normal equations are assembled in sparse form and solved by the
+// preconditioned conjugate gradient method.
 
 #include <Mathematics/CholeskyDecomposition.h>
+#include <Mathematics/SparseJacobian.h>
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <functional>
+#include <utility>
+#include <vector>
 
 namespace gte
 {
@@ -84,7 +94,10 @@ namespace gte
             mJTJ(mNumPDimensions, mNumPDimensions),
             mNegJTF(mNumPDimensions),
             mDecomposer(mNumPDimensions),
-            mUseJFunction(true)
+            mUseJFunction(true),
+            mSparseJacobian(nullptr),
+            mSparseF{},
+            mSparseFNext{}
         {
             LogAssert(mNumPDimensions > 0 && mNumFDimensions > 0, "Invalid dimensions.");
         }
@@ -102,11 +115,33 @@ namespace gte
             mJTJ(mNumPDimensions, mNumPDimensions),
             mNegJTF(mNumPDimensions),
             mDecomposer(mNumPDimensions),
-            mUseJFunction(false)
+            mUseJFunction(false),
+            mSparseJacobian(nullptr),
+            mSparseF{},
+            mSparseFNext{}
         {
             LogAssert(mNumPDimensions > 0 && mNumFDimensions > 0, "Invalid dimensions.");
         }
 
+        // Create the minimizer for a sparse Jacobian matrix. The dense
+        // matrices J(p) and J^T(p)*J(p) are not stored. The object
+        // 'jacobian' must exist during the lifetime of the minimizer.
+        GaussNewtonMinimizer(SparseJacobian<T>& jacobian)
+            :
+            mNumPDimensions(jacobian.GetNumPDimensions()),
+            mNumFDimensions(jacobian.GetNumFDimensions()),
+            mF(0),
+            mJ(0, 0),
+            mJTJ(0, 0),
+            mNegJTF(mNumPDimensions),
+            mDecomposer(mNumPDimensions),
+            mUseJFunction(false),
+            mSparseJacobian(&jacobian),
+            mSparseF{},
+            mSparseFNext{}
+        {
+        }
+
         // Disallow copy, assignment and move semantics.
         GaussNewtonMinimizer(GaussNewtonMinimizer const&) = delete;
         GaussNewtonMinimizer& operator=(GaussNewtonMinimizer const&) = delete;
@@ -132,7 +167,10 @@ namespace gte
                 minErrorDifference(static_cast<T>(0)),
                 minUpdateLength(static_cast<T>(0)),
                 numIterations(0),
-                converged(false)
+                converged(false),
+                numFEvaluations(0),
+                numJEvaluations(0),
+                numSolverIterations(0)
             {
                 minLocation.MakeZero();
             }
@@ -143,6 +181,15 @@ namespace gte
             T minUpdateLength;
             size_t numIterations;
             bool converged;
+
+            // Statistics for profiling. The numbers of evaluations of F(p)
+            // and of J(p) (or of the J^T(p)*J(p) and -J^T(p)*F(p) of the
+            // JPlusFunction) are counted. For a sparse Jacobian matrix,
+            // numSolverIterations is the total number of conjugate gradient
+            // iterations; otherwise, it is 0.
+            size_t numFEvaluations;
+            size_t numJEvaluations;
+            size_t numSolverIterations;
         };
 
         Result operator()(DVector const& p0, size_t maxIterations,
@@ -161,28 +208,36 @@ namespace gte
             errorDifferenceTolerance = std::max(errorDifferenceTolerance, (T)0);
 
             // Compute the initial error.
-            mFFunction(p0, mF);
-            result.minError = Dot(mF, mF);
+            result.minError = ComputeError(p0, mSparseF, result);
 
             // Do the Gauss-Newton iterations.
             auto pCurrent = p0;
             for (result.numIterations = 1; result.numIterations <= maxIterations; ++result.numIterations)
             {
-                ComputeLinearSystemInputs(pCurrent);
-                if (!mDecomposer.Factor(mJTJ))
+                ++result.numJEvaluations;
+                if (mSparseJacobian)
                 {
-                    // TODO: The matrix mJTJ is positive semi-definite, so the
-                    // failure can occur when mJTJ has a zero eigenvalue in
-                    // which case mJTJ is not invertible.  Generate an iterate
-                    // anyway, perhaps using gradient descent?
-                    return result;
+                    mSparseJacobian->EvaluateNormalEquations(pCurrent, mSparseF);
+                    result.numSolverIterations += mSparseJacobian->Solve((T)0, mNegJTF);
+                }
+                else
+                {
+                    ComputeLinearSystemInputs(pCurrent);
+                    if (!mDecomposer.Factor(mJTJ))
+                    {
+                        // TODO: The matrix mJTJ is positive semi-definite, so
+                        // the failure can occur when mJTJ has a zero
+                        // eigenvalue in which case mJTJ is not invertible.
+                        // Generate an iterate anyway, perhaps using gradient
+                        // descent?
+                        return result;
+                    }
+                    mDecomposer.SolveLower(mJTJ, mNegJTF);
+                    mDecomposer.SolveUpper(mJTJ, mNegJTF);
                 }
-                mDecomposer.SolveLower(mJTJ, mNegJTF);
-                mDecomposer.SolveUpper(mJTJ, mNegJTF);
 
                 auto pNext = pCurrent + mNegJTF;
-                mFFunction(pNext, mF);
-                T error = Dot(mF, mF);
+                T error = ComputeError(pNext, mSparseFNext, result);
                 if (error < result.minError)
                 {
                     result.minErrorDifference = result.minError - error;
@@ -198,18 +253,33 @@ namespace gte
                 }
 
                 pCurrent = pNext;
+                std::swap(mSparseF, mSparseFNext);
             }
 
             return result;
         }
 
     private:
+        T ComputeError(DVector const& p, std::vector<T>& sparseF, Result& result)
+        {
+            ++result.numFEvaluations;
+            if (mSparseJacobian)
+            {
+                return mSparseJacobian->EvaluateF(p, sparseF);
+            }
+            else
+            {
+                mFFunction(p, mF);
+                return Dot(mF, mF);
+            }
+        }
+
         void ComputeLinearSystemInputs(DVector const& pCurrent)
         {
             if (mUseJFunction)
             {
                 mJFunction(pCurrent, mJ);
-                mJTJ = MultiplyATB(mJ, mJ);
+                mJTJ = MultiplyATA(mJ);
                 mNegJTF = -(mF * mJ);
             }
             else
@@ -232,6 +302,11 @@ namespace gte
         CholeskyDecomposition<T> mDecomposer;
 
         bool mUseJFunction;
+
+        // Support for a sparse Jacobian matrix. The members mSparseF and
+        // mSparseFNext store F(p) for the current and the next iterates.
+        SparseJacobian<T>* mSparseJacobian;
+        std::vector<T> mSparseF, mSparseFNext;
     };
 }
 
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2025.11.24
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -16,6 +16,11 @@
 // and X.  If you want to solve M*Y = C for Y, where X and C are NxK, pass
 // nonnull pointers for C and Y and pass K to numCols.  In all cases, pass
 // N to numRows.
+//
+// GaussianElimination::operator() factors M for each call. To solve systems
+// with the same M for many right-hand sides, use
+// GaussianElimination::LUFactorization, which factors M once and then
+// solves for any number of right-hand sides.
 
 #include <Mathematics/Logger.h>
 #include <Mathematics/LexicoArray2.h>
@@ -24,6 +29,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <thread>
 #include <vector>
 
 namespace gte
@@ -233,6 +239,333 @@ namespace gte
             return true;
         }
 
+        // The factorization P*M = L*U with partial pivoting, where P is a
+        // permutation matrix, L is lower triangular with unit diagonal and
+        // U is upper triangular. The storage conventions for M and for the
+        // right-hand sides are the same as for operator(). The
+        // factorization is blocked: the columns are processed in panels of
+        // 64, each panel is factored with the row exchanges for the pivots,
+        // and the trailing submatrix is updated by the panel in loops over
+        // contiguous row entries. The rows of the trailing submatrix are
+        // distributed among the threads, and the columns of the
+        // right-hand sides are distributed among the threads in Solve.
+        // The results are the same for any number of threads. Set
+        // numThreads to 0 or 1 to execute in the main thread. Set
+        // numThreads to 2 or larger to use that many threads.
+        class LUFactorization
+        {
+        public:
+            LUFactorization(std::size_t numThreads = 0)
+                :
+                mNumThreads(numThreads),
+                mSize(0),
+                mLU{},
+                mPivots{},
+                mOddPermutation(false),
+                mInvertible(false)
+            {
+            }
+
+            // Factor the NxN matrix M, where N is numRows. The function
+            // returns false when M is not invertible, in which case Solve
+            // must not be called. The factorization can be computed again
+            // for another matrix, possibly of different size.
+            bool Factor(int32_t numRows, Real const* M)
+            {
+                LogAssert(
+                    numRows > 0 && M != nullptr,
+                    "Invalid input.");
+
+                std::size_t const N = static_cast<std::size_t>(numRows);
+                mSize = numRows;
+                mLU.resize(N * N);
+                mPivots.resize(N);
+                mOddPermutation = false;
+                mInvertible = false;
+
+                // The factorization is computed in row-major order.
+#if defined(GTE_USE_COL_MAJOR)
+                LexicoArray2<false, Real const> matM(numRows, numRows, M);
+#else
+                LexicoArray2<true, Real const> matM(numRows, numRows, M);
+#endif
+                for (int32_t r = 0, i = 0; r < numRows; ++r)
+                {
+                    for (int32_t c = 0; c < numRows; ++c, ++i)
+                    {
+                        mLU[i] = matM(r, c);
+                    }
+                }
+
+                Real const zero = static_cast<Real>(0);
+                Real* LU = mLU.data();
+                for (std::size_t k0 = 0; k0 < N; k0 += blockSize)
+                {
+                    std::size_t const k1 = std::min(k0 + blockSize, N);
+
+                    // Factor the panel of columns [k0,k1) and rows [k0,N).
+                    // The row exchanges are applied to entire rows.
+                    for (std::size_t j = k0; j < k1; ++j)
+                    {
+                        std::size_t pivot = j;
+                        Real maxValue = zero;
+                        for (std::size_t i = j; i < N; ++i)
+                        {
+                            Real const value = LU[i * N + j];
+                            Real const absValue = (value >= zero ? value : -value);
+                            if (absValue > maxValue)
+                            {
+                                maxValue = absValue;
+                                pivot = i;
+                            }
+                        }
+
+                        if (maxValue == zero)
+                        {
+                            // The matrix is not invertible.
+                            return false;
+                        }
+
+                        mPivots[j] = static_cast<int32_t>(pivot);
+                        if (pivot != j)
+                        {
+                            mOddPermutation = !mOddPermutation;
+                            std::swap_ranges(LU + j * N, LU + (j + 1) * N, LU + pivot * N);
+                        }
+
+                        Real const* rowJ = LU + j * N;
+                        Real const diagonal = rowJ[j];
+                        for (std::size_t i = j + 1; i < N; ++i)
+                        {
+                            Real* rowI = LU + i * N;
+                            rowI[j] /= diagonal;
+                            Real const multiplier = rowI[j];
+                            for (std::size_t c = j + 1; c < k1; ++c)
+                            {
+                                rowI[c] -= multiplier * rowJ[c];
+                            }
+                        }
+                    }
+
+                    if (k1 < N)
+                    {
+                        // Compute the block row U(k0:k1,k1:N) by forward
+                        // substitution with the unit lower-triangular
+                        // L(k0:k1,k0:k1).
+                        for (std::size_t i = k0 + 1; i < k1; ++i)
+                        {
+                            Real* rowI = LU + i * N;
+                            for (std::size_t p = k0; p < i; ++p)
+                            {
+                                Real const multiplier = rowI[p];
+                                Real const* rowP = LU + p * N;
+                                for (std::size_t c = k1; c < N; ++c)
+                                {
+                                    rowI[c] -= multiplier * rowP[c];
+                                }
+                            }
+                        }
+
+                        // Update the trailing submatrix,
+                        // A(k1:N,k1:N) -= L(k1:N,k0:k1) * U(k0:k1,k1:N). The
+                        // columns are processed in tiles so that the tile of
+                        // U remains in cache while the rows are updated.
+                        Execute(N - k1, [LU, N, k0, k1](std::size_t iMin, std::size_t iSup)
+                        {
+                            for (std::size_t c0 = k1; c0 < N; c0 += tileSize)
+                            {
+                                std::size_t const c1 = std::min(c0 + tileSize, N);
+                                for (std::size_t i = k1 + iMin; i < k1 + iSup; ++i)
+                                {
+                                    Real* rowI = LU + i * N;
+                                    for (std::size_t p = k0; p < k1; ++p)
+                                    {
+                                        Real const multiplier = rowI[p];
+                                        Real const* rowP = LU + p * N;
+                                        for (std::size_t c = c0; c < c1; ++c)
+                                        {
+                                            rowI[c] -= multiplier * rowP[c];
+                                        }
+                                    }
+                                }
+                            }
+                        });
+                    }
+                }
+
+                mInvertible = true;
+                return true;
+            }
+
+            // Solve M*Y = C, where C and Y are NxK and K is numCols. The
+            // pointers C and Y may be equal, in which case C is overwritten
+            // by the solution.
+            void Solve(int32_t numCols, Real const* C, Real* Y) const
+            {
+                LogAssert(
+                    mInvertible,
+                    "The matrix is not factored or is not invertible.");
+                LogAssert(
+                    numCols > 0 && C != nullptr && Y != nullptr,
+                    "Invalid input.");
+
+                int32_t const numRows = mSize;
+                if (C != Y)
+                {
+                    std::copy(C, C + static_cast<std::size_t>(numRows) * numCols, Y);
+                }
+
+#if defined(GTE_USE_COL_MAJOR)
+                LexicoArray2<false, Real> matY(numRows, numCols, Y);
+#else
+                LexicoArray2<true, Real> matY(numRows, numCols, Y);
+#endif
+                std::size_t const N = static_cast<std::size_t>(numRows);
+                Real const* LU = mLU.data();
+                int32_t const* pivots = mPivots.data();
+                Execute(static_cast<std::size_t>(numCols),
+                    [&matY, LU, N, pivots](std::size_t cMin, std::size_t cSup)
+                {
+                    int32_t const c0 = static_cast<int32_t>(cMin);
+                    int32_t const c1 = static_cast<int32_t>(cSup);
+
+                    // Apply the row exchanges, Y = P*C.
+                    for (std::size_t i = 0; i < N; ++i)
+                    {
+                        int32_t const r = static_cast<int32_t>(i);
+                        int32_t const p = pivots[i];
+                        if (p != r)
+                        {
+                            for (int32_t c = c0; c < c1; ++c)
+                            {
+                                std::swap(matY(r, c), matY(p, c));
+                            }
+                        }
+                    }
+
+                    // Solve L*Z = P*C.
+                    for (std::size_t i = 1; i < N; ++i)
+                    {
+                        int32_t const r = static_cast<int32_t>(i);
+                        Real const* rowI = LU + i * N;
+                        for (std::size_t p = 0; p < i; ++p)
+                        {
+                            Real const multiplier = rowI[p];
+                            int32_t const q = static_cast<int32_t>(p);
+                            for (int32_t c = c0; c < c1; ++c)
+                            {
+                                matY(r, c) -= multiplier * matY(q, c);
+                            }
+                        }
+                    }
+
+                    // Solve U*Y = Z.
+                    for (std::size_t i = N; i-- > 0; )
+                    {
+                        int32_t const r = static_cast<int32_t>(i);
+                        Real const* rowI = LU + i * N;
+                        for (std::size_t p = i + 1; p < N; ++p)
+                        {
+                            Real const multiplier = rowI[p];
+                            int32_t const q = static_cast<int32_t>(p);
+                            for (int32_t c = c0; c < c1; ++c)
+                            {
+                                matY(r, c) -= multiplier * matY(q, c);
+                            }
+                        }
+                        Real const diagonal = rowI[i];
+                        for (int32_t c = c0; c < c1; ++c)
+                        {
+                            matY(r, c) /= diagonal;
+                        }
+                    }
+                });
+            }
+
+            // Solve M*X = B, where B and X are Nx1.
+            inline void Solve(Real const* B, Real* X) const
+            {
+                Solve(1, B, X);
+            }
+
+            // The determinant of M, which is 0 when M is not invertible.
+            Real GetDeterminant() const
+            {
+                if (!mInvertible)
+                {
+                    return static_cast<Real>(0);
+                }
+
+                std::size_t const N = static_cast<std::size_t>(mSize);
+                Real determinant = static_cast<Real>(1);
+                for (std::size_t i = 0; i < N; ++i)
+                {
+                    determinant *= mLU[i * N + i];
+                }
+                return (mOddPermutation ? -determinant : determinant);
+            }
+
+            inline int32_t GetSize() const
+            {
+                return mSize;
+            }
+
+            inline bool IsInvertible() const
+            {
+                return mInvertible;
+            }
+
+            // The factors L and U are stored in row-major order in one NxN
+            // array, L below the diagonal and U on and above the diagonal.
+            // Row i was exchanged with row GetPivots()[i] >= i at step i of
+            // the elimination.
+            inline std::vector<Real> const& GetLU() const
+            {
+                return mLU;
+            }
+
+            inline std::vector<int32_t> const& GetPivots() const
+            {
+                return mPivots;
+            }
+
+        private:
+            static std::size_t constexpr blockSize = 64;
+            static std::size_t constexpr tileSize = 256;
+
+            // Process [0,numItems) by calls function(iMin,iSup), each
+            // thread processing a contiguous range of items.
+            template <typename Function>
+            void Execute(std::size_t numItems, Function const& function) const
+            {
+                std::size_t const numThreads = std::min(mNumThreads, numItems);
+                if (numThreads <= 1)
+                {
+                    function(0, numItems);
+                }
+                else
+                {
+                    std::vector<std::thread> process(numThreads);
+                    for (std::size_t t = 0; t < numThreads; ++t)
+                    {
+                        std::size_t const iMin = t * numItems / numThreads;
+                        std::size_t const iSup = (t + 1) * numItems / numThreads;
+                        process[t] = std::thread(function, iMin, iSup);
+                    }
+                    for (std::size_t t = 0; t < numThreads; ++t)
+                    {
+                        process[t].join();
+                    }
+                }
+            }
+
+            std::size_t mNumThreads;
+            int32_t mSize;
+            std::vector<Real> mLU;
+            std::vector<int32_t> mPivots;
+            bool mOddPermutation, mInvertible;
+        };
+
     private:
         // Support for copying source to target or to set target to zero.  If
         // source is nullptr, then target is set to zero; otherwise source is
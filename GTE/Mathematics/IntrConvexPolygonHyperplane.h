@@ -3,28 +3,37 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2025.05.10
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
 // The intersection queries are based on the document
 // https://www.geometrictools.com/Documentation/ClipConvexPolygonByHyperplane.pdf
+//
+// The polygon is stored in a std::vector or in a FixedCapacityVector, and
+// the find-intersection query stores its output polygons in the same type of
+// container as the input polygon. With FixedCapacityVector<Vector<N, Real>,
+// Capacity>, the queries do not allocate memory. The split of a polygon
+// with n vertices can have n+1 vertices, so Capacity must be larger than the
+// number of vertices of the input polygon.
 
 #include <Mathematics/TIQuery.h>
 #include <Mathematics/FIQuery.h>
+#include <Mathematics/FixedCapacityVector.h>
 #include <Mathematics/Hyperplane.h>
 #include <Mathematics/Vector.h>
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
-#include <list>
 #include <vector>
 
 namespace gte
 {
-    template <int32_t N, typename Real>
-    class TIQuery<Real, std::vector<Vector<N, Real>>, Hyperplane<N, Real>>
+    // The implementation of the test-intersection query for a container
+    // type Polygon of Vector<N, Real> elements.
+    template <int32_t N, typename Real, typename Polygon>
+    class TIQueryConvexPolygonHyperplane
     {
     public:
         enum class Configuration
@@ -53,7 +62,7 @@ namespace gte
             Configuration configuration;
         };
 
-        Result operator()(std::vector<Vector<N, Real>> const& polygon, Hyperplane<N, Real> const& hyperplane)
+        Result operator()(Polygon const& polygon, Hyperplane<N, Real> const& hyperplane)
         {
             Result result{};
 
@@ -137,8 +146,11 @@ namespace gte
         }
     };
 
-    template <int32_t N, typename Real>
-    class FIQuery<Real, std::vector<Vector<N, Real>>, Hyperplane<N, Real>>
+    // The implementation of the find-intersection query for a container
+    // type Polygon of Vector<N, Real> elements. The container type Heights
+    // of Real elements stores the signed heights of the vertices.
+    template <int32_t N, typename Real, typename Polygon, typename Heights>
+    class FIQueryConvexPolygonHyperplane
     {
     public:
         enum class Configuration
@@ -168,20 +180,20 @@ namespace gte
             // The intersection is either empty, a single vertex, a single
             // edge or the polygon is contained by the hyperplane.
             Configuration configuration;
-            std::vector<Vector<N, Real>> intersection;
+            Polygon intersection;
 
             // If 'configuration' is POSITIVE_* or SPLIT, this polygon is the
             // portion of the query input 'polygon' on the positive side of
             // the hyperplane with possibly a vertex or edge on the hyperplane.
-            std::vector<Vector<N, Real>> positivePolygon;
+            Polygon positivePolygon;
 
             // If 'configuration' is NEGATIVE_* or SPLIT, this polygon is the
             // portion of the query input 'polygon' on the negative side of
             // the hyperplane with possibly a vertex or edge on the hyperplane.
-            std::vector<Vector<N, Real>> negativePolygon;
+            Polygon negativePolygon;
         };
 
-        Result operator()(std::vector<Vector<N, Real>> const& polygon, Hyperplane<N, Real> const& hyperplane)
+        Result operator()(Polygon const& polygon, Hyperplane<N, Real> const& hyperplane)
         {
             Result result{};
 
@@ -200,11 +212,12 @@ namespace gte
             // vertex on the negative side of the hyperplane that is farthest
             // from the hyperplane.  If one or the other such vertex does not
             // exist, the corresponding index will remain its initial value of
-            // max(size_t).
-            std::vector<Real> height(numVertices);
-            std::vector<size_t> zeroHeightIndices;
-            zeroHeightIndices.reserve(numVertices);
-            size_t numPositive = 0, numNegative = 0;
+            // max(size_t). The indices of the first two vertices on the
+            // hyperplane are stored in zeroIndex0 and zeroIndex1.
+            Heights height{};
+            height.resize(numVertices);
+            size_t numPositive = 0, numNegative = 0, numZero = 0;
+            size_t zeroIndex0 = 0, zeroIndex1 = 0;
             Real maxPosHeight = -std::numeric_limits<Real>::max();
             Real maxNegHeight = std::numeric_limits<Real>::max();
             size_t maxPosIndex = std::numeric_limits<size_t>::max();
@@ -232,7 +245,15 @@ namespace gte
                 }
                 else
                 {
-                    zeroHeightIndices.push_back(i);
+                    if (numZero == 0)
+                    {
+                        zeroIndex0 = i;
+                    }
+                    else if (numZero == 1)
+                    {
+                        zeroIndex1 = i;
+                    }
+                    ++numZero;
                 }
             }
 
@@ -261,7 +282,6 @@ namespace gte
                 }
                 else
                 {
-                    size_t numZero = zeroHeightIndices.size();
                     if (numZero == 0)
                     {
                         result.configuration = Configuration::POSITIVE_SIDE_STRICT;
@@ -269,26 +289,19 @@ namespace gte
                     else if (numZero == 1)
                     {
                         result.configuration = Configuration::POSITIVE_SIDE_VERTEX;
-                        result.intersection =
-                        {
-                            polygon[zeroHeightIndices[0]]
-                        };
+                        result.intersection.push_back(polygon[zeroIndex0]);
                     }
                     else // numZero > 1
                     {
                         result.configuration = Configuration::POSITIVE_SIDE_EDGE;
-                        result.intersection =
-                        {
-                            polygon[zeroHeightIndices[0]],
-                            polygon[zeroHeightIndices[1]]
-                        };
+                        result.intersection.push_back(polygon[zeroIndex0]);
+                        result.intersection.push_back(polygon[zeroIndex1]);
                     }
                     result.positivePolygon = polygon;
                 }
             }
             else if (numNegative > 0)
             {
-                size_t numZero = zeroHeightIndices.size();
                 if (numZero == 0)
                 {
                     result.configuration = Configuration::NEGATIVE_SIDE_STRICT;
@@ -296,19 +309,13 @@ namespace gte
                 else if (numZero == 1)
                 {
                     result.configuration = Configuration::NEGATIVE_SIDE_VERTEX;
-                    result.intersection =
-                    {
-                        polygon[zeroHeightIndices[0]]
-                    };
+                    result.intersection.push_back(polygon[zeroIndex0]);
                 }
                 else  // numZero > 1
                 {
                     result.configuration = Configuration::NEGATIVE_SIDE_EDGE;
-                    result.intersection =
-                    {
-                        polygon[zeroHeightIndices[0]],
-                        polygon[zeroHeightIndices[1]]
-                    };
+                    result.intersection.push_back(polygon[zeroIndex0]);
+                    result.intersection.push_back(polygon[zeroIndex1]);
                 }
                 result.negativePolygon = polygon;
             }
@@ -322,14 +329,14 @@ namespace gte
         }
 
     protected:
-        void SplitPolygon(std::vector<Vector<N, Real>> const& polygon,
-            std::vector<Real> const& height, size_t maxPosIndex, Result& result)
+        void SplitPolygon(Polygon const& polygon, Heights const& height,
+            size_t maxPosIndex, Result& result)
         {
             // Find the largest contiguous subset of indices for which
-            // height[i] >= 0.
+            // height[i] >= 0. The subset is end0, end0+1, ..., end1 modulo
+            // numVertices. The vertices end0prev and end1next are on the
+            // negative side of the hyperplane.
             size_t const numVertices = polygon.size();
-            std::list<Vector<N, Real>> positiveList;
-            positiveList.push_back(polygon[maxPosIndex]);
             size_t end0 = maxPosIndex;
             size_t end0prev = std::numeric_limits<size_t>::max();
             for (size_t i = 0; i < numVertices; ++i)
@@ -337,7 +344,6 @@ namespace gte
                 end0prev = (end0 + numVertices - 1) % numVertices;
                 if (height[end0prev] >= (Real)0)
                 {
-                    positiveList.push_front(polygon[end0prev]);
                     end0 = end0prev;
                 }
                 else
@@ -353,7 +359,6 @@ namespace gte
                 end1next = (end1 + 1) % numVertices;
                 if (height[end1next] >= (Real)0)
                 {
-                    positiveList.push_back(polygon[end1next]);
                     end1 = end1next;
                 }
                 else
@@ -362,62 +367,91 @@ namespace gte
                 }
             }
 
-            size_t index = end1next;
-            std::list<Vector<N, Real>> negativeList;
-            for (size_t i = 0; i < numVertices; ++i)
-            {
-                negativeList.push_back(polygon[index]);
-                index = (index + 1) % numVertices;
-                if (index == end0)
-                {
-                    break;
-                }
-            }
-
-            // Clip the polygon.
-            if (height[end0] > (Real)0)
+            // Clip the polygon. The points V0 and V1 of intersection are
+            // on the edges <end0prev,end0> and <end1,end1next>, or they are
+            // the vertices end0 and end1 when those are on the hyperplane.
+            bool const clip0 = (height[end0] > (Real)0);
+            Vector<N, Real> V0 = polygon[end0];
+            if (clip0)
             {
                 Real t = -height[end0prev] / (height[end0] - height[end0prev]);
                 Real omt = (Real)1 - t;
-                Vector<N, Real> V = omt * polygon[end0prev] + t * polygon[end0];
-                positiveList.push_front(V);
-                negativeList.push_back(V);
-                result.intersection.push_back(V);
-            }
-            else
-            {
-                negativeList.push_back(polygon[end0]);
-                result.intersection.push_back(polygon[end0]);
+                V0 = omt * polygon[end0prev] + t * polygon[end0];
             }
 
-            if (height[end1] > (Real)0)
+            bool const clip1 = (height[end1] > (Real)0);
+            Vector<N, Real> V1 = polygon[end1];
+            if (clip1)
             {
                 Real t = -height[end1next] / (height[end1] - height[end1next]);
                 Real omt = (Real)1 - t;
-                Vector<N, Real> V = omt * polygon[end1next] + t * polygon[end1];
-                positiveList.push_back(V);
-                negativeList.push_front(V);
-                result.intersection.push_back(V);
+                V1 = omt * polygon[end1next] + t * polygon[end1];
+            }
+
+            result.intersection.push_back(V0);
+            result.intersection.push_back(V1);
+
+            // The positive polygon is V0 (when clipped), the vertices end0
+            // through end1, and V1 (when clipped).
+            if (clip0)
+            {
+                result.positivePolygon.push_back(V0);
             }
-            else
+            for (size_t i = end0; ; i = (i + 1) % numVertices)
             {
-                negativeList.push_front(polygon[end1]);
-                result.intersection.push_back(polygon[end1]);
+                result.positivePolygon.push_back(polygon[i]);
+                if (i == end1)
+                {
+                    break;
+                }
             }
-
-            result.positivePolygon.reserve(positiveList.size());
-            for (auto const& p : positiveList)
+            if (clip1)
             {
-                result.positivePolygon.push_back(p);
+                result.positivePolygon.push_back(V1);
             }
 
-            result.negativePolygon.reserve(negativeList.size());
-            for (auto const& p : negativeList)
+            // The negative polygon is V1, the vertices end1next through
+            // end0prev, and V0.
+            result.negativePolygon.push_back(V1);
+            for (size_t i = end1next; ; i = (i + 1) % numVertices)
             {
-                result.negativePolygon.push_back(p);
+                result.negativePolygon.push_back(polygon[i]);
+                if (i == end0prev)
+                {
+                    break;
+                }
             }
+            result.negativePolygon.push_back(V0);
         }
     };
-}
 
+    template <int32_t N, typename Real>
+    class TIQuery<Real, std::vector<Vector<N, Real>>, Hyperplane<N, Real>>
+        :
+        public TIQueryConvexPolygonHyperplane<N, Real, std::vector<Vector<N, Real>>>
+    {
+    };
+
+    template <int32_t N, typename Real, std::size_t Capacity>
+    class TIQuery<Real, FixedCapacityVector<Vector<N, Real>, Capacity>, Hyperplane<N, Real>>
+        :
+        public TIQueryConvexPolygonHyperplane<N, Real, FixedCapacityVector<Vector<N, Real>, Capacity>>
+    {
+    };
 
+    template <int32_t N, typename Real>
+    class FIQuery<Real, std::vector<Vector<N, Real>>, Hyperplane<N, Real>>
+        :
+        public FIQueryConvexPolygonHyperplane<N, Real, std::vector<Vector<N, Real>>,
+            std::vector<Real>>
+    {
+    };
+
+    template <int32_t N, typename Real, std::size_t Capacity>
+    class FIQuery<Real, FixedCapacityVector<Vector<N, Real>, Capacity>, Hyperplane<N, Real>>
+        :
+        public FIQueryConvexPolygonHyperplane<N, Real, FixedCapacityVector<Vector<N, Real>, Capacity>,
+            FixedCapacityVector<Real, Capacity>>
+    {
+    };
+}
@@ -0,0 +1,177 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2026
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 8.3.2026.10.18
+
+#pragma once
+
+// Batch versions of FIQuery<T, Ray3<T>, Triangle3<T>> for one ray and many
+// triangles or many rays and one triangle. Read the comments in
+// TriangleBatch3.h about the storage and the output. The output for element
+// i is consistent with the scalar query applied to the i-th pair: the same
+// arithmetic is used, so the values are equal up to differences in
+// floating-point contraction (fused multiply-add) that the compiler applies
+// to one loop and not the other. Such differences are a few ULPs in the
+// intermediate quantities and can change the classification only for rays
+// that pass within rounding error of a triangle edge or are nearly parallel
+// to the triangle plane. As in the scalar query, a ray parallel to the
+// triangle plane is reported as not intersecting.
+
+#include <Mathematics/IntrRay3Triangle3.h>
+#include <Mathematics/TriangleBatch3.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace gte
+{
+    // Rays stored in structure-of-arrays form. The directions must be unit
+    // length, as for Ray3<T> in the scalar query.
+    template <typename T>
+    class Ray3Batch
+    {
+    public:
+        Ray3Batch()
+            :
+            origin{},
+            direction{}
+        {
+        }
+
+        Ray3Batch(std::vector<Ray3<T>> const& rays)
+            :
+            origin{},
+            direction{}
+        {
+            Set(rays);
+        }
+
+        void Set(std::vector<Ray3<T>> const& rays)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                origin[j].resize(rays.size());
+                direction[j].resize(rays.size());
+            }
+
+            for (std::size_t i = 0; i < rays.size(); ++i)
+            {
+                for (int32_t j = 0; j < 3; ++j)
+                {
+                    origin[j][i] = rays[i].origin[j];
+                    direction[j][i] = rays[i].direction[j];
+                }
+            }
+        }
+
+        inline std::size_t GetNumRays() const
+        {
+            return origin[0].size();
+        }
+
+        // The components origin[j][i] and direction[j][i] are for ray i and
+        // dimension j.
+        std::array<std::vector<T>, 3> origin, direction;
+    };
+
+    template <typename T>
+    class FIQueryRay3Triangle3Batch
+    {
+    public:
+        using Result = TriangleBatch3Result<T>;
+
+        // Intersect one ray with each of the triangles. The result arrays
+        // are indexed by triangle. The function returns the number of
+        // intersected triangles.
+        std::size_t operator()(Ray3<T> const& ray,
+            TriangleBatch3<T> const& triangles, Result& result) const
+        {
+            std::size_t const numTriangles = triangles.GetNumTriangles();
+            result.Resize(numTriangles);
+
+            T const ox = ray.origin[0], oy = ray.origin[1], oz = ray.origin[2];
+            T const dx = ray.direction[0], dy = ray.direction[1], dz = ray.direction[2];
+            T const tmin = static_cast<T>(0);
+            T const tmax = std::numeric_limits<T>::infinity();
+            T const* v0x = triangles.v0[0].data();
+            T const* v0y = triangles.v0[1].data();
+            T const* v0z = triangles.v0[2].data();
+            T const* e1x = triangles.edge1[0].data();
+            T const* e1y = triangles.edge1[1].data();
+            T const* e1z = triangles.edge1[2].data();
+            T const* e2x = triangles.edge2[0].data();
+            T const* e2y = triangles.edge2[1].data();
+            T const* e2z = triangles.edge2[2].data();
+            uint8_t* intersect = result.intersect.data();
+            T* parameter = result.parameter.data();
+            T* bary0 = result.bary[0].data();
+            T* bary1 = result.bary[1].data();
+            T* bary2 = result.bary[2].data();
+
+            std::size_t numIntersections = 0;
+            TriangleBatch3Lanes<T> lanes{};
+            for (std::size_t i0 = 0; i0 < numTriangles; i0 += lanes.size)
+            {
+                std::size_t const numLanes = lanes.GetNumLanes(i0, numTriangles);
+                for (std::size_t k = 0, i = i0; k < numLanes; ++k, ++i)
+                {
+                    lanes.intersect[k] = TriangleBatch3<T>::IntersectLinear(
+                        ox - v0x[i], oy - v0y[i], oz - v0z[i], dx, dy, dz,
+                        e1x[i], e1y[i], e1z[i], e2x[i], e2y[i], e2z[i],
+                        tmin, tmax, lanes.parameter[k], lanes.bary0[k], lanes.bary1[k], lanes.bary2[k]);
+                }
+                numIntersections += lanes.CopyTo(i0, numLanes, intersect, parameter, bary0, bary1, bary2);
+            }
+            return numIntersections;
+        }
+
+        // Intersect each of the rays with one triangle. The result arrays
+        // are indexed by ray. The function returns the number of rays that
+        // intersect the triangle.
+        std::size_t operator()(Ray3Batch<T> const& rays,
+            Triangle3<T> const& triangle, Result& result) const
+        {
+            std::size_t const numRays = rays.GetNumRays();
+            result.Resize(numRays);
+
+            Vector3<T> const edge1 = triangle.v[1] - triangle.v[0];
+            Vector3<T> const edge2 = triangle.v[2] - triangle.v[0];
+            T const v0x = triangle.v[0][0], v0y = triangle.v[0][1], v0z = triangle.v[0][2];
+            T const e1x = edge1[0], e1y = edge1[1], e1z = edge1[2];
+            T const e2x = edge2[0], e2y = edge2[1], e2z = edge2[2];
+            T const tmin = static_cast<T>(0);
+            T const tmax = std::numeric_limits<T>::infinity();
+            T const* ox = rays.origin[0].data();
+            T const* oy = rays.origin[1].data();
+            T const* oz = rays.origin[2].data();
+            T const* dx = rays.direction[0].data();
+            T const* dy = rays.direction[1].data();
+            T const* dz = rays.direction[2].data();
+            uint8_t* intersect = result.intersect.data();
+            T* parameter = result.parameter.data();
+            T* bary0 = result.bary[0].data();
+            T* bary1 = result.bary[1].data();
+            T* bary2 = result.bary[2].data();
+
+            std::size_t numIntersections = 0;
+            TriangleBatch3Lanes<T> lanes{};
+            for (std::size_t i0 = 0; i0 < numRays; i0 += lanes.size)
+            {
+                std::size_t const numLanes = lanes.GetNumLanes(i0, numRays);
+                for (std::size_t k = 0, i = i0; k < numLanes; ++k, ++i)
+                {
+                    lanes.intersect[k] = TriangleBatch3<T>::IntersectLinear(
+                        ox[i] - v0x, oy[i] - v0y, oz[i] - v0z, dx[i], dy[i], dz[i],
+                        e1x, e1y, e1z, e2x, e2y, e2z,
+                        tmin, tmax, lanes.parameter[k], lanes.bary0[k], lanes.bary1[k], lanes.bary2[k]);
+                }
+                numIntersections += lanes.CopyTo(i0, numLanes, intersect, parameter, bary0, bary1, bary2);
+            }
+            return numIntersections;
+        }
+    };
+}
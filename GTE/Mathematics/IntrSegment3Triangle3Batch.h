@@ -0,0 +1,181 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2026
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 8.3.2026.10.18
+
+#pragma once
+
+// Batch versions of FIQuery<T, Segment3<T>, Triangle3<T>> for one segment
+// and many triangles or many segments and one triangle. Read the comments in
+// TriangleBatch3.h about the storage and the output and those in
+// IntrRay3Triangle3Batch.h about the consistency with the scalar query. As
+// in the scalar query, the segment is converted to its centered form
+// C + s * D with unit-length D and |s| <= e, and parameter[i] is the value
+// of s at the intersection. The equivalent parameter for the endpoint form
+// (1-t) * P0 + t * P1 is t = s / (2 * e) + 1/2.
+
+#include <Mathematics/IntrSegment3Triangle3.h>
+#include <Mathematics/TriangleBatch3.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gte
+{
+    // Segments stored in structure-of-arrays form. The centered forms are
+    // computed by Set exactly as Segment3<T>::GetCenteredForm does.
+    template <typename T>
+    class Segment3Batch
+    {
+    public:
+        Segment3Batch()
+            :
+            center{},
+            direction{},
+            extent{}
+        {
+        }
+
+        Segment3Batch(std::vector<Segment3<T>> const& segments)
+            :
+            center{},
+            direction{},
+            extent{}
+        {
+            Set(segments);
+        }
+
+        void Set(std::vector<Segment3<T>> const& segments)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                center[j].resize(segments.size());
+                direction[j].resize(segments.size());
+            }
+            extent.resize(segments.size());
+
+            for (std::size_t i = 0; i < segments.size(); ++i)
+            {
+                Vector3<T> segCenter{}, segDirection{};
+                segments[i].GetCenteredForm(segCenter, segDirection, extent[i]);
+                for (int32_t j = 0; j < 3; ++j)
+                {
+                    center[j][i] = segCenter[j];
+                    direction[j][i] = segDirection[j];
+                }
+            }
+        }
+
+        inline std::size_t GetNumSegments() const
+        {
+            return extent.size();
+        }
+
+        // The components center[j][i] and direction[j][i] are for segment i
+        // and dimension j. The extent of segment i is extent[i].
+        std::array<std::vector<T>, 3> center, direction;
+        std::vector<T> extent;
+    };
+
+    template <typename T>
+    class FIQuerySegment3Triangle3Batch
+    {
+    public:
+        using Result = TriangleBatch3Result<T>;
+
+        // Intersect one segment with each of the triangles. The result
+        // arrays are indexed by triangle. The function returns the number of
+        // intersected triangles.
+        std::size_t operator()(Segment3<T> const& segment,
+            TriangleBatch3<T> const& triangles, Result& result) const
+        {
+            std::size_t const numTriangles = triangles.GetNumTriangles();
+            result.Resize(numTriangles);
+
+            Vector3<T> segCenter{}, segDirection{};
+            T segExtent{};
+            segment.GetCenteredForm(segCenter, segDirection, segExtent);
+            T const cx = segCenter[0], cy = segCenter[1], cz = segCenter[2];
+            T const dx = segDirection[0], dy = segDirection[1], dz = segDirection[2];
+            T const tmin = -segExtent;
+            T const tmax = segExtent;
+            T const* v0x = triangles.v0[0].data();
+            T const* v0y = triangles.v0[1].data();
+            T const* v0z = triangles.v0[2].data();
+            T const* e1x = triangles.edge1[0].data();
+            T const* e1y = triangles.edge1[1].data();
+            T const* e1z = triangles.edge1[2].data();
+            T const* e2x = triangles.edge2[0].data();
+            T const* e2y = triangles.edge2[1].data();
+            T const* e2z = triangles.edge2[2].data();
+            uint8_t* intersect = result.intersect.data();
+            T* parameter = result.parameter.data();
+            T* bary0 = result.bary[0].data();
+            T* bary1 = result.bary[1].data();
+            T* bary2 = result.bary[2].data();
+
+            std::size_t numIntersections = 0;
+            TriangleBatch3Lanes<T> lanes{};
+            for (std::size_t i0 = 0; i0 < numTriangles; i0 += lanes.size)
+            {
+                std::size_t const numLanes = lanes.GetNumLanes(i0, numTriangles);
+                for (std::size_t k = 0, i = i0; k < numLanes; ++k, ++i)
+                {
+                    lanes.intersect[k] = TriangleBatch3<T>::IntersectLinear(
+                        cx - v0x[i], cy - v0y[i], cz - v0z[i], dx, dy, dz,
+                        e1x[i], e1y[i], e1z[i], e2x[i], e2y[i], e2z[i],
+                        tmin, tmax, lanes.parameter[k], lanes.bary0[k], lanes.bary1[k], lanes.bary2[k]);
+                }
+                numIntersections += lanes.CopyTo(i0, numLanes, intersect, parameter, bary0, bary1, bary2);
+            }
+            return numIntersections;
+        }
+
+        // Intersect each of the segments with one triangle. The result
+        // arrays are indexed by segment. The function returns the number of
+        // segments that intersect the triangle.
+        std::size_t operator()(Segment3Batch<T> const& segments,
+            Triangle3<T> const& triangle, Result& result) const
+        {
+            std::size_t const numSegments = segments.GetNumSegments();
+            result.Resize(numSegments);
+
+            Vector3<T> const edge1 = triangle.v[1] - triangle.v[0];
+            Vector3<T> const edge2 = triangle.v[2] - triangle.v[0];
+            T const v0x = triangle.v[0][0], v0y = triangle.v[0][1], v0z = triangle.v[0][2];
+            T const e1x = edge1[0], e1y = edge1[1], e1z = edge1[2];
+            T const e2x = edge2[0], e2y = edge2[1], e2z = edge2[2];
+            T const* cx = segments.center[0].data();
+            T const* cy = segments.center[1].data();
+            T const* cz = segments.center[2].data();
+            T const* dx = segments.direction[0].data();
+            T const* dy = segments.direction[1].data();
+            T const* dz = segments.direction[2].data();
+            T const* extent = segments.extent.data();
+            uint8_t* intersect = result.intersect.data();
+            T* parameter = result.parameter.data();
+            T* bary0 = result.bary[0].data();
+            T* bary1 = result.bary[1].data();
+            T* bary2 = result.bary[2].data();
+
+            std::size_t numIntersections = 0;
+            TriangleBatch3Lanes<T> lanes{};
+            for (std::size_t i0 = 0; i0 < numSegments; i0 += lanes.size)
+            {
+                std::size_t const numLanes = lanes.GetNumLanes(i0, numSegments);
+                for (std::size_t k = 0, i = i0; k < numLanes; ++k, ++i)
+                {
+                    lanes.intersect[k] = TriangleBatch3<T>::IntersectLinear(
+                        cx[i] - v0x, cy[i] - v0y, cz[i] - v0z, dx[i], dy[i], dz[i],
+                        e1x, e1y, e1z, e2x, e2y, e2z,
+                        -extent[i], extent[i], lanes.parameter[k], lanes.bary0[k], lanes.bary1[k], lanes.bary2[k]);
+                }
+                numIntersections += lanes.CopyTo(i0, numLanes, intersect, parameter, bary0, bary1, bary2);
+            }
+            return numIntersections;
+        }
+    };
+}
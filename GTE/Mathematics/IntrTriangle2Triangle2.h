@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2025.05.10
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -14,7 +14,12 @@
 // set (if it exists).  The find-intersection query for moving triangles is
 // based on the previously mentioned document about the method of separating
 // axes.
+//
+// The find-intersection query for stationary triangles has an
+// allocation-free form whose result stores the intersection in a
+// FixedCapacityVector. The intersection has at most 6 vertices.
 
+#include <Mathematics/FixedCapacityVector.h>
 #include <Mathematics/IntrConvexPolygonHyperplane.h>
 #include <Mathematics/Triangle.h>
 #include <Mathematics/Vector2.h>
@@ -115,29 +120,46 @@ namespace gte
     class FIQuery<T, Triangle2<T>, Triangle2<T>>
     {
     public:
-        struct Result
+        // The Polygon type is std::vector<Vector2<T>> for Result or
+        // FixedCapacityVector<Vector2<T>, 6> for FixedResult.
+        template <typename Polygon>
+        struct GenericResult
         {
-            Result()
+            GenericResult()
                 :
                 intersection{}
             {
             }
 
             // An intersection exists iff intersection.size() > 0.
-            std::vector<Vector2<T>> intersection;
+            Polygon intersection;
         };
 
+        using Result = GenericResult<std::vector<Vector2<T>>>;
+        using FixedResult = GenericResult<FixedCapacityVector<Vector2<T>, 6>>;
+
         Result operator()(Triangle2<T> const& triangle0, Triangle2<T> const& triangle1)
         {
             Result result{};
+            (*this)(triangle0, triangle1, result);
+            return result;
+        }
+
+        // The query with a caller-provided result. For a FixedResult, the
+        // query does not allocate memory.
+        template <typename Polygon>
+        void operator()(Triangle2<T> const& triangle0, Triangle2<T> const& triangle1,
+            GenericResult<Polygon>& result)
+        {
+            result.intersection.clear();
 
             // Start with triangle1 and clip against the edges of triangle0.
-            std::vector<Vector2<T>> polygon =
+            Polygon polygon =
             {
                 triangle1.v[0], triangle1.v[1], triangle1.v[2]
             };
 
-            typedef FIQuery<T, std::vector<Vector<2, T>>, Hyperplane<2, T>> PPQuery;
+            typedef FIQuery<T, Polygon, Hyperplane<2, T>> PPQuery;
             PPQuery ppQuery;
 
             for (int32_t i1 = 2, i0 = 0; i0 < 3; i1 = i0++)
@@ -153,13 +175,12 @@ namespace gte
                 if (ppResult.positivePolygon.size() == 0)
                 {
                     // The current clipped polygon is outside triangle0.
-                    return result;
+                    return;
                 }
                 polygon = std::move(ppResult.positivePolygon);
             }
 
-            result.intersection = polygon;
-            return result;
+            result.intersection = std::move(polygon);
         }
     };
 }
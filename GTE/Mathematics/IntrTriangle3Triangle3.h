@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2025.05.10
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -32,9 +32,14 @@
 //   2 1 0  segment (2 edges clipped)
 //   2 0 1  vertex
 //   3 0 0  none
+//
+// The FIQuery for stationary triangles has an allocation-free form whose
+// result stores the intersection in a FixedCapacityVector. The intersection
+// is a convex polygon with at most 6 vertices.
 
 #include <Mathematics/TIQuery.h>
 #include <Mathematics/FIQuery.h>
+#include <Mathematics/FixedCapacityVector.h>
 #include <Mathematics/Vector3.h>
 #include <Mathematics/IntrTriangle2Triangle2.h>
 #include <Mathematics/IntrSegment2Triangle2.h>
@@ -481,9 +486,12 @@ namespace gte
     class FIQuery<T, Triangle3<T>, Triangle3<T>>
     {
     public:
-        struct Result
+        // The Polygon type is std::vector<Vector3<T>> for Result or
+        // FixedCapacityVector<Vector3<T>, 6> for FixedResult.
+        template <typename Polygon>
+        struct GenericResult
         {
-            Result()
+            GenericResult()
                 :
                 intersect(false),
                 contactTime(static_cast<T>(0)),
@@ -495,13 +503,29 @@ namespace gte
             // nonnegative for moving triangles.
             bool intersect;
             T contactTime;
-            std::vector<Vector3<T>> intersection;
+            Polygon intersection;
         };
 
+        using Result = GenericResult<std::vector<Vector3<T>>>;
+        using FixedResult = GenericResult<FixedCapacityVector<Vector3<T>, 6>>;
+
         // The query is for stationary triangles.
         Result operator()(Triangle3<T> const& inTriangle0, Triangle3<T> const& inTriangle1)
         {
             Result result{};
+            (*this)(inTriangle0, inTriangle1, result);
+            return result;
+        }
+
+        // The query for stationary triangles with a caller-provided result.
+        // For a FixedResult, the query does not allocate memory.
+        template <typename Polygon>
+        void operator()(Triangle3<T> const& inTriangle0, Triangle3<T> const& inTriangle1,
+            GenericResult<Polygon>& result)
+        {
+            result.intersect = false;
+            result.contactTime = static_cast<T>(0);
+            result.intersection.clear();
 
             // Translate the triangles so that triangle0.v[0] becomes (0,0,0).
             T const zero = static_cast<T>(0);
@@ -640,7 +664,6 @@ namespace gte
                     point += origin;
                 }
             }
-            return result;
         }
 
         // The query is for triangles moving with constant linear velocity
@@ -777,9 +800,10 @@ namespace gte
         // triangles. The intersection is computed by projecting the triangles
         // onto the plane and using a find-intersection query for two
         // triangles in 2D. The intersection can be empty.
+        template <typename ResultType>
         static void GetCoplanarIntersection(Vector3<T> const& normal,
             Triangle3<T> const& triangle0, Triangle3<T> const& triangle1,
-            Result& result)
+            ResultType& result)
         {
             // Project the triangles onto the coordinate plane most aligned
             // with the plane normal.
@@ -841,7 +865,8 @@ namespace gte
             }
 
             FIQuery<T, Triangle2<T>, Triangle2<T>> ttQuery{};
-            auto ttResult = ttQuery(projTriangle0, projTriangle1);
+            typename FIQuery<T, Triangle2<T>, Triangle2<T>>::FixedResult ttResult{};
+            ttQuery(projTriangle0, projTriangle1, ttResult);
             size_t const numVertices = ttResult.intersection.size();
             if (numVertices == 0)
             {
@@ -867,8 +892,9 @@ namespace gte
         // Compute the point or segment of intersection of the 'triangle' with
         // 'normal' vector. The input segment is an edge of the other triangle.
         // The intersection can be empty.
+        template <typename ResultType>
         static void IntersectsSegment(Vector3<T> const& normal,
-            Triangle3<T> const& triangle, Segment3<T> const& segment, Result& result)
+            Triangle3<T> const& triangle, Segment3<T> const& segment, ResultType& result)
         {
             // Project the triangle and segment onto the coordinate plane most
             // aligned with the plane normal.
@@ -941,8 +967,9 @@ namespace gte
         
         // Determine whether the point is inside or strictly outside the
         // triangle.
+        template <typename ResultType>
         static void ContainsPoint(Vector3<T> const& normal,
-            Triangle3<T> const& triangle, Vector3<T> const& point, Result& result)
+            Triangle3<T> const& triangle, Vector3<T> const& point, ResultType& result)
         {
             // Project the triangle and point onto the coordinate plane most
             // aligned with the plane normal.
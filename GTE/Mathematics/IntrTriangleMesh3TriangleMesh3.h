@@ -0,0 +1,243 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2026
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 8.3.2026.10.18
+
+#pragma once
+
+// Compute the pairs of intersecting triangles of two triangle meshes, the
+// first mesh stationary and the second mesh placed by a rigid motion. This
+// is the CPU counterpart of the compute shaders in the AllPairsTriangles
+// sample, which test every triangle of one mesh against every triangle of
+// the other mesh. Each mesh is stored in an axis-aligned bounding box tree
+// that is built once by Create. A query has three phases.
+//
+//   1. The broad phase traverses the two trees simultaneously and generates
+//      the candidate pairs, which are those pairs of triangles whose
+//      bounding boxes overlap (BVTreeOfTriangles::FindOverlappingTriangles).
+//   2. The narrow phase applies TIQuery<T, Triangle3<T>, Triangle3<T>> to
+//      the candidates. The candidates are split into contiguous blocks, one
+//      block per thread.
+//   3. Optionally, FIQuery<T, Triangle3<T>, Triangle3<T>> computes the set
+//      of intersection for each intersecting pair. The set is a point, a
+//      segment or, for coplanar triangles, a convex polygon.
+//
+// The output is stored in flat arrays that are sorted by triangle pair, so
+// it does not depend on the number of threads. The object is not modified
+// by the queries, so a single object can be queried concurrently.
+
+#include <Mathematics/AlignedBoxTreeOfTriangles.h>
+#include <Mathematics/IntrTriangle3Triangle3.h>
+#include <Mathematics/Matrix3x3.h>
+#include <Mathematics/Vector3.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace gte
+{
+    template <typename T>
+    class IntrTriangleMesh3TriangleMesh3
+    {
+    public:
+        struct Result
+        {
+            Result()
+                :
+                numCandidates(0),
+                triangle0{},
+                triangle1{},
+                offset{},
+                points{}
+            {
+            }
+
+            inline std::size_t GetNumPairs() const
+            {
+                return triangle0.size();
+            }
+
+            // The number of candidate pairs generated by the broad phase.
+            std::size_t numCandidates;
+
+            // The intersecting pair i consists of triangle triangle0[i] of
+            // mesh0 and triangle triangle1[i] of mesh1. The pairs are sorted
+            // lexicographically.
+            std::vector<std::size_t> triangle0, triangle1;
+
+            // These are computed only when the query is asked for the sets
+            // of intersection; otherwise, they are empty. The set for pair i
+            // has vertices points[offset[i]] through points[offset[i+1]-1],
+            // so offset has GetNumPairs()+1 elements. The points are in the
+            // coordinate system of mesh0. The set can be empty for triangles
+            // that only touch, because TIQuery and FIQuery are different
+            // algorithms whose rounding errors differ.
+            std::vector<std::size_t> offset;
+            std::vector<Vector3<T>> points;
+        };
+
+        IntrTriangleMesh3TriangleMesh3()
+            :
+            mTree0{},
+            mTree1{}
+        {
+        }
+
+        // The trees are built to full height, so each leaf has a single
+        // triangle and the broad phase reports exactly the triangle pairs
+        // whose bounding boxes overlap.
+        void Create(
+            std::vector<Vector3<T>> const& vertices0,
+            std::vector<std::array<std::size_t, 3>> const& triangles0,
+            std::vector<Vector3<T>> const& vertices1,
+            std::vector<std::array<std::size_t, 3>> const& triangles1)
+        {
+            mTree0.Create(vertices0, triangles0);
+            mTree1.Create(vertices1, triangles1);
+        }
+
+        // Member access.
+        inline AlignedBoxTreeOfTriangles<T> const& GetTree0() const
+        {
+            return mTree0;
+        }
+
+        inline AlignedBoxTreeOfTriangles<T> const& GetTree1() const
+        {
+            return mTree1;
+        }
+
+        // Mesh1 is transformed into the coordinate system of mesh0 by the
+        // rigid motion X' = rotate * X + translate. Set computeSets to true
+        // to compute the sets of intersection. Set numThreads to 0 or 1 to
+        // execute in the main thread. Set numThreads to 2 or larger to
+        // split the broad phase and the narrow phase among that many
+        // threads.
+        void operator()(
+            Matrix3x3<T> const& rotate,
+            Vector3<T> const& translate,
+            bool computeSets,
+            std::size_t numThreads,
+            Result& result) const
+        {
+            std::vector<std::array<std::size_t, 2>> candidates{};
+            mTree0.FindOverlappingTriangles(mTree1, rotate, translate, numThreads, candidates);
+            std::size_t const numCandidates = candidates.size();
+
+            auto const& vertices1 = mTree1.GetVertices();
+            std::vector<Vector3<T>> transformed1(vertices1.size());
+            for (std::size_t i = 0; i < vertices1.size(); ++i)
+            {
+                transformed1[i] = rotate * vertices1[i] + translate;
+            }
+
+            // The narrow phase writes intersect[c] and, for the sets of
+            // intersection, numPoints[c] and the points of candidate c. The
+            // candidates of a thread are contiguous, so the concatenation
+            // of the point buffers is in candidate order.
+            std::vector<std::uint8_t> intersect(numCandidates);
+            std::vector<std::size_t> numPoints(computeSets ? numCandidates : 0);
+            numThreads = std::max(std::min(numThreads, numCandidates), static_cast<std::size_t>(1));
+            std::vector<std::vector<Vector3<T>>> buffers(numThreads);
+            if (numThreads == 1)
+            {
+                NarrowPhase(candidates, transformed1, computeSets, 0, numCandidates,
+                    intersect, numPoints, buffers[0]);
+            }
+            else
+            {
+                std::vector<std::thread> process(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    std::size_t const cmin = t * numCandidates / numThreads;
+                    std::size_t const csup = (t + 1) * numCandidates / numThreads;
+                    process[t] = std::thread([this, &candidates, &transformed1, computeSets,
+                        cmin, csup, &intersect, &numPoints, &buffers, t]()
+                    {
+                        NarrowPhase(candidates, transformed1, computeSets, cmin, csup,
+                            intersect, numPoints, buffers[t]);
+                    });
+                }
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+
+            // Compact the intersecting candidates into the output arrays.
+            result.numCandidates = numCandidates;
+            result.triangle0.clear();
+            result.triangle1.clear();
+            result.offset.clear();
+            result.points.clear();
+            if (computeSets)
+            {
+                result.offset.push_back(0);
+                for (auto const& buffer : buffers)
+                {
+                    result.points.insert(result.points.end(), buffer.begin(), buffer.end());
+                }
+            }
+            for (std::size_t c = 0; c < numCandidates; ++c)
+            {
+                if (intersect[c])
+                {
+                    result.triangle0.push_back(candidates[c][0]);
+                    result.triangle1.push_back(candidates[c][1]);
+                    if (computeSets)
+                    {
+                        result.offset.push_back(result.offset.back() + numPoints[c]);
+                    }
+                }
+            }
+        }
+
+        // The query when both meshes are in the same coordinate system.
+        void operator()(bool computeSets, std::size_t numThreads, Result& result) const
+        {
+            (*this)(Matrix3x3<T>::Identity(), Vector3<T>::Zero(), computeSets, numThreads, result);
+        }
+
+    private:
+        // Process the candidates c with cmin <= c < csup.
+        void NarrowPhase(
+            std::vector<std::array<std::size_t, 2>> const& candidates,
+            std::vector<Vector3<T>> const& transformed1,
+            bool computeSets,
+            std::size_t cmin,
+            std::size_t csup,
+            std::vector<std::uint8_t>& intersect,
+            std::vector<std::size_t>& numPoints,
+            std::vector<Vector3<T>>& buffer) const
+        {
+            auto const& vertices0 = mTree0.GetVertices();
+            auto const& triangles0 = mTree0.GetTriangles();
+            auto const& triangles1 = mTree1.GetTriangles();
+            TIQuery<T, Triangle3<T>, Triangle3<T>> tiQuery{};
+            FIQuery<T, Triangle3<T>, Triangle3<T>> fiQuery{};
+            for (std::size_t c = cmin; c < csup; ++c)
+            {
+                auto const& tri0 = triangles0[candidates[c][0]];
+                auto const& tri1 = triangles1[candidates[c][1]];
+                Triangle3<T> triangle0(vertices0[tri0[0]], vertices0[tri0[1]], vertices0[tri0[2]]);
+                Triangle3<T> triangle1(transformed1[tri1[0]], transformed1[tri1[1]], transformed1[tri1[2]]);
+                intersect[c] = (tiQuery(triangle0, triangle1).intersect ? 1 : 0);
+                if (computeSets && intersect[c])
+                {
+                    typename FIQuery<T, Triangle3<T>, Triangle3<T>>::FixedResult fiResult{};
+                    fiQuery(triangle0, triangle1, fiResult);
+                    numPoints[c] = fiResult.intersection.size();
+                    buffer.insert(buffer.end(), fiResult.intersection.begin(),
+                        fiResult.intersection.end());
+                }
+            }
+        }
+
+        AlignedBoxTreeOfTriangles<T> mTree0, mTree1;
+    };
+}
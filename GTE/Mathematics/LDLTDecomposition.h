@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2026.02.18
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -13,9 +13,11 @@
 
 #include <Mathematics/Matrix.h>
 #include <Mathematics/GMatrix.h>
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <thread>
 #include <vector>
 
 namespace gte
@@ -125,16 +127,26 @@ namespace gte
         }
     };
 
-    // Implementation for sizes known only at run time.
+    // Implementation for sizes known only at run time. The factorization is
+    // blocked in the same manner as CholeskyDecomposition<Real, 0>. The
+    // lower-triangular part of A is copied to L and factored in place in
+    // panels of 64 columns. The trailing submatrix is updated by the panel
+    // scaled by the diagonal entries of D. The results are the same for
+    // any number of threads, and they are the same as those of the
+    // unblocked algorithm when N <= 64.
     template <typename T>
     class LDLTDecomposition<T>
     {
     public:
         std::int32_t const N;
 
-        LDLTDecomposition(std::int32_t inN)
+        // Set numThreads to 0 or 1 to factor in the main thread. Set
+        // numThreads to 2 or larger to distribute the updates of the
+        // factorization among that many threads.
+        LDLTDecomposition(std::int32_t inN, std::size_t numThreads = 0)
             :
-            N(inN)
+            N(inN),
+            mNumThreads(numThreads)
         {
             LogAssert(
                 N > 0,
@@ -157,37 +169,98 @@ namespace gte
             D.SetSize(N, N);
             D.MakeZero();
 
-            for (std::int32_t j = 0; j < N; ++j)
+            for (std::int32_t r = 0; r < N; ++r)
             {
-                T Djj = A(j, j);
-                for (std::int32_t k = 0; k < j; ++k)
+                for (std::int32_t c = 0; c <= r; ++c)
                 {
-                    T Ljk = L(j, k);
-                    T Dkk = D(k, k);
-                    Djj -= Ljk * Ljk * Dkk;
+                    L(r, c) = A(r, c);
                 }
-                D(j, j) = Djj;
-                if (Djj == zero)
+            }
+
+            std::size_t const size = static_cast<std::size_t>(N);
+            T* l = &L[0];
+            std::vector<T> diagonal(size), panel{}, scaledPanel{};
+            for (std::size_t k0 = 0; k0 < size; k0 += blockSize)
+            {
+                std::size_t const k1 = std::min(k0 + blockSize, size);
+
+                // Factor the diagonal block A(k0:k1,k0:k1).
+                for (std::size_t j = k0; j < k1; ++j)
                 {
-                    return false;
+                    T Djj = l[Index(j, j)];
+                    for (std::size_t k = k0; k < j; ++k)
+                    {
+                        T Ljk = l[Index(j, k)];
+                        T Dkk = diagonal[k];
+                        Djj -= Ljk * Ljk * Dkk;
+                    }
+                    diagonal[j] = Djj;
+                    if (Djj == zero)
+                    {
+                        return false;
+                    }
+
+                    for (std::size_t i = j + 1; i < k1; ++i)
+                    {
+                        T Lij = l[Index(i, j)];
+                        for (std::size_t k = k0; k < j; ++k)
+                        {
+                            T Lik = l[Index(i, k)];
+                            T Ljk = l[Index(j, k)];
+                            T Dkk = diagonal[k];
+                            Lij -= Lik * Ljk * Dkk;
+                        }
+
+                        Lij /= Djj;
+                        l[Index(i, j)] = Lij;
+                    }
                 }
 
-                L(j, j) = one;
-                for (std::int32_t i = j + 1; i < N; ++i)
+                if (k1 < size)
                 {
-                    T Lij = A(i, j);
-                    for (std::int32_t k = 0; k < j; ++k)
+                    // Solve L(k1:N,k0:k1) * D(k0:k1) * L(k0:k1,k0:k1)^T =
+                    // A(k1:N,k0:k1) for the panel below the diagonal block.
+                    T const* D = diagonal.data();
+                    Execute(size - k1, [this, l, D, size, k0, k1](std::size_t t, std::size_t numT)
                     {
-                        T Lik = L(i, k);
-                        T Ljk = L(j, k);
-                        T Dkk = D(k, k);
-                        Lij -= Lik * Ljk * Dkk;
+                        for (std::size_t i = k1 + t; i < size; i += numT)
+                        {
+                            for (std::size_t j = k0; j < k1; ++j)
+                            {
+                                T Lij = l[Index(i, j)];
+                                for (std::size_t k = k0; k < j; ++k)
+                                {
+                                    Lij -= l[Index(i, k)] * l[Index(j, k)] * D[k];
+                                }
+                                l[Index(i, j)] = Lij / D[j];
+                            }
+                        }
+                    });
+
+                    // A(k1:N,k1:N) -= L(k1:N,k0:k1) * D(k0:k1) *
+                    // L(k1:N,k0:k1)^T
+                    std::size_t const numPanelRows = size - k1;
+                    panel.resize((k1 - k0) * numPanelRows);
+                    scaledPanel.resize(panel.size());
+                    for (std::size_t k = k0; k < k1; ++k)
+                    {
+                        std::size_t const offset = (k - k0) * numPanelRows;
+                        for (std::size_t r = k1; r < size; ++r)
+                        {
+                            T const value = l[Index(r, k)];
+                            panel[offset + r - k1] = value;
+                            scaledPanel[offset + r - k1] = value * D[k];
+                        }
                     }
-
-                    Lij /= Djj;
-                    L(i, j) = Lij;
+                    UpdateTrailing(l, size, k0, k1, panel.data(), scaledPanel.data());
                 }
             }
+
+            for (std::size_t j = 0; j < size; ++j)
+            {
+                l[Index(j, j)] = one;
+                D(static_cast<std::int32_t>(j), static_cast<std::int32_t>(j)) = diagonal[j];
+            }
             return true;
         }
 
@@ -247,6 +320,83 @@ namespace gte
             }
             return success;
         }
+
+    private:
+        static std::size_t constexpr blockSize = 64;
+        static std::size_t constexpr tileSize = 256;
+
+        // The index of entry (r,c) in the storage of an NxN matrix.
+        inline std::size_t Index(std::size_t r, std::size_t c) const
+        {
+#if defined(GTE_USE_COL_MAJOR)
+            return r + static_cast<std::size_t>(N) * c;
+#else
+            return c + static_cast<std::size_t>(N) * r;
+#endif
+        }
+
+        // Subtract L(k1:N,k0:k1) * D(k0:k1) * L(k1:N,k0:k1)^T from the
+        // lower-triangular part of A(k1:N,k1:N), which is stored in l.
+        // The entry panel[(k - k0) * (N - k1) + r - k1] is L(r,k) and
+        // scaledPanel stores the products L(r,k) * D(k). The updated
+        // entries of a row (or column for column-major storage) are
+        // contiguous.
+        void UpdateTrailing(T* l, std::size_t size, std::size_t k0,
+            std::size_t k1, T const* panel, T const* scaledPanel)
+        {
+            std::size_t const numPanelRows = size - k1;
+            Execute(numPanelRows, [l, size, k0, k1, panel, scaledPanel, numPanelRows](std::size_t t, std::size_t numT)
+            {
+                for (std::size_t c0 = k1; c0 < size; c0 += tileSize)
+                {
+                    std::size_t const c1 = std::min(c0 + tileSize, size);
+                    for (std::size_t r = k1 + t; r < size; r += numT)
+                    {
+#if defined(GTE_USE_COL_MAJOR)
+                        std::size_t const cMin = std::max(c0, r), cSup = c1;
+#else
+                        std::size_t const cMin = c0, cSup = std::min(c1, r + 1);
+#endif
+                        T* target = l + r * size;
+                        for (std::size_t k = 0; k < k1 - k0; ++k)
+                        {
+                            T const value = panel[k * numPanelRows + r - k1];
+                            T const* source = scaledPanel + k * numPanelRows;
+                            for (std::size_t c = cMin; c < cSup; ++c)
+                            {
+                                target[c] -= value * source[c - k1];
+                            }
+                        }
+                    }
+                }
+            });
+        }
+
+        // Process the items [0,numItems) by calls function(t, numThreads),
+        // where thread t processes the items t, t + numThreads, and so on.
+        template <typename Function>
+        void Execute(std::size_t numItems, Function const& function) const
+        {
+            std::size_t const numThreads = std::min(mNumThreads, numItems);
+            if (numThreads <= 1)
+            {
+                function(0, 1);
+            }
+            else
+            {
+                std::vector<std::thread> process(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t] = std::thread(function, t, numThreads);
+                }
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+        }
+
+        std::size_t mNumThreads;
     };
 
     // Implementation for sizes known at compile time.
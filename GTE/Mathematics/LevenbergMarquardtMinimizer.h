@@ -3,20 +3,25 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2025.05.10
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
 // See GaussNewtonMinimizer.h for a formulation of the minimization
-// problem and how Levenberg-Marquardt relates to Gauss-Newton.
+// problem and how Levenberg-Marquardt relates to Gauss-Newton. For a sparse
+// Jacobian matrix, see SparseJacobian.h. In this case J(p) and the normal
+// equations are computed once per iterate p and are reused for the
+// adjustments of lambda.
 
 #include <Mathematics/CholeskyDecomposition.h>
+#include <Mathematics/SparseJacobian.h>
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <limits>
 #include <utility>
+#include <vector>
 
 namespace gte
 {
@@ -48,7 +53,11 @@ namespace gte
             mJTJ(mNumPDimensions, mNumPDimensions),
             mNegJTF(mNumPDimensions),
             mDecomposer(mNumPDimensions),
-            mUseJFunction(true)
+            mUseJFunction(true),
+            mSparseJacobian(nullptr),
+            mSparseF{},
+            mSparseFNext{},
+            mSparseUpdated(false)
         {
             LogAssert(mNumPDimensions > 0 && mNumFDimensions > 0, "Invalid dimensions.");
         }
@@ -66,11 +75,35 @@ namespace gte
             mJTJ(mNumPDimensions, mNumPDimensions),
             mNegJTF(mNumPDimensions),
             mDecomposer(mNumPDimensions),
-            mUseJFunction(false)
+            mUseJFunction(false),
+            mSparseJacobian(nullptr),
+            mSparseF{},
+            mSparseFNext{},
+            mSparseUpdated(false)
         {
             LogAssert(mNumPDimensions > 0 && mNumFDimensions > 0, "Invalid dimensions.");
         }
 
+        // Create the minimizer for a sparse Jacobian matrix. The dense
+        // matrices J(p) and J^T(p)*J(p) are not stored. The object
+        // 'jacobian' must exist during the lifetime of the minimizer.
+        LevenbergMarquardtMinimizer(SparseJacobian<T>& jacobian)
+            :
+            mNumPDimensions(jacobian.GetNumPDimensions()),
+            mNumFDimensions(jacobian.GetNumFDimensions()),
+            mF(0),
+            mJ(0, 0),
+            mJTJ(0, 0),
+            mNegJTF(mNumPDimensions),
+            mDecomposer(mNumPDimensions),
+            mUseJFunction(false),
+            mSparseJacobian(&jacobian),
+            mSparseF{},
+            mSparseFNext{},
+            mSparseUpdated(false)
+        {
+        }
+
         // Disallow copy, assignment and move semantics.
         LevenbergMarquardtMinimizer(LevenbergMarquardtMinimizer const&) = delete;
         LevenbergMarquardtMinimizer& operator=(LevenbergMarquardtMinimizer const&) = delete;
@@ -96,7 +129,10 @@ namespace gte
                 minUpdateLength(static_cast<T>(0)),
                 numIterations(0),
                 numAdjustments(0),
-                converged(false)
+                converged(false),
+                numFEvaluations(0),
+                numJEvaluations(0),
+                numSolverIterations(0)
             {
                 minLocation.MakeZero();
             }
@@ -108,6 +144,15 @@ namespace gte
             size_t numIterations;
             size_t numAdjustments;
             bool converged;
+
+            // Statistics for profiling. The numbers of evaluations of F(p)
+            // and of J(p) (or of the J^T(p)*J(p) and -J^T(p)*F(p) of the
+            // JPlusFunction) are counted. For a sparse Jacobian matrix,
+            // numSolverIterations is the total number of conjugate gradient
+            // iterations; otherwise, it is 0.
+            size_t numFEvaluations;
+            size_t numJEvaluations;
+            size_t numSolverIterations;
         };
 
         Result operator()(DVector const& p0, size_t maxIterations,
@@ -137,8 +182,8 @@ namespace gte
             errorDifferenceTolerance = std::max(errorDifferenceTolerance, (T)0);
 
             // Compute the initial error.
-            mFFunction(p0, mF);
-            result.minError = Dot(mF, mF);
+            result.minError = ComputeError(p0, mSparseF, result);
+            mSparseUpdated = false;
 
             // Do the Levenberg-Marquart iterations.
             auto pCurrent = p0;
@@ -197,18 +242,37 @@ namespace gte
                 }
 
                 pCurrent = pNext;
+                if (mSparseJacobian)
+                {
+                    std::swap(mSparseF, mSparseFNext);
+                    mSparseUpdated = false;
+                }
             }
 
             return result;
         }
 
     private:
+        T ComputeError(DVector const& p, std::vector<T>& sparseF, Result& result)
+        {
+            ++result.numFEvaluations;
+            if (mSparseJacobian)
+            {
+                return mSparseJacobian->EvaluateF(p, sparseF);
+            }
+            else
+            {
+                mFFunction(p, mF);
+                return Dot(mF, mF);
+            }
+        }
+
         void ComputeLinearSystemInputs(DVector const& pCurrent, T lambda)
         {
             if (mUseJFunction)
             {
                 mJFunction(pCurrent, mJ);
-                mJTJ = MultiplyATB(mJ, mJ);
+                mJTJ = MultiplyATA(mJ);
                 mNegJTF = -(mF * mJ);
             }
             else
@@ -239,21 +303,36 @@ namespace gte
             T updateLengthTolerance, T errorDifferenceTolerance, DVector& pNext,
             Result& result)
         {
-            ComputeLinearSystemInputs(pCurrent, lambdaFactor);
-            if (!mDecomposer.Factor(mJTJ))
+            if (mSparseJacobian)
+            {
+                // The normal equations depend only on pCurrent, so they
+                // are computed once for all the adjustments of lambda.
+                if (!mSparseUpdated)
+                {
+                    ++result.numJEvaluations;
+                    mSparseJacobian->EvaluateNormalEquations(pCurrent, mSparseF);
+                    mSparseUpdated = true;
+                }
+                result.numSolverIterations += mSparseJacobian->Solve(lambdaFactor, mNegJTF);
+            }
+            else
             {
-                // TODO: The matrix mJTJ is positive semi-definite, so the
-                // failure can occur when mJTJ has a zero eigenvalue in
-                // which case mJTJ is not invertible.  Generate an iterate
-                // anyway, perhaps using gradient descent?
-                return std::make_pair(true, false);
+                ++result.numJEvaluations;
+                ComputeLinearSystemInputs(pCurrent, lambdaFactor);
+                if (!mDecomposer.Factor(mJTJ))
+                {
+                    // TODO: The matrix mJTJ is positive semi-definite, so the
+                    // failure can occur when mJTJ has a zero eigenvalue in
+                    // which case mJTJ is not invertible.  Generate an iterate
+                    // anyway, perhaps using gradient descent?
+                    return std::make_pair(true, false);
+                }
+                mDecomposer.SolveLower(mJTJ, mNegJTF);
+                mDecomposer.SolveUpper(mJTJ, mNegJTF);
             }
-            mDecomposer.SolveLower(mJTJ, mNegJTF);
-            mDecomposer.SolveUpper(mJTJ, mNegJTF);
 
             pNext = pCurrent + mNegJTF;
-            mFFunction(pNext, mF);
-            T error = Dot(mF, mF);
+            T error = ComputeError(pNext, mSparseFNext, result);
             if (error < result.minError)
             {
                 result.minErrorDifference = result.minError - error;
@@ -291,6 +370,14 @@ namespace gte
         CholeskyDecomposition<T> mDecomposer;
 
         bool mUseJFunction;
+
+        // Support for a sparse Jacobian matrix. The members mSparseF and
+        // mSparseFNext store F(p) for the current and the next iterates.
+        // The normal equations for the current iterate are computed when
+        // mSparseUpdated is false.
+        SparseJacobian<T>* mSparseJacobian;
+        std::vector<T> mSparseF, mSparseFNext;
+        bool mSparseUpdated;
     };
 }
 
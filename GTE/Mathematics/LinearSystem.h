@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2025.05.10
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -18,16 +18,33 @@
 // on the discussion in "Matrix Computations, 2nd edition" by G. H. Golub
 // and Charles F. Van Loan, The Johns Hopkins Press, Baltimore MD, Fourth
 // Printing 1993.
+//
+// For large sparse systems, convert the matrix to compressed sparse row
+// (CSR) form with CreateCSR and use the SolveSymmetricCG overload for
+// CSRMatrix. That overload supports Jacobi and incomplete Cholesky
+// preconditioners and distributes the rows among threads. Each thread runs
+// the iterations for its block of rows and the threads synchronize at a
+// barrier before the matrix-vector product and after each inner product.
+// The inner products are sums of partial sums over fixed-size blocks of
+// rows, added in block order, so the solution does not depend on the number
+// of threads.
 
 #include <Mathematics/Matrix2x2.h>
 #include <Mathematics/Matrix3x3.h>
 #include <Mathematics/Matrix4x4.h>
 #include <Mathematics/GaussianElimination.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace gte
@@ -234,44 +251,338 @@ namespace gte
         static uint32_t SolveSymmetricCG(int32_t N, SparseMatrix const& A,
             Real const* B, Real* X, uint32_t maxIterations, Real tolerance)
         {
-            // The first iteration.
-            std::vector<Real> tmpR(N), tmpP(N), tmpW(N);
-            Real* R = &tmpR[0];
-            Real* P = &tmpP[0];
-            Real* W = &tmpW[0];
-            size_t numBytes = N * sizeof(Real);
-            std::memset(X, 0, numBytes);
-            std::memcpy(R, B, numBytes);
-            Real rho0 = Dot(N, R, R);
-            std::memcpy(P, R, numBytes);
-            Mul(N, A, P, W);
-            Real alpha = rho0 / Dot(N, P, W);
-            UpdateX(N, X, alpha, P);
-            UpdateR(N, R, alpha, W);
-            Real rho1 = Dot(N, R, R);
+            CSRMatrix csr{};
+            CreateCSR(N, A, csr);
+            return SolveSymmetricCG(csr, B, X, maxIterations, tolerance,
+                Preconditioner::NONE, 0);
+        }
 
-            // The remaining iterations.
-            uint32_t iteration;
-            for (iteration = 1; iteration <= maxIterations; ++iteration)
+        // Compressed sparse row storage of an NxN matrix. The nonzero
+        // entries of row i are values[k] in columns[k] for
+        // offsets[i] <= k < offsets[i + 1], and the columns of a row are
+        // increasing. Unlike SparseMatrix, both (i,j) and (j,i) are stored
+        // for a symmetric matrix, so the rows can be processed
+        // independently.
+        struct CSRMatrix
+        {
+            CSRMatrix()
+                :
+                numRows(0),
+                offsets{},
+                columns{},
+                values{}
             {
-                Real root0 = std::sqrt(rho1);
-                Real norm = Dot(N, B, B);
-                Real root1 = std::sqrt(norm);
-                if (root0 <= tolerance * root1)
+            }
+
+            int32_t numRows;
+            std::vector<std::size_t> offsets;
+            std::vector<int32_t> columns;
+            std::vector<Real> values;
+        };
+
+        // Convert the symmetric sparse matrix A, where only one of (i,j) and
+        // (j,i) is stored, to CSR form with both entries stored. If both
+        // (i,j) and (j,i) are in A, their values are added, which matches
+        // the product of A with a vector in the SparseMatrix overload of
+        // SolveSymmetricCG.
+        static void CreateCSR(int32_t N, SparseMatrix const& A, CSRMatrix& csr)
+        {
+            LogAssert(
+                N > 0,
+                "Invalid size.");
+
+            std::size_t const numRows = static_cast<std::size_t>(N);
+            csr.numRows = N;
+            csr.offsets.assign(numRows + 1, 0);
+            for (auto const& element : A)
+            {
+                int32_t i = element.first[0];
+                int32_t j = element.first[1];
+                LogAssert(
+                    0 <= i && i < N && 0 <= j && j < N,
+                    "Invalid index.");
+
+                ++csr.offsets[static_cast<std::size_t>(i) + 1];
+                if (i != j)
                 {
-                    break;
+                    ++csr.offsets[static_cast<std::size_t>(j) + 1];
                 }
+            }
+            for (std::size_t i = 0; i < numRows; ++i)
+            {
+                csr.offsets[i + 1] += csr.offsets[i];
+            }
 
-                Real beta = rho1 / rho0;
-                UpdateP(N, P, beta, R);
-                Mul(N, A, P, W);
-                alpha = rho1 / Dot(N, P, W);
-                UpdateX(N, X, alpha, P);
-                UpdateR(N, R, alpha, W);
-                rho0 = rho1;
-                rho1 = Dot(N, R, R);
+            // The map is ordered by (i,j), so the entries (i,j) are appended
+            // to row i in increasing j. The mirrored entries (j,i) with
+            // i > j are appended to row j in increasing i, but they are
+            // interleaved with the entries of row j, so each row is sorted
+            // afterwards.
+            std::size_t const numElements = csr.offsets.back();
+            csr.columns.resize(numElements);
+            csr.values.resize(numElements);
+            std::vector<std::size_t> current(csr.offsets.begin(), csr.offsets.end() - 1);
+            for (auto const& element : A)
+            {
+                int32_t i = element.first[0];
+                int32_t j = element.first[1];
+                std::size_t k = current[i]++;
+                csr.columns[k] = j;
+                csr.values[k] = element.second;
+                if (i != j)
+                {
+                    k = current[j]++;
+                    csr.columns[k] = i;
+                    csr.values[k] = element.second;
+                }
             }
-            return iteration;
+
+            std::vector<std::pair<int32_t, Real>> row{};
+            for (std::size_t i = 0; i < numRows; ++i)
+            {
+                std::size_t const kMin = csr.offsets[i], kSup = csr.offsets[i + 1];
+                row.clear();
+                for (std::size_t k = kMin; k < kSup; ++k)
+                {
+                    row.push_back(std::make_pair(csr.columns[k], csr.values[k]));
+                }
+                std::sort(row.begin(), row.end(),
+                    [](std::pair<int32_t, Real> const& e0, std::pair<int32_t, Real> const& e1)
+                    {
+                        return e0.first < e1.first;
+                    });
+
+                // Merge duplicate (i,j), which occur when both (i,j) and
+                // (j,i) are in A.
+                std::size_t k = kMin;
+                for (std::size_t r = 0; r < row.size(); ++r)
+                {
+                    if (k > kMin && csr.columns[k - 1] == row[r].first)
+                    {
+                        csr.values[k - 1] += row[r].second;
+                    }
+                    else
+                    {
+                        csr.columns[k] = row[r].first;
+                        csr.values[k] = row[r].second;
+                        ++k;
+                    }
+                }
+
+                // Mark the unused slots at the end of the row with column
+                // -1. They are removed by the compaction below.
+                for (; k < kSup; ++k)
+                {
+                    csr.columns[k] = -1;
+                }
+            }
+
+            // Compact the storage when duplicates were merged.
+            std::size_t numValid = 0;
+            for (std::size_t i = 0; i < numRows; ++i)
+            {
+                std::size_t const kMin = csr.offsets[i], kSup = csr.offsets[i + 1];
+                csr.offsets[i] = numValid;
+                for (std::size_t k = kMin; k < kSup && csr.columns[k] >= 0; ++k)
+                {
+                    csr.columns[numValid] = csr.columns[k];
+                    csr.values[numValid] = csr.values[k];
+                    ++numValid;
+                }
+            }
+            csr.offsets[numRows] = numValid;
+            csr.columns.resize(numValid);
+            csr.values.resize(numValid);
+        }
+
+        // The preconditioners M for the CSR conjugate gradient solver.
+        //   NONE: M = I.
+        //   JACOBI: M = D, the diagonal of A.
+        //   INCOMPLETE_CHOLESKY: M = L*L^T, where L is lower triangular with
+        //     the sparsity pattern of the lower triangle of A (IC(0)). If a
+        //     pivot is not positive, the diagonal entry of A is used for it.
+        //     The triangular solves are sequential, so they are executed by
+        //     one thread while the others wait.
+        // The Jacobi and incomplete Cholesky preconditioners require every
+        // row of A to have a diagonal entry.
+        enum class Preconditioner
+        {
+            NONE,
+            JACOBI,
+            INCOMPLETE_CHOLESKY
+        };
+
+        // Solve A*X = B using the preconditioned conjugate gradient method,
+        // where A is sparse, symmetric and stored in CSR form. The initial
+        // guess is X = 0. The iterations terminate when
+        // |B - A*X| <= tolerance * |B| or when maxIterations iterations
+        // have been performed. The return value is the number of iterations.
+        // Set numThreads to 0 or 1 to execute in the main thread. Set
+        // numThreads to 2 or larger to distribute the rows among that many
+        // threads.
+        static uint32_t SolveSymmetricCG(CSRMatrix const& A, Real const* B,
+            Real* X, uint32_t maxIterations, Real tolerance,
+            Preconditioner preconditioner, std::size_t numThreads)
+        {
+            std::size_t const N = static_cast<std::size_t>(A.numRows);
+            LogAssert(
+                N > 0 && A.offsets.size() == N + 1,
+                "Invalid matrix.");
+
+            std::vector<Real> diagonal{};
+            CSRMatrix factor{};
+            if (preconditioner == Preconditioner::JACOBI)
+            {
+                diagonal.resize(N);
+                for (std::size_t i = 0; i < N; ++i)
+                {
+                    Real const d = GetDiagonal(A, i);
+                    LogAssert(
+                        d != static_cast<Real>(0),
+                        "The diagonal entries must be nonzero.");
+                    diagonal[i] = static_cast<Real>(1) / d;
+                }
+            }
+            else if (preconditioner == Preconditioner::INCOMPLETE_CHOLESKY)
+            {
+                CreateIncompleteCholesky(A, factor);
+            }
+
+            std::vector<Real> tmpR(N), tmpZ, tmpP(N), tmpW(N);
+            Real* R = tmpR.data();
+            Real* P = tmpP.data();
+            Real* W = tmpW.data();
+            Real* Z = R;
+            if (preconditioner != Preconditioner::NONE)
+            {
+                tmpZ.resize(N);
+                Z = tmpZ.data();
+            }
+
+            // The inner products are accumulated per block of rows.
+            std::size_t const numBlocks = (N + blockSize - 1) / blockSize;
+            std::vector<Real> partialPW(numBlocks), partialRZ(numBlocks);
+            std::vector<Real> partialRR(numBlocks), partialBB(numBlocks);
+            numThreads = std::max(std::min(numThreads, numBlocks), static_cast<std::size_t>(1));
+            Barrier barrier(numThreads);
+            uint32_t numIterations = 0;
+
+            auto solve = [&](std::size_t t)
+            {
+                std::size_t const bMin = t * numBlocks / numThreads;
+                std::size_t const bSup = (t + 1) * numBlocks / numThreads;
+                std::size_t const iMin = bMin * blockSize;
+                std::size_t const iSup = std::min(bSup * blockSize, N);
+
+                auto applyPreconditioner = [&]()
+                {
+                    if (preconditioner == Preconditioner::JACOBI)
+                    {
+                        for (std::size_t i = iMin; i < iSup; ++i)
+                        {
+                            Z[i] = diagonal[i] * R[i];
+                        }
+                    }
+                    else if (preconditioner == Preconditioner::INCOMPLETE_CHOLESKY)
+                    {
+                        barrier.Wait();
+                        if (t == 0)
+                        {
+                            SolveIncompleteCholesky(factor, R, Z);
+                        }
+                        barrier.Wait();
+                    }
+                };
+
+                // Compute the sums over the blocks of this thread's rows of
+                // R*Z and R*R.
+                auto computeResidualProducts = [&]()
+                {
+                    for (std::size_t b = bMin; b < bSup; ++b)
+                    {
+                        std::size_t const i0 = b * blockSize;
+                        std::size_t const i1 = std::min(i0 + blockSize, N);
+                        partialRZ[b] = Dot(R, Z, i0, i1);
+                        partialRR[b] = Dot(R, R, i0, i1);
+                    }
+                };
+
+                // The initial guess is X = 0, so R = B.
+                for (std::size_t i = iMin; i < iSup; ++i)
+                {
+                    X[i] = static_cast<Real>(0);
+                    R[i] = B[i];
+                }
+                for (std::size_t b = bMin; b < bSup; ++b)
+                {
+                    std::size_t const i0 = b * blockSize;
+                    std::size_t const i1 = std::min(i0 + blockSize, N);
+                    partialBB[b] = Dot(B, B, i0, i1);
+                }
+                applyPreconditioner();
+                for (std::size_t i = iMin; i < iSup; ++i)
+                {
+                    P[i] = Z[i];
+                }
+                computeResidualProducts();
+                barrier.Wait();
+
+                Real const threshold = tolerance * std::sqrt(Sum(partialBB));
+                Real rho = Sum(partialRZ);
+                Real rr = Sum(partialRR);
+                uint32_t iteration = 0;
+                while (std::sqrt(rr) > threshold && iteration < maxIterations)
+                {
+                    ++iteration;
+
+                    // W = A*P. All of P must be updated before the product.
+                    barrier.Wait();
+                    for (std::size_t b = bMin; b < bSup; ++b)
+                    {
+                        std::size_t const i0 = b * blockSize;
+                        std::size_t const i1 = std::min(i0 + blockSize, N);
+                        Mul(A, P, W, i0, i1);
+                        partialPW[b] = Dot(P, W, i0, i1);
+                    }
+                    barrier.Wait();
+
+                    Real const alpha = rho / Sum(partialPW);
+                    UpdateX(X, alpha, P, iMin, iSup);
+                    UpdateR(R, alpha, W, iMin, iSup);
+                    applyPreconditioner();
+                    computeResidualProducts();
+                    barrier.Wait();
+
+                    Real const rhoNext = Sum(partialRZ);
+                    rr = Sum(partialRR);
+                    Real const beta = rhoNext / rho;
+                    rho = rhoNext;
+                    UpdateP(P, beta, Z, iMin, iSup);
+                }
+
+                if (t == 0)
+                {
+                    numIterations = iteration;
+                }
+            };
+
+            if (numThreads == 1)
+            {
+                solve(0);
+            }
+            else
+            {
+                std::vector<std::thread> process(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t] = std::thread(solve, t);
+                }
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+            return numIterations;
         }
 
     private:
@@ -304,22 +615,6 @@ namespace gte
             }
         }
 
-        static void Mul(int32_t N, SparseMatrix const& A, Real const* X, Real* P)
-        {
-            std::memset(P, 0, N * sizeof(Real));
-            for (auto const& element : A)
-            {
-                int32_t i = element.first[0];
-                int32_t j = element.first[1];
-                Real value = element.second;
-                P[i] += value * X[j];
-                if (i != j)
-                {
-                    P[j] += value * X[i];
-                }
-            }
-        }
-
         static void UpdateX(int32_t N, Real* X, Real alpha, Real const* P)
         {
             for (int32_t i = 0; i < N; ++i)
@@ -343,6 +638,236 @@ namespace gte
                 P[i] = R[i] + beta * P[i];
             }
         }
+
+        // Support for the CSR conjugate gradient method. The kernels operate
+        // on the rows [iMin,iSup).
+        static std::size_t constexpr blockSize = 4096;
+
+        // A reusable barrier for the threads of the CSR solver.
+        class Barrier
+        {
+        public:
+            Barrier(std::size_t numThreads)
+                :
+                mNumThreads(numThreads),
+                mNumWaiting(0),
+                mGeneration(0),
+                mMutex{},
+                mCondition{}
+            {
+            }
+
+            void Wait()
+            {
+                if (mNumThreads <= 1)
+                {
+                    return;
+                }
+
+                std::unique_lock<std::mutex> lock(mMutex);
+                std::size_t const generation = mGeneration;
+                if (++mNumWaiting == mNumThreads)
+                {
+                    mNumWaiting = 0;
+                    ++mGeneration;
+                    mCondition.notify_all();
+                }
+                else
+                {
+                    mCondition.wait(lock, [this, generation]() { return generation != mGeneration; });
+                }
+            }
+
+        private:
+            std::size_t mNumThreads, mNumWaiting, mGeneration;
+            std::mutex mMutex;
+            std::condition_variable mCondition;
+        };
+
+        // The products are accumulated in four interleaved sums, which
+        // breaks the dependency between the additions so that the loop can
+        // be vectorized without reassociating floating-point operations.
+        static Real Dot(Real const* U, Real const* V, std::size_t iMin, std::size_t iSup)
+        {
+            std::array<Real, 4> dot{ static_cast<Real>(0), static_cast<Real>(0),
+                static_cast<Real>(0), static_cast<Real>(0) };
+            std::size_t i = iMin;
+            for (; i + 4 <= iSup; i += 4)
+            {
+                dot[0] += U[i] * V[i];
+                dot[1] += U[i + 1] * V[i + 1];
+                dot[2] += U[i + 2] * V[i + 2];
+                dot[3] += U[i + 3] * V[i + 3];
+            }
+            for (; i < iSup; ++i)
+            {
+                dot[0] += U[i] * V[i];
+            }
+            return (dot[0] + dot[1]) + (dot[2] + dot[3]);
+        }
+
+        static Real Sum(std::vector<Real> const& partial)
+        {
+            Real sum = static_cast<Real>(0);
+            for (auto const& value : partial)
+            {
+                sum += value;
+            }
+            return sum;
+        }
+
+        static void Mul(CSRMatrix const& A, Real const* X, Real* P,
+            std::size_t iMin, std::size_t iSup)
+        {
+            std::size_t const* offsets = A.offsets.data();
+            int32_t const* columns = A.columns.data();
+            Real const* values = A.values.data();
+            for (std::size_t i = iMin; i < iSup; ++i)
+            {
+                Real sum = static_cast<Real>(0);
+                for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k)
+                {
+                    sum += values[k] * X[columns[k]];
+                }
+                P[i] = sum;
+            }
+        }
+
+        static void UpdateX(Real* X, Real alpha, Real const* P,
+            std::size_t iMin, std::size_t iSup)
+        {
+            for (std::size_t i = iMin; i < iSup; ++i)
+            {
+                X[i] += alpha * P[i];
+            }
+        }
+
+        static void UpdateR(Real* R, Real alpha, Real const* W,
+            std::size_t iMin, std::size_t iSup)
+        {
+            for (std::size_t i = iMin; i < iSup; ++i)
+            {
+                R[i] -= alpha * W[i];
+            }
+        }
+
+        static void UpdateP(Real* P, Real beta, Real const* Z,
+            std::size_t iMin, std::size_t iSup)
+        {
+            for (std::size_t i = iMin; i < iSup; ++i)
+            {
+                P[i] = Z[i] + beta * P[i];
+            }
+        }
+
+        static Real GetDiagonal(CSRMatrix const& A, std::size_t i)
+        {
+            for (std::size_t k = A.offsets[i]; k < A.offsets[i + 1]; ++k)
+            {
+                if (A.columns[k] == static_cast<int32_t>(i))
+                {
+                    return A.values[k];
+                }
+            }
+            return static_cast<Real>(0);
+        }
+
+        // Compute the IC(0) factor L, stored by rows in CSR form. The
+        // columns of row i are those of the lower triangle of A, the last
+        // one being the diagonal i.
+        static void CreateIncompleteCholesky(CSRMatrix const& A, CSRMatrix& L)
+        {
+            std::size_t const N = static_cast<std::size_t>(A.numRows);
+            L.numRows = A.numRows;
+            L.offsets.assign(N + 1, 0);
+            L.columns.clear();
+            L.values.clear();
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                for (std::size_t k = A.offsets[i]; k < A.offsets[i + 1]; ++k)
+                {
+                    if (A.columns[k] <= static_cast<int32_t>(i))
+                    {
+                        L.columns.push_back(A.columns[k]);
+                        L.values.push_back(A.values[k]);
+                    }
+                }
+                L.offsets[i + 1] = L.columns.size();
+                LogAssert(
+                    L.offsets[i + 1] > L.offsets[i] &&
+                    L.columns[L.offsets[i + 1] - 1] == static_cast<int32_t>(i),
+                    "The diagonal entries must be stored.");
+            }
+
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                std::size_t const kMin = L.offsets[i];
+                std::size_t const kDiagonal = L.offsets[i + 1] - 1;
+                for (std::size_t k = kMin; k < kDiagonal; ++k)
+                {
+                    // L(i,j) = (A(i,j) - sum_{m<j} L(i,m)*L(j,m)) / L(j,j)
+                    // with both rows sorted by column.
+                    std::size_t const j = static_cast<std::size_t>(L.columns[k]);
+                    std::size_t const mDiagonal = L.offsets[j + 1] - 1;
+                    Real sum = L.values[k];
+                    for (std::size_t ki = kMin, kj = L.offsets[j]; ki < k && kj < mDiagonal; )
+                    {
+                        if (L.columns[ki] < L.columns[kj])
+                        {
+                            ++ki;
+                        }
+                        else if (L.columns[ki] > L.columns[kj])
+                        {
+                            ++kj;
+                        }
+                        else
+                        {
+                            sum -= L.values[ki++] * L.values[kj++];
+                        }
+                    }
+                    L.values[k] = sum / L.values[mDiagonal];
+                }
+
+                Real const a = L.values[kDiagonal];
+                Real d = a;
+                for (std::size_t k = kMin; k < kDiagonal; ++k)
+                {
+                    d -= L.values[k] * L.values[k];
+                }
+                if (d <= static_cast<Real>(0))
+                {
+                    d = (a > static_cast<Real>(0) ? a : static_cast<Real>(1));
+                }
+                L.values[kDiagonal] = std::sqrt(d);
+            }
+        }
+
+        // Solve L*L^T*Z = R.
+        static void SolveIncompleteCholesky(CSRMatrix const& L, Real const* R, Real* Z)
+        {
+            std::size_t const N = static_cast<std::size_t>(L.numRows);
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                std::size_t const kDiagonal = L.offsets[i + 1] - 1;
+                Real sum = R[i];
+                for (std::size_t k = L.offsets[i]; k < kDiagonal; ++k)
+                {
+                    sum -= L.values[k] * Z[L.columns[k]];
+                }
+                Z[i] = sum / L.values[kDiagonal];
+            }
+
+            for (std::size_t i = N; i-- > 0; )
+            {
+                std::size_t const kDiagonal = L.offsets[i + 1] - 1;
+                Z[i] /= L.values[kDiagonal];
+                Real const z = Z[i];
+                for (std::size_t k = L.offsets[i]; k < kDiagonal; ++k)
+                {
+                    Z[L.columns[k]] -= L.values[k] * z;
+                }
+            }
+        }
     };
 }
 
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2025.05.10
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -32,6 +32,11 @@
 // primitives into two subsets of equal size or absolute size difference of 1.
 // This leads to a balanced tree, which is helpful for performance of tree
 // traversals.
+//
+// The Create function with a numThreads parameter builds the top levels of
+// the tree in the main thread until there are at least numThreads subtrees,
+// and those subtrees are then built in parallel. The tree is the same as the
+// one built by the other Create function.
 
 #include <Mathematics/BitHacks.h>
 #include <Mathematics/SymmetricEigensolver3x3.h>
@@ -43,6 +48,7 @@
 #include <cstdint>
 #include <limits>
 #include <numeric>
+#include <thread>
 #include <vector>
 
 namespace gte
@@ -76,7 +82,9 @@ namespace gte
             mCentroids{},
             mHeight(0),
             mNodes{},
-            mPartition{}
+            mPartition{},
+            mDeferDepth(std::numeric_limits<size_t>::max()),
+            mDeferred{}
         {
         }
 
@@ -91,42 +99,20 @@ namespace gte
             std::vector<Vector3<T>> const& centroids,
             size_t height)
         {
-            LogAssert(centroids.size() > 0, "Invalid input.");
-            mCentroids = centroids;
-
-            if (height == std::numeric_limits<size_t>::max())
-            {
-                uint64_t minPowerOfTwo = BitHacks::RoundUpToPowerOfTwo(
-                    static_cast<uint32_t>(mCentroids.size()));
-                uint32_t logMinPowerOfTwo = BitHacks::Log2OfPowerOfTwo(
-                    static_cast<uint32_t>(minPowerOfTwo));
-                mHeight = static_cast<size_t>(logMinPowerOfTwo);
-            }
-            else
-            {
-                mHeight = std::min(height, static_cast<size_t>(31));
-            }
-
-            // The tree is built recursively. A reference to an OBBNode is
-            // passed to BuildTree and nodes are appended to a std::vector.
-            // Because the references are on the stack, we must guarantee
-            // that no reallocations occur in order to avoid invalidating
-            // references.
-            size_t const numNodes = (static_cast<size_t>(1) << (mHeight + 1)) - 1;
-            mNodes.resize(numNodes);
-
-            // The array mPartition stores indices into mCentroids so that at
-            // a node, the centroids represented by the node are the indices
-            // [mPartition[node.minIndex], mPartition[node.maxIndex]].
-            mPartition.resize(mCentroids.size());
-            std::iota(mPartition.begin(), mPartition.end(), 0);
+            CreateTree(centroids, height, 0);
+        }
 
-            // Build the tree recursively.
-            size_t const depth = 0;
-            size_t const nodeIndex = 0;
-            size_t const i0 = 0;
-            size_t const i1 = mCentroids.size() - 1;
-            BuildTree(depth, nodeIndex, i0, i1);
+        // Set numThreads to 0 or 1 to build in the main thread. Set
+        // numThreads to 2 or larger to build independent subtrees in
+        // parallel. The derived-class overrides of ComputeInteriorBox and
+        // ComputeLeafBox are called concurrently for disjoint subtrees, so
+        // they must not modify shared state.
+        void Create(
+            std::vector<Vector3<T>> const& centroids,
+            size_t height,
+            size_t numThreads)
+        {
+            CreateTree(centroids, height, numThreads);
         }
 
         // Member access.
@@ -212,8 +198,94 @@ namespace gte
         std::vector<size_t> mPartition;
 
     private:
+        void CreateTree(
+            std::vector<Vector3<T>> const& centroids,
+            size_t height,
+            size_t numThreads)
+        {
+            LogAssert(centroids.size() > 0, "Invalid input.");
+            mCentroids = centroids;
+
+            if (height == std::numeric_limits<size_t>::max())
+            {
+                uint64_t minPowerOfTwo = BitHacks::RoundUpToPowerOfTwo(
+                    static_cast<uint32_t>(mCentroids.size()));
+                uint32_t logMinPowerOfTwo = BitHacks::Log2OfPowerOfTwo(
+                    static_cast<uint32_t>(minPowerOfTwo));
+                mHeight = static_cast<size_t>(logMinPowerOfTwo);
+            }
+            else
+            {
+                mHeight = std::min(height, static_cast<size_t>(31));
+            }
+
+            // The tree is built recursively. A reference to an OBBNode is
+            // passed to BuildTree and nodes are appended to a std::vector.
+            // Because the references are on the stack, we must guarantee
+            // that no reallocations occur in order to avoid invalidating
+            // references.
+            size_t const numNodes = (static_cast<size_t>(1) << (mHeight + 1)) - 1;
+            mNodes.resize(numNodes);
+
+            // The array mPartition stores indices into mCentroids so that at
+            // a node, the centroids represented by the node are the indices
+            // [mPartition[node.minIndex], mPartition[node.maxIndex]].
+            mPartition.resize(mCentroids.size());
+            std::iota(mPartition.begin(), mPartition.end(), 0);
+
+            // Build the tree recursively.
+            size_t const depth = 0;
+            size_t const nodeIndex = 0;
+            size_t const i0 = 0;
+            size_t const i1 = mCentroids.size() - 1;
+            if (numThreads <= 1)
+            {
+                BuildTree(depth, nodeIndex, i0, i1);
+                return;
+            }
+
+            // Build the tree in the main thread down to the smallest depth
+            // that has at least numThreads nodes. The subtrees rooted at
+            // that depth are deferred and then built in parallel.
+            mDeferDepth = 0;
+            while ((static_cast<size_t>(1) << mDeferDepth) < numThreads &&
+                mDeferDepth < mHeight)
+            {
+                ++mDeferDepth;
+            }
+            mDeferred.clear();
+            BuildTree(depth, nodeIndex, i0, i1);
+            mDeferDepth = std::numeric_limits<size_t>::max();
+
+            numThreads = std::min(numThreads, mDeferred.size());
+            std::vector<std::thread> process(numThreads);
+            for (size_t t = 0; t < numThreads; ++t)
+            {
+                process[t] = std::thread([this, t, numThreads]()
+                {
+                    for (size_t j = t; j < mDeferred.size(); j += numThreads)
+                    {
+                        auto const& subtree = mDeferred[j];
+                        BuildTree(subtree[0], subtree[1], subtree[2], subtree[3]);
+                    }
+                });
+            }
+            for (size_t t = 0; t < numThreads; ++t)
+            {
+                process[t].join();
+            }
+            mDeferred.clear();
+        }
+
         void BuildTree(size_t depth, size_t nodeIndex, size_t i0, size_t i1)
         {
+            if (depth == mDeferDepth)
+            {
+                // The subtree is built later by a worker thread.
+                mDeferred.push_back({ depth, nodeIndex, i0, i1 });
+                return;
+            }
+
             auto& node = mNodes[nodeIndex];
             node.minIndex = i0;
             node.maxIndex = i1;
@@ -308,6 +380,10 @@ namespace gte
                 mPartition[--j1] = info[k].pointIndex;
             }
         }
+
+        // Subtrees (depth, nodeIndex, i0, i1) deferred for parallel builds.
+        size_t mDeferDepth;
+        std::vector<std::array<size_t, 4>> mDeferred;
     };
 }
 
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2025.05.10
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -42,6 +42,17 @@ namespace gte
             OBBTree<T>::Create(points, height);
         }
 
+        // Build the tree with the parallel construction described in
+        // OBBTree.h. Set numThreads to 0 or 1 to build in the main thread.
+        // Set numThreads to 2 or larger to build subtrees in parallel.
+        void Create(
+            std::vector<Vector3<T>> const& points,
+            size_t height,
+            size_t numThreads)
+        {
+            OBBTree<T>::Create(points, height, numThreads);
+        }
+
         // Member access.
         inline std::vector<Vector3<T>> const& GetPoints() const
         {
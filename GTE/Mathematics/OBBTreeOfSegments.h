@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2025.05.10
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -46,19 +46,34 @@ namespace gte
             mVertices = vertices;
             mSegments = segments;
 
-            // Compute the triangle centroids.
-            std::vector<Vector3<T>> centroids(mSegments.size());
-            T const half = static_cast<T>(0.5);
-            for (size_t i = 0; i < mSegments.size(); ++i)
-            {
-                auto const& seg = mSegments[i];
-                centroids[i] = half * (mVertices[seg[0]] + mVertices[seg[1]]);
-            }
+            std::vector<Vector3<T>> centroids = ComputeCentroids();
 
             // Create the OBB tree for centroids.
             OBBTree<T>::Create(centroids, height);
         }
 
+        // Build the tree with the parallel construction described in
+        // OBBTree.h. Set numThreads to 0 or 1 to build in the main thread.
+        // Set numThreads to 2 or larger to build subtrees in parallel.
+        void Create(
+            std::vector<Vector3<T>> const& vertices,
+            std::vector<std::array<size_t, 2>> const& segments,
+            size_t height,
+            size_t numThreads)
+        {
+            LogAssert(
+                vertices.size() >= 2 && segments.size() > 0,
+                "Invalid input.");
+
+            mVertices = vertices;
+            mSegments = segments;
+
+            std::vector<Vector3<T>> centroids = ComputeCentroids();
+
+            // Create the OBB tree for centroids.
+            OBBTree<T>::Create(centroids, height, numThreads);
+        }
+
         // Member access.
         inline std::vector<Vector3<T>> const& GetVertices() const
         {
@@ -71,6 +86,18 @@ namespace gte
         }
 
     private:
+        std::vector<Vector3<T>> ComputeCentroids() const
+        {
+            std::vector<Vector3<T>> centroids(mSegments.size());
+            T const half = static_cast<T>(0.5);
+            for (size_t i = 0; i < mSegments.size(); ++i)
+            {
+                auto const& seg = mSegments[i];
+                centroids[i] = half * (mVertices[seg[0]] + mVertices[seg[1]]);
+            }
+            return centroids;
+        }
+
         // Let C be the box center and let U0, U1 and U2 be the box axes.
         // Each input point is of the form X = C + y0*U0 + y1*U1 + y2*U2.
         // The following code computes min(y0), max(y0), min(y1), max(y1),
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2026.08.01
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -57,19 +57,34 @@ namespace gte
             mVertices = vertices;
             mTriangles = triangles;
 
-            // Compute the triangle centroids.
-            std::vector<Vector3<T>> centroids(mTriangles.size());
-            T const three = static_cast<T>(3);
-            for (size_t t = 0; t < mTriangles.size(); ++t)
-            {
-                auto const& tri = mTriangles[t];
-                centroids[t] = (mVertices[tri[0]] + mVertices[tri[1]] + mVertices[tri[2]]) / three;
-            }
+            std::vector<Vector3<T>> centroids = ComputeCentroids();
 
             // Create the OBB tree for centroids.
             OBBTree<T>::Create(centroids, height);
         }
 
+        // Build the tree with the parallel construction described in
+        // OBBTree.h. Set numThreads to 0 or 1 to build in the main thread.
+        // Set numThreads to 2 or larger to build subtrees in parallel.
+        void Create(
+            std::vector<Vector3<T>> const& vertices,
+            std::vector<std::array<size_t, 3>> const& triangles,
+            size_t height,
+            size_t numThreads)
+        {
+            LogAssert(
+                vertices.size() >= 3 && triangles.size() > 0,
+                "Invalid input.");
+
+            mVertices = vertices;
+            mTriangles = triangles;
+
+            std::vector<Vector3<T>> centroids = ComputeCentroids();
+
+            // Create the OBB tree for centroids.
+            OBBTree<T>::Create(centroids, height, numThreads);
+        }
+
         // Member access.
         inline std::vector<Vector3<T>> const& GetVertices() const
         {
@@ -82,6 +97,18 @@ namespace gte
         }
 
     private:
+        std::vector<Vector3<T>> ComputeCentroids() const
+        {
+            std::vector<Vector3<T>> centroids(mTriangles.size());
+            T const three = static_cast<T>(3);
+            for (size_t t = 0; t < mTriangles.size(); ++t)
+            {
+                auto const& tri = mTriangles[t];
+                centroids[t] = (mVertices[tri[0]] + mVertices[tri[1]] + mVertices[tri[2]]) / three;
+            }
+            return centroids;
+        }
+
         // Let C be the box center and let U0, U1 and U2 be the box axes.
         // Each input point is of the form X = C + y0*U0 + y1*U1 + y2*U2.
         // The following code computes min(y0), max(y0), min(y1), max(y1),
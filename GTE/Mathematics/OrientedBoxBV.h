@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.3.2026.08.08
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -13,7 +13,10 @@
 #include <Mathematics/IntrLine3OrientedBox3.h>
 #include <Mathematics/IntrRay3OrientedBox3.h>
 #include <Mathematics/IntrSegment3OrientedBox3.h>
+#include <Mathematics/IntrOrientedBox3OrientedBox3.h>
+#include <Mathematics/Matrix3x3.h>
 #include <cstddef>
+#include <cstdint>
 
 namespace gte
 {
@@ -78,6 +81,44 @@ namespace gte
             return output.intersect;
         }
 
+        // Test for overlap of bounding volumes in the same coordinate
+        // system.
+        static bool Overlap(
+            OrientedBoxBV<T> const& boundingVolume0,
+            OrientedBoxBV<T> const& boundingVolume1)
+        {
+            TIQuery<T, OrientedBox3<T>, OrientedBox3<T>> query{};
+            auto output = query(boundingVolume0.box, boundingVolume1.box);
+            return output.intersect;
+        }
+
+        // Test for overlap when boundingVolume1 is transformed by the rigid
+        // motion X' = rotate * X + translate.
+        static bool Overlap(
+            OrientedBoxBV<T> const& boundingVolume0,
+            OrientedBoxBV<T> const& boundingVolume1,
+            Matrix3x3<T> const& rotate,
+            Vector3<T> const& translate)
+        {
+            OrientedBox3<T> box1 = boundingVolume1.box;
+            box1.center = rotate * box1.center + translate;
+            for (std::int32_t i = 0; i < 3; ++i)
+            {
+                box1.axis[i] = rotate * box1.axis[i];
+            }
+
+            TIQuery<T, OrientedBox3<T>, OrientedBox3<T>> query{};
+            auto output = query(boundingVolume0.box, box1);
+            return output.intersect;
+        }
+
+        T GetSurfaceArea() const
+        {
+            T const eight = static_cast<T>(8);
+            auto const& e = box.extent;
+            return eight * (e[0] * e[1] + e[1] * e[2] + e[2] * e[0]);
+        }
+
         OrientedBox3<T> box;
     };
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.3.2026.08.08
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -78,7 +78,7 @@ namespace gte
                 minIndex = 1;
             }
             absExtent = std::fabs(box.extent[2]);
-            if (absExtent > minAbsExtent)
+            if (absExtent < minAbsExtent)
             {
                 minAbsExtent = absExtent;
                 minIndex = 2;
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2026.08.11
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -46,11 +46,14 @@ extern void RootsLowDegreeBlock(int32_t);
 #define GTE_ROOTS_LOW_DEGREE_BLOCK(block)
 #endif
 
+#include <Mathematics/Logger.h>
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <map>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -333,6 +336,140 @@ namespace gte
             return true;
         }
 
+        // Find the roots on (-infinity,+infinity) for many polynomials. The
+        // polynomial i has degree degrees[i] >= 1. Its coefficients are
+        // stored contiguously in 'coefficients' starting at the index that
+        // is the sum of degrees[j]+1 for j < i. Its roots are stored
+        // contiguously in 'roots' starting at the index that is the sum of
+        // degrees[j] for j < i, and numRoots[i] is the number of roots. The
+        // outputs for polynomial i are the same as those of the function
+        // Find(degrees[i], c, maxIterations, roots).
+        //
+        // The polynomials are grouped by degree after the leading zero
+        // coefficients are discarded, and each group is processed in sets
+        // of numBatchLanes polynomials. Within a set, the derivatives, the
+        // Cauchy bounds and the polynomial evaluations of FindRecursive are
+        // loops over the polynomials. For each derivative order, the
+        // intervals of the set that require bisection are packed into
+        // blocks of numBatchLanes intervals, and the bisection steps for a
+        // block are loops without branches, so the compiler can vectorize
+        // them. The bisection updates are selections, which are vectorized
+        // only when the target has vector blend or mask instructions (for
+        // example, GCC with -O3 -mavx2 or with -O2 -mavx512f). Without
+        // vectorization, the scalar Find can be faster. The outputs do not
+        // depend on vectorization, because each step performs the same
+        // floating-point operations as the scalar code.
+        //
+        // Set numThreads to 0 or 1 to execute in the main thread. Set
+        // numThreads to 2 or larger to distribute the sets among that many
+        // threads. The results do not depend on the number of threads.
+        static std::size_t constexpr numBatchLanes = 16;
+
+        static void FindBatch(std::size_t numPolynomials, int32_t const* degrees,
+            Real const* coefficients, uint32_t maxIterations, Real* roots,
+            int32_t* numRoots, std::size_t numThreads = 0)
+        {
+            LogAssert(
+                numPolynomials == 0 || (degrees && coefficients && roots && numRoots),
+                "Invalid input.");
+
+            // Compute the offsets into the coefficient and root arrays and
+            // group the polynomials by degree. The polynomials of degree 0
+            // or that are identically zero are handled here.
+            Real const zero = static_cast<Real>(0);
+            std::vector<std::size_t> cOffsets(numPolynomials), rOffsets(numPolynomials);
+            std::vector<std::vector<std::size_t>> groups{};
+            std::size_t cOffset = 0, rOffset = 0;
+            for (std::size_t i = 0; i < numPolynomials; ++i)
+            {
+                int32_t degree = degrees[i];
+                LogAssert(
+                    degree >= 1,
+                    "Invalid degree.");
+
+                Real const* c = coefficients + cOffset;
+                cOffsets[i] = cOffset;
+                rOffsets[i] = rOffset;
+                cOffset += static_cast<std::size_t>(degree) + 1;
+                rOffset += static_cast<std::size_t>(degree);
+
+                while (degree >= 0 && c[degree] == zero)
+                {
+                    --degree;
+                }
+
+                if (degree > 0)
+                {
+                    if (groups.size() <= static_cast<std::size_t>(degree))
+                    {
+                        groups.resize(static_cast<std::size_t>(degree) + 1);
+                    }
+                    groups[degree].push_back(i);
+                }
+                else if (degree == 0)
+                {
+                    // The polynomial is a nonzero constant.
+                    numRoots[i] = 0;
+                }
+                else
+                {
+                    // The polynomial is identically zero.
+                    roots[rOffsets[i]] = zero;
+                    numRoots[i] = 1;
+                }
+            }
+
+            // Each set is the degree and the index into groups[degree] of
+            // its first polynomial.
+            std::vector<std::pair<int32_t, std::size_t>> sets{};
+            for (std::size_t degree = 1; degree < groups.size(); ++degree)
+            {
+                for (std::size_t first = 0; first < groups[degree].size(); first += numBatchLanes)
+                {
+                    sets.push_back(std::make_pair(static_cast<int32_t>(degree), first));
+                }
+            }
+
+            // The sets of the higher-degree polynomials are more expensive,
+            // so the sets are interleaved among the threads.
+            auto processSets = [&groups, &sets, coefficients, &cOffsets,
+                maxIterations, roots, &rOffsets, numRoots](std::size_t t, std::size_t numT)
+            {
+                BatchStorage storage{};
+                for (std::size_t s = t; s < sets.size(); s += numT)
+                {
+                    std::vector<std::size_t> const& group = groups[sets[s].first];
+                    std::size_t const first = sets[s].second;
+                    std::size_t const count = std::min(group.size() - first,
+                        static_cast<std::size_t>(numBatchLanes));
+                    FindBatchSet(sets[s].first, &group[first], count, coefficients,
+                        cOffsets.data(), maxIterations, roots, rOffsets.data(),
+                        numRoots, storage);
+                }
+            };
+
+            numThreads = std::min(numThreads, sets.size());
+            if (numThreads <= 1)
+            {
+                processSets(0, 1);
+            }
+            else
+            {
+                std::vector<std::thread> process(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t] = std::thread([&processSets, t, numThreads]()
+                    {
+                        processSets(t, numThreads);
+                    });
+                }
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+        }
+
     private:
         // Support for the Solve* functions.
         template <typename Rational>
@@ -1008,6 +1145,363 @@ namespace gte
             }
         }
 
+        // Support for the FindBatch function. The arrays of a set store the
+        // values for coefficient or root i of lane l at index
+        // i * numBatchLanes + l. The coefficients of the polynomial of
+        // degree k and of its scaled derivatives are stored starting at
+        // index (k * (k + 1) / 2 - 1) * numBatchLanes.
+        typedef std::array<Real, numBatchLanes> Lanes;
+
+        struct BatchStorage
+        {
+            BatchStorage()
+                :
+                coefficients{},
+                derivRoots{},
+                roots{},
+                tmin{},
+                tmax{},
+                pmin{},
+                pmax{},
+                found{},
+                taskCoefficients{},
+                taskTMin{},
+                taskTMax{},
+                taskPMin{},
+                taskRoot{},
+                taskIndex{}
+            {
+            }
+
+            // The polynomials and the roots of the derivatives.
+            std::vector<Real> coefficients, derivRoots, roots;
+
+            // The intervals for the roots of a polynomial, interval j of
+            // lane l stored at index j * numBatchLanes + l.
+            std::vector<Real> tmin, tmax, pmin, pmax;
+            std::vector<uint8_t> found;
+
+            // The intervals that require bisection, packed into blocks of
+            // numBatchLanes tasks. Coefficient i of task l of block b is
+            // stored at index (b * (k + 1) + i) * numBatchLanes + l.
+            std::vector<Real> taskCoefficients, taskTMin, taskTMax, taskPMin, taskRoot;
+            std::vector<std::size_t> taskIndex;
+        };
+
+        static void FindBatchSet(int32_t degree, std::size_t const* indices,
+            std::size_t count, Real const* coefficients, std::size_t const* cOffsets,
+            uint32_t maxIterations, Real* roots, std::size_t const* rOffsets,
+            int32_t* numRoots, BatchStorage& storage)
+        {
+            std::size_t const L = numBatchLanes;
+            std::size_t const D = static_cast<std::size_t>(degree);
+            Real const zero = static_cast<Real>(0);
+            Real const one = static_cast<Real>(1);
+
+            // The unused lanes of a set process a copy of the polynomial in
+            // lane 0.
+            storage.coefficients.resize(((D + 1) * (D + 2) / 2 - 1) * L);
+            storage.derivRoots.resize(D * L);
+            storage.roots.resize(D * L);
+            Real* c = &storage.coefficients[(D * (D + 1) / 2 - 1) * L];
+            for (std::size_t l = 0; l < L; ++l)
+            {
+                Real const* input = coefficients + cOffsets[indices[l < count ? l : 0]];
+                for (std::size_t i = 0; i <= D; ++i)
+                {
+                    c[i * L + l] = input[i];
+                }
+            }
+
+            // Compute the Cauchy bound.
+            Lanes tmin{}, tmax{}, invLeading{}, maxValue{};
+            for (std::size_t l = 0; l < L; ++l)
+            {
+                invLeading[l] = one / c[D * L + l];
+                maxValue[l] = zero;
+            }
+            for (std::size_t i = 0; i < D; ++i)
+            {
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    Real const value = std::fabs(c[i * L + l] * invLeading[l]);
+                    maxValue[l] = (value > maxValue[l] ? value : maxValue[l]);
+                }
+            }
+            for (std::size_t l = 0; l < L; ++l)
+            {
+                tmax[l] = one + maxValue[l];
+                tmin[l] = -tmax[l];
+            }
+
+            // Compute the derivatives scaled by 1/degree as in
+            // FindRecursive.
+            for (std::size_t k = D; k >= 2; --k)
+            {
+                Real const* ck = &storage.coefficients[(k * (k + 1) / 2 - 1) * L];
+                Real* ckm1 = &storage.coefficients[(k * (k - 1) / 2 - 1) * L];
+                for (std::size_t i = 0, ip1 = 1; i < k; ++i, ++ip1)
+                {
+                    for (std::size_t l = 0; l < L; ++l)
+                    {
+                        ckm1[i * L + l] = ck[ip1 * L + l] * static_cast<Real>(ip1) / static_cast<Real>(k);
+                    }
+                }
+            }
+
+            // The base of the recursion is the linear polynomial.
+            std::array<int32_t, numBatchLanes> numDerivRoots{};
+            Real* derivRoots = storage.derivRoots.data();
+            for (std::size_t l = 0; l < L; ++l)
+            {
+                Real const c0 = storage.coefficients[l];
+                Real const c1 = storage.coefficients[L + l];
+                Real const root = (c1 != zero ? -c0 / c1 : zero);
+                bool const hasRoot = (c1 != zero || c0 == zero);
+                numDerivRoots[l] = (hasRoot && tmin[l] <= root && root <= tmax[l] ? 1 : 0);
+                derivRoots[l] = root;
+            }
+
+            // The roots of the derivative of degree k-1 bound the roots of
+            // the polynomial of degree k.
+            Real* kRoots = storage.roots.data();
+            for (std::size_t k = 2; k <= D; ++k)
+            {
+                Real const* ck = &storage.coefficients[(k * (k + 1) / 2 - 1) * L];
+                FindBatchLevel(k, ck, tmin, tmax, numDerivRoots, derivRoots,
+                    maxIterations, kRoots, storage);
+                std::swap(derivRoots, kRoots);
+            }
+
+            for (std::size_t l = 0; l < count; ++l)
+            {
+                std::size_t const i = indices[l];
+                numRoots[i] = numDerivRoots[l];
+                for (int32_t r = 0; r < numDerivRoots[l]; ++r)
+                {
+                    roots[rOffsets[i] + static_cast<std::size_t>(r)] =
+                        derivRoots[static_cast<std::size_t>(r) * L + l];
+                }
+            }
+        }
+
+        // Find the roots of the polynomials of degree k using the roots of
+        // their derivatives. Interval j of lane l is bounded by derivative
+        // roots j-1 and j, where tmin replaces root -1 and tmax replaces
+        // root numDerivRoots[l]. The tests at the interval endpoints are
+        // those of the bisection function Find. The intervals that require
+        // bisection are packed into blocks so that the bisection steps are
+        // not wasted on intervals without roots. On return, numDerivRoots[l]
+        // is the number of roots of the polynomial in lane l.
+        static void FindBatchLevel(std::size_t k, Real const* c,
+            Lanes const& tmin, Lanes const& tmax,
+            std::array<int32_t, numBatchLanes>& numDerivRoots,
+            Real const* derivRoots, uint32_t maxIterations, Real* kRoots,
+            BatchStorage& storage)
+        {
+            std::size_t const L = numBatchLanes;
+            std::size_t const numIntervals = k * L;
+            Real const zero = static_cast<Real>(0);
+
+            storage.tmin.resize(numIntervals);
+            storage.tmax.resize(numIntervals);
+            storage.pmin.resize(numIntervals);
+            storage.pmax.resize(numIntervals);
+            storage.found.resize(numIntervals);
+            Real* t0 = storage.tmin.data();
+            Real* t1 = storage.tmax.data();
+            Real* p0 = storage.pmin.data();
+            Real* p1 = storage.pmax.data();
+            uint8_t* found = storage.found.data();
+
+            for (std::size_t j = 0; j < k; ++j)
+            {
+                std::size_t const q = j * L;
+                int32_t const jj = static_cast<int32_t>(j);
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    t0[q + l] = (j == 0 ? tmin[l] : derivRoots[q - L + l]);
+                    t1[q + l] = (jj == numDerivRoots[l] ? tmax[l] : derivRoots[q + l]);
+                }
+                EvaluateBatch(k, c, t0 + q, p0 + q);
+                EvaluateBatch(k, c, t1 + q, p1 + q);
+            }
+
+            // Determine the intervals with roots at their endpoints and the
+            // intervals that require bisection.
+            std::size_t numTasks = 0;
+            for (std::size_t j = 0, q = 0; j < k; ++j)
+            {
+                int32_t const jj = static_cast<int32_t>(j);
+                for (std::size_t l = 0; l < L; ++l, ++q)
+                {
+                    bool const valid = (jj <= numDerivRoots[l]);
+                    bool const bracketed = !(p0[q] * p1[q] > zero)
+                        && !(t0[q] >= t1[q]) && maxIterations > 0;
+                    bool const endpoint = (p0[q] == zero || p1[q] == zero);
+                    found[q] = (valid && (endpoint || bracketed) ? 1 : 0);
+                    if (valid && bracketed && !endpoint)
+                    {
+                        ++numTasks;
+                    }
+                }
+            }
+
+            // Pack the intervals that require bisection. The unused lanes of
+            // the last block are inactive. The roots at the endpoints are
+            // stored in p0.
+            std::size_t const numBlocks = (numTasks + L - 1) / L;
+            storage.taskCoefficients.assign(numBlocks * (k + 1) * L, zero);
+            storage.taskTMin.assign(numBlocks * L, zero);
+            storage.taskTMax.assign(numBlocks * L, zero);
+            storage.taskPMin.assign(numBlocks * L, zero);
+            storage.taskRoot.assign(numBlocks * L, zero);
+            storage.taskIndex.resize(numTasks);
+            for (std::size_t j = 0, q = 0, m = 0; j < k; ++j)
+            {
+                for (std::size_t l = 0; l < L; ++l, ++q)
+                {
+                    if (found[q])
+                    {
+                        if (p0[q] == zero)
+                        {
+                            p0[q] = t0[q];
+                        }
+                        else if (p1[q] == zero)
+                        {
+                            p0[q] = t1[q];
+                        }
+                        else
+                        {
+                            std::size_t const b = m / L, lane = m % L;
+                            for (std::size_t i = 0; i <= k; ++i)
+                            {
+                                storage.taskCoefficients[(b * (k + 1) + i) * L + lane] = c[i * L + l];
+                            }
+                            storage.taskTMin[m] = t0[q];
+                            storage.taskTMax[m] = t1[q];
+                            storage.taskPMin[m] = p0[q];
+                            storage.taskIndex[m] = q;
+                            ++m;
+                        }
+                    }
+                }
+            }
+
+            for (std::size_t b = 0; b < numBlocks; ++b)
+            {
+                std::size_t const m0 = b * L;
+                std::size_t const numActive = std::min(numTasks - m0, L);
+                BisectBatch(k, &storage.taskCoefficients[b * (k + 1) * L], numActive,
+                    &storage.taskTMin[m0], &storage.taskTMax[m0], &storage.taskPMin[m0],
+                    maxIterations, &storage.taskRoot[m0]);
+            }
+            for (std::size_t m = 0; m < numTasks; ++m)
+            {
+                p0[storage.taskIndex[m]] = storage.taskRoot[m];
+            }
+
+            // Store the roots of each lane in the order of the intervals.
+            std::array<int32_t, numBatchLanes> numKRoots{};
+            for (std::size_t j = 0, q = 0; j < k; ++j)
+            {
+                for (std::size_t l = 0; l < L; ++l, ++q)
+                {
+                    if (found[q])
+                    {
+                        kRoots[static_cast<std::size_t>(numKRoots[l]) * L + l] = p0[q];
+                        ++numKRoots[l];
+                    }
+                }
+            }
+            numDerivRoots = numKRoots;
+        }
+
+        // The lane-wise equivalent of the bisection of function Find for the
+        // first numActive lanes. The state is stored in local arrays and the
+        // flags are stored as 0 or 1 of type Real, which allows the compiler
+        // to use vector blend or mask instructions for the updates.
+        static void BisectBatch(std::size_t degree, Real const* c, std::size_t numActive,
+            Real const* inTMin, Real const* inTMax, Real const* inPMin,
+            uint32_t maxIterations, Real* outRoot)
+        {
+            std::size_t const L = numBatchLanes;
+            Real const zero = static_cast<Real>(0);
+            Real const one = static_cast<Real>(1);
+            Real const half = static_cast<Real>(0.5);
+
+            Lanes tmin{}, tmax{}, pmin{}, root{}, active{};
+            for (std::size_t l = 0; l < L; ++l)
+            {
+                tmin[l] = inTMin[l];
+                tmax[l] = inTMax[l];
+                pmin[l] = inPMin[l];
+                root[l] = zero;
+                active[l] = (l < numActive ? one : zero);
+            }
+
+            for (uint32_t i = 1; i <= maxIterations; ++i)
+            {
+                Lanes mid{}, p{};
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    mid[l] = half * (tmin[l] + tmax[l]);
+                }
+                EvaluateBatch(degree, c, mid.data(), p.data());
+
+                // The midpoint is strictly between tmin and tmax unless they
+                // are consecutive floating-point numbers.
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    Real const t = mid[l], t0 = tmin[l], t1 = tmax[l];
+                    Real const value = p[l], value0 = pmin[l], r = root[l];
+                    Real const product = value * value0;
+                    Real const proceed = (active[l] > zero && t > t0 && t < t1 ? one : zero);
+                    Real const moveMax = (proceed > zero && product < zero ? one : zero);
+                    Real const moveMin = (proceed > zero && product > zero ? one : zero);
+                    root[l] = (active[l] > zero ? t : r);
+                    tmax[l] = (moveMax > zero ? t : t1);
+                    tmin[l] = (moveMin > zero ? t : t0);
+                    pmin[l] = (moveMin > zero ? value : value0);
+                    active[l] = moveMax + moveMin;
+                }
+
+                Real anyActive = zero;
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    anyActive = (active[l] > anyActive ? active[l] : anyActive);
+                }
+                if (anyActive == zero)
+                {
+                    break;
+                }
+            }
+
+            for (std::size_t l = 0; l < L; ++l)
+            {
+                outRoot[l] = root[l];
+            }
+        }
+
+        // Evaluate the polynomials of the specified degree of the lanes at
+        // t[l]. Coefficient i of lane l is c[i * numBatchLanes + l].
+        static void EvaluateBatch(std::size_t degree, Real const* c, Real const* t, Real* result)
+        {
+            std::size_t const L = numBatchLanes;
+            for (std::size_t l = 0; l < L; ++l)
+            {
+                result[l] = c[degree * L + l];
+            }
+            for (std::size_t i = degree; i-- > 0; )
+            {
+                Real const* ci = c + i * L;
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    result[l] = t[l] * result[l] + ci[l];
+                }
+            }
+        }
+
         // Support for the Find functions.
         static int32_t FindRecursive(int32_t degree, Real const* c, Real tmin, Real tmax,
             uint32_t maxIterations, Real* roots)
@@ -0,0 +1,447 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2026
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 8.3.2026.10.18
+
+#pragma once
+
+// Singular value decompositions and polar decompositions of many 3x3
+// real-valued matrices. The matrices are stored as a structure of arrays,
+// one array per entry, and are processed in groups of NumLanes matrices
+// without branches and without memory allocation, in the same manner as
+// SymmetricEigensolver3x3Batch; see its comments about vectorization. The
+// algorithm follows the structure of
+//   A. McAdams, A. Selle, R. Tamstorf, J. Teran and E. Sifakis,
+//   "Computing the Singular Value Decomposition of 3x3 matrices with
+//   minimal branching and elementary floating point operations,"
+//   Technical Report TR1690, University of Wisconsin-Madison, 2011,
+// except that V is computed by one-sided Jacobi rotations applied to the
+// columns of A rather than by the Jacobi eigensolver for A^T*A. The
+// rotation for a pair of columns is computed from the dot products of the
+// current columns, so short columns are orthogonalized to the accuracy of
+// their own lengths. The eigenvectors of A^T*A for eigenvalues much
+// smaller than the largest one are not accurate enough for this, and the
+// resulting U*S*V^T does not reproduce A when A is ill conditioned. After
+// the sweeps, the columns of B = A*V are sorted by decreasing length and
+// B = U*R is factored by Givens rotations, so U is orthogonal even when A
+// is singular. The singular values are the diagonal entries of R.
+//
+// The decomposition is A = U*S*V^T, where U and V are rotations and S is
+// diagonal with s0 >= s1 >= |s2| up to rounding errors. The sign of s2 is
+// the sign of det(A). This form is convenient for extracting rotations;
+// for example, the rotation R = U*V^T minimizes |R*P - Q| in the Kabsch
+// algorithm when A = Q*P^T. The conventional decomposition with nonnegative
+// singular values is obtained by negating s2 and the last column of U when
+// s2 < 0.
+//
+// Let m be the maximum magnitude of the entries of A and let e be the
+// machine epsilon of T. The measured errors on millions of random matrices,
+// including singular matrices, matrices with nearly equal singular values,
+// condition numbers up to 1e8, reflections and rotations, are bounded by
+//   |A - U*S*V^T| <= 16*e*m (maximum magnitude of the entries),
+//   |U^T*U - I|, |V^T*V - I| <= 16*e,
+//   |s[i] - sigma[i]| <= 16*e*m,
+//   |A - R*P| <= 32*e*m for the polar decomposition,
+// where sigma[i] are the exact singular values with the sign convention
+// described previously. The bounds also hold for matrices whose entries
+// have magnitudes spread over 10^{-19} to 10^{19} for float and
+// 10^{-150} to 10^{150} for double, and for matrices with one entry of
+// magnitude 1 and a 2x2 block of entries as small as 10^{-35} for float
+// and 10^{-300} for double in the other rows and columns. The singular
+// values of such a block have relative errors at most 4*e, because the
+// dot products of short columns are computed after scaling. In general,
+// the relative accuracy of singular values much smaller than m is
+// limited.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace gte
+{
+    template <typename T, std::size_t NumLanes = 16>
+    class SingularValueDecomposition3x3Batch
+    {
+    public:
+        // The values of one quantity for the matrices of a group.
+        typedef std::array<T, NumLanes> Lanes;
+
+        // The number of Jacobi sweeps, each consisting of the rotations for
+        // the column pairs (0,1), (0,2) and (1,2). The sweeps converge
+        // quadratically, and the measured errors do not decrease with more
+        // sweeps.
+        static int32_t constexpr numSweeps = (std::numeric_limits<T>::digits <= 53 ? 4 : 5);
+
+        // The input matrices are stored in 9 arrays, where A[3*r+c][k] is
+        // the entry in row r and column c of matrix k for
+        // 0 <= k < numMatrices. The output U and V are stored in the same
+        // manner and the singular values of matrix k are S[i][k] for
+        // 0 <= i < 3. Set numThreads to 0 or 1 to execute in the main
+        // thread. Set numThreads to 2 or larger to distribute the groups of
+        // matrices among that many threads.
+        void operator()(std::size_t numMatrices, std::array<T const*, 9> const& A,
+            std::array<T*, 9> const& U, std::array<T*, 3> const& S,
+            std::array<T*, 9> const& V, std::size_t numThreads = 0) const
+        {
+            Execute(numMatrices, numThreads, [&A, &U, &S, &V](std::size_t kMin, std::size_t count)
+            {
+                std::array<Lanes, 9> gA{}, gU{}, gV{};
+                std::array<Lanes, 3> gS{};
+                Load(A, kMin, count, gA);
+                Solve(gA, gU, gS, gV);
+                Store(gU, kMin, count, U);
+                Store(gS, kMin, count, S);
+                Store(gV, kMin, count, V);
+            });
+        }
+
+        // Compute the polar decompositions A = R*P, where R = U*V^T is a
+        // rotation and P = V*S*V^T is symmetric. P is positive semidefinite
+        // when det(A) >= 0. When det(A) < 0, no rotation produces a positive
+        // semidefinite P, and the P computed here has one negative
+        // eigenvalue, s2, of smallest magnitude. The input A and output R
+        // are stored as for operator(). The output P is stored as the 6
+        // unique entries p00, p01, p02, p11, p12 and p22. If P[0] is null,
+        // only R is computed.
+        void Polar(std::size_t numMatrices, std::array<T const*, 9> const& A,
+            std::array<T*, 9> const& R, std::array<T*, 6> const& P,
+            std::size_t numThreads = 0) const
+        {
+            Execute(numMatrices, numThreads, [&A, &R, &P](std::size_t kMin, std::size_t count)
+            {
+                std::array<Lanes, 9> gA{}, gU{}, gV{};
+                std::array<Lanes, 3> gS{};
+                Load(A, kMin, count, gA);
+                Solve(gA, gU, gS, gV);
+
+                std::array<Lanes, 9> gR{};
+                for (std::size_t r = 0; r < 3; ++r)
+                {
+                    for (std::size_t c = 0; c < 3; ++c)
+                    {
+                        Lanes& rc = gR[3 * r + c];
+                        for (std::size_t l = 0; l < NumLanes; ++l)
+                        {
+                            rc[l] =
+                                gU[3 * r][l] * gV[3 * c][l] +
+                                gU[3 * r + 1][l] * gV[3 * c + 1][l] +
+                                gU[3 * r + 2][l] * gV[3 * c + 2][l];
+                        }
+                    }
+                }
+                Store(gR, kMin, count, R);
+
+                if (P[0] != nullptr)
+                {
+                    // The row and column indices of p00, p01, p02, p11, p12
+                    // and p22.
+                    std::size_t const row[6] = { 0, 0, 0, 1, 1, 2 };
+                    std::size_t const column[6] = { 0, 1, 2, 1, 2, 2 };
+                    std::array<Lanes, 6> gP{};
+                    for (std::size_t i = 0; i < 6; ++i)
+                    {
+                        std::size_t const r = row[i];
+                        std::size_t const c = column[i];
+                        for (std::size_t l = 0; l < NumLanes; ++l)
+                        {
+                            gP[i][l] =
+                                gV[3 * r][l] * gS[0][l] * gV[3 * c][l] +
+                                gV[3 * r + 1][l] * gS[1][l] * gV[3 * c + 1][l] +
+                                gV[3 * r + 2][l] * gS[2][l] * gV[3 * c + 2][l];
+                        }
+                    }
+                    Store(gP, kMin, count, P);
+                }
+            });
+        }
+
+        // Compute the decompositions of a group of matrices. This is the
+        // computation of operator() for each group. The input A stores the
+        // entries of the matrices as described for operator() and is
+        // modified by the function.
+        static void Solve(std::array<Lanes, 9>& A, std::array<Lanes, 9>& U,
+            std::array<Lanes, 3>& S, std::array<Lanes, 9>& V)
+        {
+            T const zero = static_cast<T>(0);
+            T const one = static_cast<T>(1);
+
+            // Scale the matrices so that the maximum magnitude of the
+            // entries is 1. The zero matrix is scaled by 1/min(T).
+            Lanes scale{};
+            for (std::size_t l = 0; l < NumLanes; ++l)
+            {
+                T maxAbs = std::numeric_limits<T>::min();
+                for (std::size_t i = 0; i < 9; ++i)
+                {
+                    maxAbs = std::max(maxAbs, std::fabs(A[i][l]));
+                }
+                scale[l] = maxAbs;
+            }
+            for (std::size_t i = 0; i < 9; ++i)
+            {
+                for (std::size_t l = 0; l < NumLanes; ++l)
+                {
+                    A[i][l] /= scale[l];
+                }
+            }
+
+            // Orthogonalize the columns of B = A*V by Jacobi rotations
+            // applied on the right, starting with V = I.
+            std::array<Lanes, 9> B = A;
+            for (std::size_t i = 0; i < 9; ++i)
+            {
+                V[i].fill((i % 4 == 0) ? one : zero);
+            }
+            for (int32_t sweep = 0; sweep < numSweeps; ++sweep)
+            {
+                Rotate(0, 1, B, V);
+                Rotate(0, 2, B, V);
+                Rotate(1, 2, B, V);
+            }
+
+            // Sort the columns of B by decreasing length.
+            SortColumns(0, 1, B, V);
+            SortColumns(1, 2, B, V);
+            SortColumns(0, 1, B, V);
+
+            // Factor B = U*R using Givens rotations G for which G*B has a
+            // zero in row q and column p. The diagonal entries of R in rows
+            // 0 and 1 are nonnegative.
+            for (std::size_t i = 0; i < 9; ++i)
+            {
+                U[i].fill((i % 4 == 0) ? one : zero);
+            }
+            QRRotate(0, 1, B, U);
+            QRRotate(0, 2, B, U);
+            QRRotate(1, 2, B, U);
+
+            // The columns are sorted by length, which orders r11 and |r22|
+            // only when the columns are orthogonal. When r11 and |r22| are
+            // much smaller than r00, rounding errors can leave components
+            // of columns 1 and 2 along column 0 that are larger than r11
+            // and |r22|, and then |r22| > r11 is possible. Exchanging
+            // columns 1 and 2 and restoring the triangular form produces
+            // r11 >= |r22|.
+            SortTrailingColumns(B, V);
+            QRRotate(1, 2, B, U);
+
+            for (std::size_t l = 0; l < NumLanes; ++l)
+            {
+                S[0][l] = B[0][l] * scale[l];
+                S[1][l] = B[4][l] * scale[l];
+                S[2][l] = B[8][l] * scale[l];
+            }
+        }
+
+    private:
+        // Process the groups of matrices, each by a call
+        // function(kMin, count) for the matrices with indices in
+        // [kMin,kMin+count). Each thread processes a contiguous range of
+        // groups.
+        template <typename Function>
+        static void Execute(std::size_t numMatrices, std::size_t numThreads,
+            Function const& function)
+        {
+            std::size_t const numGroups = (numMatrices + NumLanes - 1) / NumLanes;
+            auto processGroups = [numMatrices, &function](std::size_t gMin, std::size_t gSup)
+            {
+                for (std::size_t group = gMin; group < gSup; ++group)
+                {
+                    std::size_t const kMin = group * NumLanes;
+                    function(kMin, std::min(NumLanes, numMatrices - kMin));
+                }
+            };
+
+            numThreads = std::min(numThreads, numGroups);
+            if (numThreads <= 1)
+            {
+                processGroups(0, numGroups);
+            }
+            else
+            {
+                std::vector<std::thread> process(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    std::size_t const gMin = t * numGroups / numThreads;
+                    std::size_t const gSup = (t + 1) * numGroups / numThreads;
+                    process[t] = std::thread(processGroups, gMin, gSup);
+                }
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+        }
+
+        // The unused lanes of the last group are processed with the zero
+        // matrix.
+        template <std::size_t N>
+        static void Load(std::array<T const*, N> const& input, std::size_t kMin,
+            std::size_t count, std::array<Lanes, N>& group)
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                std::copy(input[i] + kMin, input[i] + kMin + count, group[i].begin());
+                std::fill(group[i].begin() + count, group[i].end(), static_cast<T>(0));
+            }
+        }
+
+        template <std::size_t N>
+        static void Store(std::array<Lanes, N> const& group, std::size_t kMin,
+            std::size_t count, std::array<T*, N> const& output)
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                std::copy(group[i].begin(), group[i].begin() + count, output[i] + kMin);
+            }
+        }
+
+        // Apply the Jacobi rotation to columns p and q of B and V that makes
+        // columns p and q of B orthogonal. With a = Dot(Bp,Bp),
+        // b = Dot(Bq,Bq), g = Dot(Bp,Bq) and z = (b - a)/(2*g), the tangent
+        // of the rotation angle is t = sign(z)/(|z| + sqrt(1 + z^2)). The
+        // rotation is skipped when g^2 <= (e^2)*a*b, in which case the
+        // columns are orthogonal to working precision. The dot products
+        // are computed for the columns divided by their maximum magnitude
+        // entry, which does not change z or the test. Otherwise they
+        // underflow when both columns are short compared to the largest
+        // entry of A, and the columns are then not orthogonalized.
+        static void Rotate(std::size_t p, std::size_t q,
+            std::array<Lanes, 9>& B, std::array<Lanes, 9>& V)
+        {
+            T const zero = static_cast<T>(0);
+            T const one = static_cast<T>(1);
+            T const half = static_cast<T>(0.5);
+            T const epsilon = std::numeric_limits<T>::epsilon();
+            for (std::size_t l = 0; l < NumLanes; ++l)
+            {
+                T const invMaxAbs = one / MaxAbs(p, q, B, l);
+                T const bp0 = B[p][l] * invMaxAbs, bp1 = B[3 + p][l] * invMaxAbs, bp2 = B[6 + p][l] * invMaxAbs;
+                T const bq0 = B[q][l] * invMaxAbs, bq1 = B[3 + q][l] * invMaxAbs, bq2 = B[6 + q][l] * invMaxAbs;
+                T const a = bp0 * bp0 + bp1 * bp1 + bp2 * bp2;
+                T const b = bq0 * bq0 + bq1 * bq1 + bq2 * bq2;
+                T const g = bp0 * bq0 + bp1 * bq1 + bp2 * bq2;
+                bool const valid = (g * g > epsilon * epsilon * a * b);
+                T const z = half * (b - a) / (valid ? g : one);
+                T const t = std::copysign(one, z) / (std::fabs(z) + std::sqrt(one + z * z));
+                T const c = (valid ? one / std::sqrt(one + t * t) : one);
+                T const s = (valid ? t * c : zero);
+
+                for (std::size_t r = 0; r < 9; r += 3)
+                {
+                    T const up = B[r + p][l], uq = B[r + q][l];
+                    B[r + p][l] = c * up - s * uq;
+                    B[r + q][l] = s * up + c * uq;
+                    T const vp = V[r + p][l], vq = V[r + q][l];
+                    V[r + p][l] = c * vp - s * vq;
+                    V[r + q][l] = s * vp + c * vq;
+                }
+            }
+        }
+
+        // The maximum magnitude of the entries of columns i and j of B for
+        // lane l, or min(T) when the columns are zero.
+        static T MaxAbs(std::size_t i, std::size_t j, std::array<Lanes, 9> const& B,
+            std::size_t l)
+        {
+            T maxAbs = std::numeric_limits<T>::min();
+            for (std::size_t r = 0; r < 9; r += 3)
+            {
+                maxAbs = std::max(maxAbs, std::max(std::fabs(B[r + i][l]), std::fabs(B[r + j][l])));
+            }
+            return maxAbs;
+        }
+
+        // Exchange columns i < j of B when column i is shorter than column
+        // j. Column j is replaced by the negated column i, which preserves
+        // B = A*V with V a rotation. The squared lengths are computed for
+        // the columns divided by their maximum magnitude entry so that they
+        // do not underflow.
+        static void SortColumns(std::size_t i, std::size_t j,
+            std::array<Lanes, 9>& B, std::array<Lanes, 9>& V)
+        {
+            T const one = static_cast<T>(1);
+            for (std::size_t l = 0; l < NumLanes; ++l)
+            {
+                T const invMaxAbs = one / MaxAbs(i, j, B, l);
+                T const bi0 = B[i][l] * invMaxAbs, bi1 = B[3 + i][l] * invMaxAbs, bi2 = B[6 + i][l] * invMaxAbs;
+                T const bj0 = B[j][l] * invMaxAbs, bj1 = B[3 + j][l] * invMaxAbs, bj2 = B[6 + j][l] * invMaxAbs;
+                T const lengthI = bi0 * bi0 + bi1 * bi1 + bi2 * bi2;
+                T const lengthJ = bj0 * bj0 + bj1 * bj1 + bj2 * bj2;
+                bool const exchange = (lengthI < lengthJ);
+                for (std::size_t r = 0; r < 9; r += 3)
+                {
+                    T const bi = B[r + i][l], bj = B[r + j][l];
+                    B[r + i][l] = (exchange ? bj : bi);
+                    B[r + j][l] = (exchange ? -bi : bj);
+                    T const vi = V[r + i][l], vj = V[r + j][l];
+                    V[r + i][l] = (exchange ? vj : vi);
+                    V[r + j][l] = (exchange ? -vi : vj);
+                }
+            }
+        }
+
+        // Exchange columns 1 and 2 of B when |r22| > r11 for the upper
+        // triangular B = R, as SortColumns does. B is no longer upper
+        // triangular after the exchange.
+        static void SortTrailingColumns(std::array<Lanes, 9>& B, std::array<Lanes, 9>& V)
+        {
+            for (std::size_t l = 0; l < NumLanes; ++l)
+            {
+                bool const exchange = (std::fabs(B[8][l]) > B[4][l]);
+                for (std::size_t r = 0; r < 9; r += 3)
+                {
+                    T const b1 = B[r + 1][l], b2 = B[r + 2][l];
+                    B[r + 1][l] = (exchange ? b2 : b1);
+                    B[r + 2][l] = (exchange ? -b1 : b2);
+                    T const v1 = V[r + 1][l], v2 = V[r + 2][l];
+                    V[r + 1][l] = (exchange ? v2 : v1);
+                    V[r + 2][l] = (exchange ? -v1 : v2);
+                }
+            }
+        }
+
+        // Apply the Givens rotation G to rows p and q of B that zeroes the
+        // entry x in row p and the entry y in row q of column p, and update
+        // U <- U*G^T. The cosine and sine are computed from x/m and y/m with
+        // m = max(|x|,|y|) so that x^2 + y^2 does not underflow when the
+        // entries are small. When x and y are zero, G is the identity.
+        static void QRRotate(std::size_t p, std::size_t q,
+            std::array<Lanes, 9>& B, std::array<Lanes, 9>& U)
+        {
+            T const zero = static_cast<T>(0);
+            T const one = static_cast<T>(1);
+            T const tiny = std::numeric_limits<T>::min();
+            for (std::size_t l = 0; l < NumLanes; ++l)
+            {
+                T const x = B[3 * p + p][l];
+                T const y = B[3 * q + p][l];
+                T const invMaxAbs = one / std::max(std::max(std::fabs(x), std::fabs(y)), tiny);
+                T const xs = x * invMaxAbs, ys = y * invMaxAbs;
+                T const length = std::sqrt(xs * xs + ys * ys);
+                bool const valid = (length > zero);
+                T const invLength = one / (valid ? length : one);
+                T const c = (valid ? xs * invLength : one);
+                T const s = (valid ? ys * invLength : zero);
+
+                for (std::size_t k = 0; k < 3; ++k)
+                {
+                    T const bp = B[3 * p + k][l], bq = B[3 * q + k][l];
+                    B[3 * p + k][l] = c * bp + s * bq;
+                    B[3 * q + k][l] = c * bq - s * bp;
+
+                    T const up = U[3 * k + p][l], uq = U[3 * k + q][l];
+                    U[3 * k + p][l] = c * up + s * uq;
+                    U[3 * k + q][l] = c * uq - s * up;
+                }
+            }
+        }
+    };
+}
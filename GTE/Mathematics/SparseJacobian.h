@@ -0,0 +1,435 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2026
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 8.3.2026.10.18
+
+#pragma once
+
+// Support for nonlinear least-squares problems whose Jacobian matrix J is
+// sparse, for use by GaussNewtonMinimizer and LevenbergMarquardtMinimizer.
+// See GaussNewtonMinimizer.h for the formulation of the problem. The
+// components of F(p) are partitioned into blocks, one per observation, and
+// the residuals of block b depend only on the parameters listed for the
+// block. The Jacobian matrix of block b is therefore a dense
+// numResiduals-by-numParameters matrix, and J is the union of these
+// blocks. This is the structure of bundle adjustment, where an observation
+// of a point by a camera depends only on the parameters of that point and
+// that camera.
+//
+// The blocks are evaluated by callbacks that are called concurrently for
+// different blocks when numThreads is 2 or larger, so the callbacks must be
+// safe to call from multiple threads. The matrix J^T*J is stored in
+// compressed sparse row form (LinearSystem<T>::CSRMatrix) with the sparsity
+// pattern determined by the blocks, which is computed once by the
+// constructor. The rows of J^T*J and -J^T*F are distributed among the
+// threads, and the blocks of each row are accumulated in increasing block
+// order, so the results do not depend on the number of threads. The normal
+// equations are solved by the preconditioned conjugate gradient method of
+// LinearSystem.
+
+#include <Mathematics/GVector.h>
+#include <Mathematics/LinearSystem.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace gte
+{
+    template <typename T>
+    class SparseJacobian
+    {
+    public:
+        typedef GVector<T> DVector;
+        typedef typename LinearSystem<T>::CSRMatrix CSRMatrix;
+        typedef typename LinearSystem<T>::Preconditioner Preconditioner;
+
+        // The residuals of a block depend on the parameters p[i] for the
+        // indices i in 'parameters'.
+        struct Block
+        {
+            Block()
+                :
+                numResiduals(0),
+                parameters{}
+            {
+            }
+
+            Block(int32_t inNumResiduals, std::vector<int32_t> const& inParameters)
+                :
+                numResiduals(inNumResiduals),
+                parameters(inParameters)
+            {
+            }
+
+            int32_t numResiduals;
+            std::vector<int32_t> parameters;
+        };
+
+        // FBlockFunction(b, p, F) computes the numResiduals components of
+        // F(p) for block b. JBlockFunction(b, p, J) computes the Jacobian
+        // matrix of block b, where J[r * numParameters + c] is the
+        // derivative of residual r with respect to p[parameters[c]].
+        typedef std::function<void(std::size_t, DVector const&, T*)> FBlockFunction;
+        typedef std::function<void(std::size_t, DVector const&, T*)> JBlockFunction;
+
+        // The components of F(p) are ordered by block. Set numThreads to 0
+        // or 1 to execute in the main thread. Set numThreads to 2 or larger
+        // to distribute the blocks, the rows of J^T*J and the rows of the
+        // linear solver among that many threads.
+        SparseJacobian(int32_t numPDimensions, std::vector<Block> const& blocks,
+            FBlockFunction const& inFBlockFunction, JBlockFunction const& inJBlockFunction,
+            std::size_t numThreads = 0)
+            :
+            mNumPDimensions(numPDimensions),
+            mNumFDimensions(0),
+            mBlocks(blocks),
+            mFBlockFunction(inFBlockFunction),
+            mJBlockFunction(inJBlockFunction),
+            mNumThreads(numThreads),
+            mMaxSolverIterations(static_cast<uint32_t>(numPDimensions)),
+            mSolverTolerance(std::sqrt(std::numeric_limits<T>::epsilon())),
+            mPreconditioner(Preconditioner::INCOMPLETE_CHOLESKY),
+            mFOffsets(blocks.size() + 1, 0),
+            mJOffsets(blocks.size() + 1, 0),
+            mPositionOffsets(blocks.size() + 1, 0),
+            mPositions{},
+            mRowBlockOffsets{},
+            mRowBlocks{},
+            mDiagonals{},
+            mJ{},
+            mBlockErrors(blocks.size()),
+            mJTJ{},
+            mDampedJTJ{},
+            mNegJTF{}
+        {
+            LogAssert(
+                mNumPDimensions > 0 && mBlocks.size() > 0,
+                "Invalid dimensions.");
+
+            CreateStructure();
+        }
+
+        // Disallow copy, assignment and move semantics.
+        SparseJacobian(SparseJacobian const&) = delete;
+        SparseJacobian& operator=(SparseJacobian const&) = delete;
+        SparseJacobian(SparseJacobian&&) = delete;
+        SparseJacobian& operator=(SparseJacobian&&) = delete;
+
+        inline int32_t GetNumPDimensions() const
+        {
+            return mNumPDimensions;
+        }
+
+        inline int32_t GetNumFDimensions() const
+        {
+            return mNumFDimensions;
+        }
+
+        inline std::size_t GetNumBlocks() const
+        {
+            return mBlocks.size();
+        }
+
+        // The number of stored entries of J^T*J, both (i,j) and (j,i) being
+        // stored for i != j.
+        inline std::size_t GetNumNonzeros() const
+        {
+            return mJTJ.columns.size();
+        }
+
+        // The conjugate gradient iterations for a linear system terminate
+        // when |B - A*X| <= tolerance * |B| or when maxIterations iterations
+        // have been performed. The defaults are maxIterations equal to
+        // numPDimensions, tolerance equal to sqrt(epsilon) and the
+        // incomplete Cholesky preconditioner.
+        void SetSolverParameters(uint32_t maxIterations, T tolerance,
+            Preconditioner preconditioner)
+        {
+            mMaxSolverIterations = maxIterations;
+            mSolverTolerance = tolerance;
+            mPreconditioner = preconditioner;
+        }
+
+        // Compute F(p), which is stored in F, and return |F(p)|^2.
+        T EvaluateF(DVector const& p, std::vector<T>& F)
+        {
+            F.resize(static_cast<std::size_t>(mNumFDimensions));
+            Execute(mBlocks.size(), [this, &p, &F](std::size_t bMin, std::size_t bSup)
+            {
+                for (std::size_t b = bMin; b < bSup; ++b)
+                {
+                    T* blockF = F.data() + mFOffsets[b];
+                    mFBlockFunction(b, p, blockF);
+
+                    T error = static_cast<T>(0);
+                    for (std::size_t r = mFOffsets[b]; r < mFOffsets[b + 1]; ++r)
+                    {
+                        error += F[r] * F[r];
+                    }
+                    mBlockErrors[b] = error;
+                }
+            });
+
+            T error = static_cast<T>(0);
+            for (auto const& blockError : mBlockErrors)
+            {
+                error += blockError;
+            }
+            return error;
+        }
+
+        // Compute J(p) and the normal equations J^T(p)*J(p) and -J^T(p)*F,
+        // where F = F(p) was computed by EvaluateF.
+        void EvaluateNormalEquations(DVector const& p, std::vector<T> const& F)
+        {
+            LogAssert(
+                F.size() == static_cast<std::size_t>(mNumFDimensions),
+                "Invalid F.");
+
+            Execute(mBlocks.size(), [this, &p](std::size_t bMin, std::size_t bSup)
+            {
+                for (std::size_t b = bMin; b < bSup; ++b)
+                {
+                    mJBlockFunction(b, p, mJ.data() + mJOffsets[b]);
+                }
+            });
+
+            std::size_t const numRows = static_cast<std::size_t>(mNumPDimensions);
+            Execute(numRows, [this, &F](std::size_t iMin, std::size_t iSup)
+            {
+                for (std::size_t i = iMin; i < iSup; ++i)
+                {
+                    AssembleRow(i, F);
+                }
+            });
+        }
+
+        // Solve (J^T*J + D)*step = -J^T*F for the normal equations computed
+        // by EvaluateNormalEquations, where D is a multiple of the identity.
+        // The multiple is lambdaFactor times the average of the diagonal
+        // entries of J^T*J, which is the adjustment of the diagonal used by
+        // LevenbergMarquardtMinimizer. The return value is the number of
+        // conjugate gradient iterations.
+        uint32_t Solve(T lambdaFactor, DVector& step)
+        {
+            mDampedJTJ.values = mJTJ.values;
+            if (lambdaFactor != static_cast<T>(0))
+            {
+                T diagonalSum = static_cast<T>(0);
+                for (auto const& k : mDiagonals)
+                {
+                    diagonalSum += mJTJ.values[k];
+                }
+
+                T diagonalAdjust = lambdaFactor * diagonalSum / static_cast<T>(mNumPDimensions);
+                for (auto const& k : mDiagonals)
+                {
+                    mDampedJTJ.values[k] += diagonalAdjust;
+                }
+            }
+
+            step.SetSize(mNumPDimensions);
+            return LinearSystem<T>::SolveSymmetricCG(mDampedJTJ, mNegJTF.data(),
+                &step[0], mMaxSolverIterations, mSolverTolerance, mPreconditioner,
+                mNumThreads);
+        }
+
+    private:
+        // Compute the offsets of the blocks in F and J and the sparsity
+        // pattern of J^T*J. Entry (i,j) of J^T*J is nonzero only when p[i]
+        // and p[j] are parameters of the same block. The diagonal entries
+        // are always stored, which the preconditioners require.
+        void CreateStructure()
+        {
+            std::size_t const numBlocks = mBlocks.size();
+            std::size_t const numRows = static_cast<std::size_t>(mNumPDimensions);
+            std::vector<std::vector<int32_t>> rowColumns(numRows);
+            mRowBlockOffsets.assign(numRows + 1, 0);
+            for (std::size_t b = 0; b < numBlocks; ++b)
+            {
+                Block const& block = mBlocks[b];
+                std::size_t const numResiduals = static_cast<std::size_t>(block.numResiduals);
+                std::size_t const numParameters = block.parameters.size();
+                LogAssert(
+                    block.numResiduals > 0 && numParameters > 0,
+                    "Invalid block.");
+
+                mFOffsets[b + 1] = mFOffsets[b] + numResiduals;
+                mJOffsets[b + 1] = mJOffsets[b] + numResiduals * numParameters;
+                mPositionOffsets[b + 1] = mPositionOffsets[b] + numParameters * numParameters;
+                for (auto const& i : block.parameters)
+                {
+                    LogAssert(
+                        0 <= i && i < mNumPDimensions,
+                        "Invalid parameter index.");
+
+                    ++mRowBlockOffsets[static_cast<std::size_t>(i) + 1];
+                    auto& columns = rowColumns[static_cast<std::size_t>(i)];
+                    columns.insert(columns.end(), block.parameters.begin(), block.parameters.end());
+                }
+            }
+            mNumFDimensions = static_cast<int32_t>(mFOffsets[numBlocks]);
+
+            mJTJ.numRows = mNumPDimensions;
+            mJTJ.offsets.assign(numRows + 1, 0);
+            mJTJ.columns.clear();
+            mDiagonals.resize(numRows);
+            for (std::size_t i = 0; i < numRows; ++i)
+            {
+                auto& columns = rowColumns[i];
+                columns.push_back(static_cast<int32_t>(i));
+                std::sort(columns.begin(), columns.end());
+                columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+                mJTJ.columns.insert(mJTJ.columns.end(), columns.begin(), columns.end());
+                mJTJ.offsets[i + 1] = mJTJ.columns.size();
+                mDiagonals[i] = GetPosition(i, static_cast<int32_t>(i));
+                std::vector<int32_t>().swap(columns);
+            }
+            mJTJ.values.resize(mJTJ.columns.size());
+            mDampedJTJ = mJTJ;
+
+            // The blocks that contain p[i] are listed in increasing order
+            // with the index of p[i] in the parameters of the block.
+            for (std::size_t i = 0; i < numRows; ++i)
+            {
+                mRowBlockOffsets[i + 1] += mRowBlockOffsets[i];
+            }
+            mRowBlocks.resize(mRowBlockOffsets[numRows]);
+            std::vector<std::size_t> current(mRowBlockOffsets.begin(), mRowBlockOffsets.end() - 1);
+            mPositions.resize(mPositionOffsets[numBlocks]);
+            for (std::size_t b = 0; b < numBlocks; ++b)
+            {
+                auto const& parameters = mBlocks[b].parameters;
+                std::size_t const numParameters = parameters.size();
+                for (std::size_t c = 0; c < numParameters; ++c)
+                {
+                    std::size_t const i = static_cast<std::size_t>(parameters[c]);
+                    mRowBlocks[current[i]++] = { b, c };
+
+                    std::size_t* positions = &mPositions[mPositionOffsets[b] + c * numParameters];
+                    for (std::size_t d = 0; d < numParameters; ++d)
+                    {
+                        positions[d] = GetPosition(i, parameters[d]);
+                    }
+                }
+            }
+
+            mJ.resize(mJOffsets[numBlocks]);
+            mNegJTF.resize(numRows);
+        }
+
+        // The index into the CSR arrays of entry (i,j) of J^T*J.
+        std::size_t GetPosition(std::size_t i, int32_t j) const
+        {
+            auto begin = mJTJ.columns.begin() + mJTJ.offsets[i];
+            auto end = mJTJ.columns.begin() + mJTJ.offsets[i + 1];
+            return static_cast<std::size_t>(std::lower_bound(begin, end, j) - mJTJ.columns.begin());
+        }
+
+        // Compute row i of J^T*J and -J^T*F. For a block containing p[i] as
+        // parameter c, the contributions are the dot products of column c
+        // of the block Jacobian with the columns of the block Jacobian and
+        // with the block residuals.
+        void AssembleRow(std::size_t i, std::vector<T> const& F)
+        {
+            T* values = mJTJ.values.data();
+            for (std::size_t k = mJTJ.offsets[i]; k < mJTJ.offsets[i + 1]; ++k)
+            {
+                values[k] = static_cast<T>(0);
+            }
+
+            T negJTF = static_cast<T>(0);
+            for (std::size_t k = mRowBlockOffsets[i]; k < mRowBlockOffsets[i + 1]; ++k)
+            {
+                std::size_t const b = mRowBlocks[k][0];
+                std::size_t const c = mRowBlocks[k][1];
+                std::size_t const numResiduals = mFOffsets[b + 1] - mFOffsets[b];
+                std::size_t const numParameters = mBlocks[b].parameters.size();
+                T const* J = mJ.data() + mJOffsets[b];
+                T const* blockF = F.data() + mFOffsets[b];
+                std::size_t const* positions = &mPositions[mPositionOffsets[b] + c * numParameters];
+
+                for (std::size_t d = 0; d < numParameters; ++d)
+                {
+                    T dot = static_cast<T>(0);
+                    for (std::size_t r = 0; r < numResiduals; ++r)
+                    {
+                        dot += J[r * numParameters + c] * J[r * numParameters + d];
+                    }
+                    values[positions[d]] += dot;
+                }
+
+                for (std::size_t r = 0; r < numResiduals; ++r)
+                {
+                    negJTF -= J[r * numParameters + c] * blockF[r];
+                }
+            }
+            mNegJTF[i] = negJTF;
+        }
+
+        // Process [0,numItems) by calls function(iMin,iSup), each thread
+        // processing a contiguous range of items.
+        template <typename Function>
+        void Execute(std::size_t numItems, Function const& function) const
+        {
+            std::size_t const numThreads = std::min(mNumThreads, numItems);
+            if (numThreads <= 1)
+            {
+                function(0, numItems);
+            }
+            else
+            {
+                std::vector<std::thread> process(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    std::size_t const iMin = t * numItems / numThreads;
+                    std::size_t const iSup = (t + 1) * numItems / numThreads;
+                    process[t] = std::thread(function, iMin, iSup);
+                }
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+        }
+
+        int32_t mNumPDimensions, mNumFDimensions;
+        std::vector<Block> mBlocks;
+        FBlockFunction mFBlockFunction;
+        JBlockFunction mJBlockFunction;
+        std::size_t mNumThreads;
+
+        // Parameters for the conjugate gradient solver.
+        uint32_t mMaxSolverIterations;
+        T mSolverTolerance;
+        Preconditioner mPreconditioner;
+
+        // The components of block b are F[mFOffsets[b]] through
+        // F[mFOffsets[b+1]-1] and its Jacobian matrix is stored starting at
+        // mJ[mJOffsets[b]]. The entry of J^T*J for parameters c and d of
+        // block b is at index mPositions[mPositionOffsets[b] + c *
+        // numParameters + d] of the CSR arrays.
+        std::vector<std::size_t> mFOffsets, mJOffsets, mPositionOffsets;
+        std::vector<std::size_t> mPositions;
+
+        // Row i of J^T*J receives contributions from the blocks
+        // mRowBlocks[k][0] with parameter index mRowBlocks[k][1] for
+        // mRowBlockOffsets[i] <= k < mRowBlockOffsets[i+1].
+        std::vector<std::size_t> mRowBlockOffsets;
+        std::vector<std::array<std::size_t, 2>> mRowBlocks;
+        std::vector<std::size_t> mDiagonals;
+
+        std::vector<T> mJ, mBlockErrors;
+        CSRMatrix mJTJ, mDampedJTJ;
+        std::vector<T> mNegJTF;
+    };
+}
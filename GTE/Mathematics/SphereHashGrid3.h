@@ -0,0 +1,362 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2026
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 8.3.2026.10.18
+
+#pragma once
+
+// SphereHashGrid3 is a broadphase for collections of spheres (or particles
+// with radii) that computes the pairs of overlapping spheres. It is an
+// alternative to BoxManager when the objects are dense, in which case the
+// 1D projections used by sort-and-sweep cluster badly.
+//
+// Space is partitioned into cubic cells whose edge length is at least the
+// largest sphere diameter, so two overlapping spheres have centers in the
+// same cell or in adjacent cells. The cell coordinates are measured from the
+// minimum corner of the bounding box of the centers and are clamped to
+// [0,2^30], which keeps them in the range of int32_t for any coordinates;
+// clamping merges far cells, which costs time but does not lose pairs. The
+// cells are mapped to the buckets of a
+// hash table whose size is a power of two that is at least twice the number
+// of spheres. The spheres are binned into the buckets with a counting sort,
+// and their centers, radii and cell coordinates are copied into the binned
+// order so that the neighbor iteration accesses contiguous memory. Each
+// sphere is tested against the later spheres of its own cell and against
+// all spheres of 13 of its 26 neighboring cells, so each pair is tested
+// once. Because a bucket can contain spheres from different cells, the
+// cell coordinates are compared before a sphere-sphere test.
+//
+// The expected cost is linear in the number of spheres when the radii have
+// similar sizes. A few spheres much larger than the others force large
+// cells and then many spheres share a cell.
+
+#include <Mathematics/EdgeKey.h>
+#include <Mathematics/Logger.h>
+#include <Mathematics/Vector3.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace gte
+{
+    template <typename Real>
+    class SphereHashGrid3
+    {
+    public:
+        // Set numThreads to 0 or 1 to execute in the main thread. Set
+        // numThreads to 2 or larger to compute the cells and the pairs in
+        // that many threads.
+        SphereHashGrid3(std::size_t numThreads = 0)
+            :
+            mNumThreads(numThreads),
+            mCellSize(static_cast<Real>(0)),
+            mMinCorner{},
+            mBucketStart{},
+            mBinned{},
+            mBinnedCenters{},
+            mBinnedRadii{},
+            mBinnedCells{},
+            mCells{},
+            mBuckets{}
+        {
+        }
+
+        // Compute the pairs (i,j) with i < j of overlapping spheres. The
+        // spheres touch or overlap when their center distance is at most
+        // the sum of their radii. The pairs are sorted. The cell size is the
+        // largest diameter unless cellSize is larger, which is useful to
+        // reuse a fixed grid across frames. If both are zero, for example
+        // for point particles, the cell size is the largest extent of the
+        // bounding box of the centers divided by the cube root of the
+        // number of spheres, or 1 when the centers are all the same.
+        void Execute(
+            std::vector<Vector3<Real>> const& centers,
+            std::vector<Real> const& radii,
+            std::vector<EdgeKey<false>>& overlap,
+            Real cellSize = static_cast<Real>(0))
+        {
+            LogAssert(
+                centers.size() == radii.size(),
+                "The number of centers and radii must be the same.");
+
+            overlap.clear();
+            std::size_t const numSpheres = centers.size();
+            if (numSpheres < 2)
+            {
+                return;
+            }
+
+            mMinCorner = centers[0];
+            Vector3<Real> maxCorner = centers[0];
+            for (std::size_t i = 1; i < numSpheres; ++i)
+            {
+                for (std::int32_t k = 0; k < 3; ++k)
+                {
+                    mMinCorner[k] = std::min(mMinCorner[k], centers[i][k]);
+                    maxCorner[k] = std::max(maxCorner[k], centers[i][k]);
+                }
+            }
+
+            Real maxRadius = *std::max_element(radii.begin(), radii.end());
+            mCellSize = std::max(cellSize, static_cast<Real>(2) * maxRadius);
+            if (mCellSize == static_cast<Real>(0))
+            {
+                Real maxExtent = static_cast<Real>(0);
+                for (std::int32_t k = 0; k < 3; ++k)
+                {
+                    maxExtent = std::max(maxExtent, maxCorner[k] - mMinCorner[k]);
+                }
+                mCellSize = maxExtent / std::cbrt(static_cast<Real>(numSpheres));
+                if (!(mCellSize > static_cast<Real>(0)))
+                {
+                    mCellSize = static_cast<Real>(1);
+                }
+            }
+            LogAssert(
+                mCellSize > static_cast<Real>(0),
+                "The cell size must be positive.");
+
+            BinSpheres(centers, radii);
+            FindOverlaps(overlap);
+        }
+
+        // Convenience for particles with a common radius.
+        void Execute(
+            std::vector<Vector3<Real>> const& centers,
+            Real radius,
+            std::vector<EdgeKey<false>>& overlap,
+            Real cellSize = static_cast<Real>(0))
+        {
+            std::vector<Real> radii(centers.size(), radius);
+            Execute(centers, radii, overlap, cellSize);
+        }
+
+        // Member access for the most recent Execute call.
+        inline Real GetCellSize() const
+        {
+            return mCellSize;
+        }
+
+        inline std::size_t GetNumBuckets() const
+        {
+            return (mBucketStart.size() > 0 ? mBucketStart.size() - 1 : 0);
+        }
+
+    private:
+        using Cell = std::array<std::int32_t, 3>;
+
+        std::size_t GetBucket(Cell const& cell) const
+        {
+            // The prime-XOR hash of Teschner et al. produces many collisions
+            // for the small cell coordinates of a compact point cloud. The
+            // 64-bit products are mixed as in the SplitMix64 finalizer so
+            // that the low bits used for the bucket index are well spread.
+            std::uint64_t h =
+                (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cell[0])) * 0x9E3779B97F4A7C15ull) ^
+                (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cell[1])) * 0xC2B2AE3D27D4EB4Full) ^
+                (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cell[2])) * 0x165667B19E3779F9ull);
+            h ^= (h >> 29);
+            h *= 0xBF58476D1CE4E5B9ull;
+            h ^= (h >> 32);
+            return static_cast<std::size_t>(h & static_cast<std::uint64_t>(mBucketStart.size() - 2));
+        }
+
+        template <typename Function>
+        void ExecuteRange(std::size_t numElements, Function const& function)
+        {
+            std::size_t const numThreads = std::max(
+                std::min(mNumThreads, numElements / 1024), static_cast<std::size_t>(1));
+            if (numThreads <= 1)
+            {
+                function(0, 0, numElements);
+                return;
+            }
+
+            std::size_t const numPerThread = numElements / numThreads;
+            std::vector<std::thread> process(numThreads);
+            for (std::size_t t = 0; t < numThreads; ++t)
+            {
+                std::size_t imin = t * numPerThread;
+                std::size_t isup = (t + 1 < numThreads ? imin + numPerThread : numElements);
+                process[t] = std::thread([&function, t, imin, isup]()
+                {
+                    function(t, imin, isup);
+                });
+            }
+            for (std::size_t t = 0; t < numThreads; ++t)
+            {
+                process[t].join();
+            }
+        }
+
+        void BinSpheres(std::vector<Vector3<Real>> const& centers,
+            std::vector<Real> const& radii)
+        {
+            std::size_t const numSpheres = centers.size();
+            std::size_t numBuckets = 1;
+            while (numBuckets < 2 * numSpheres)
+            {
+                numBuckets <<= 1;
+            }
+            mBucketStart.assign(numBuckets + 1, 0);
+
+            // Compute the cells and buckets of the spheres.
+            mCells.resize(numSpheres);
+            mBuckets.resize(numSpheres);
+            Real const invCellSize = static_cast<Real>(1) / mCellSize;
+            Real const maxCell = static_cast<Real>(1 << 30);
+            ExecuteRange(numSpheres, [this, &centers, invCellSize, maxCell](std::size_t,
+                std::size_t imin, std::size_t isup)
+            {
+                for (std::size_t i = imin; i < isup; ++i)
+                {
+                    for (std::int32_t k = 0; k < 3; ++k)
+                    {
+                        // The comparison also maps a NaN to maxCell.
+                        Real const cell = std::floor((centers[i][k] - mMinCorner[k]) * invCellSize);
+                        mCells[i][k] = static_cast<std::int32_t>(cell < maxCell ? cell : maxCell);
+                    }
+                    mBuckets[i] = GetBucket(mCells[i]);
+                }
+            });
+
+            // Counting sort of the spheres by bucket. After the scatter,
+            // the spheres of bucket b are binned in positions
+            // [mBucketStart[b], mBucketStart[b+1]).
+            for (std::size_t i = 0; i < numSpheres; ++i)
+            {
+                ++mBucketStart[mBuckets[i] + 1];
+            }
+            for (std::size_t b = 1; b <= numBuckets; ++b)
+            {
+                mBucketStart[b] += mBucketStart[b - 1];
+            }
+
+            mBinned.resize(numSpheres);
+            mBinnedCenters.resize(numSpheres);
+            mBinnedRadii.resize(numSpheres);
+            mBinnedCells.resize(numSpheres);
+            std::vector<std::size_t> next(mBucketStart.begin(), mBucketStart.end() - 1);
+            for (std::size_t i = 0; i < numSpheres; ++i)
+            {
+                std::size_t p = next[mBuckets[i]]++;
+                mBinned[p] = static_cast<std::int32_t>(i);
+                mBinnedCenters[p] = centers[i];
+                mBinnedRadii[p] = radii[i];
+                mBinnedCells[p] = mCells[i];
+            }
+        }
+
+        void FindOverlaps(std::vector<EdgeKey<false>>& overlap)
+        {
+            // The 13 neighbors (dx,dy,dz) that are lexicographically
+            // positive. The other 13 neighbors are visited from the other
+            // side of each pair.
+            static std::array<Cell, 13> const offsets =
+            {{
+                {{ 1, 0, 0 }}, {{ -1, 1, 0 }}, {{ 0, 1, 0 }}, {{ 1, 1, 0 }},
+                {{ -1, -1, 1 }}, {{ 0, -1, 1 }}, {{ 1, -1, 1 }},
+                {{ -1, 0, 1 }}, {{ 0, 0, 1 }}, {{ 1, 0, 1 }},
+                {{ -1, 1, 1 }}, {{ 0, 1, 1 }}, {{ 1, 1, 1 }}
+            }};
+
+            std::size_t const numSpheres = mBinned.size();
+            std::size_t const numThreads = std::max(
+                std::min(mNumThreads, numSpheres / 1024), static_cast<std::size_t>(1));
+            std::vector<std::vector<EdgeKey<false>>> buffers(numThreads);
+
+            auto testBucketRange = [this](std::size_t p, std::size_t qmin, std::size_t qsup,
+                Cell const& cell, std::vector<EdgeKey<false>>& buffer)
+            {
+                Vector3<Real> const& center = mBinnedCenters[p];
+                Real const radius = mBinnedRadii[p];
+                for (std::size_t q = qmin; q < qsup; ++q)
+                {
+                    if (mBinnedCells[q] == cell)
+                    {
+                        Vector3<Real> diff = mBinnedCenters[q] - center;
+                        Real rsum = mBinnedRadii[q] + radius;
+                        if (Dot(diff, diff) <= rsum * rsum)
+                        {
+                            buffer.push_back(EdgeKey<false>(mBinned[p], mBinned[q]));
+                        }
+                    }
+                }
+            };
+
+            ExecuteRange(numSpheres, [this, &buffers, &testBucketRange](std::size_t t,
+                std::size_t pmin, std::size_t psup)
+            {
+                // The spheres of a cell are usually consecutive in the binned
+                // order, so the neighbor cells and their bucket ranges are
+                // computed once per run of spheres with the same cell.
+                auto& buffer = buffers[t];
+                std::array<Cell, 13> neighbors{};
+                std::array<std::size_t, 13> qmin{}, qsup{};
+                std::size_t cellSup = 0;
+                for (std::size_t p = pmin; p < psup; ++p)
+                {
+                    Cell const& cell = mBinnedCells[p];
+                    if (p == pmin || cell != mBinnedCells[p - 1])
+                    {
+                        cellSup = mBucketStart[GetBucket(cell) + 1];
+                        for (std::size_t k = 0; k < offsets.size(); ++k)
+                        {
+                            auto const& offset = offsets[k];
+                            neighbors[k] = { cell[0] + offset[0], cell[1] + offset[1], cell[2] + offset[2] };
+                            std::size_t b = GetBucket(neighbors[k]);
+                            qmin[k] = mBucketStart[b];
+                            qsup[k] = mBucketStart[b + 1];
+                        }
+                    }
+
+                    // The later spheres in the same cell.
+                    testBucketRange(p, p + 1, cellSup, cell, buffer);
+
+                    // The spheres in the forward neighboring cells.
+                    for (std::size_t k = 0; k < offsets.size(); ++k)
+                    {
+                        testBucketRange(p, qmin[k], qsup[k], neighbors[k], buffer);
+                    }
+                }
+            });
+
+            std::size_t numOverlaps = 0;
+            for (auto const& buffer : buffers)
+            {
+                numOverlaps += buffer.size();
+            }
+            overlap.reserve(numOverlaps);
+            for (auto const& buffer : buffers)
+            {
+                overlap.insert(overlap.end(), buffer.begin(), buffer.end());
+            }
+            std::sort(overlap.begin(), overlap.end());
+        }
+
+        std::size_t mNumThreads;
+        Real mCellSize;
+
+        // The origin of the cell coordinates.
+        Vector3<Real> mMinCorner;
+
+        // The binned order of the spheres. The spheres of bucket b are in
+        // positions [mBucketStart[b], mBucketStart[b+1]) of the mBinned*
+        // arrays. mBinned[p] is the input index of the sphere at position p.
+        std::vector<std::size_t> mBucketStart;
+        std::vector<std::int32_t> mBinned;
+        std::vector<Vector3<Real>> mBinnedCenters;
+        std::vector<Real> mBinnedRadii;
+        std::vector<Cell> mBinnedCells;
+
+        // Per-sphere cells and buckets in input order.
+        std::vector<Cell> mCells;
+        std::vector<std::size_t> mBuckets;
+    };
+}
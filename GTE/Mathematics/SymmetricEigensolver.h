@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 8.0.2025.05.10
+// File Version: 8.3.2026.10.18
 
 #pragma once
 
@@ -93,6 +93,29 @@
 // comperr is the computation E = Q^T*A*Q - D.  The construction of the full
 // eigenvector matrix is, of course, quite expensive.  If you need only a
 // small number of eigenvectors, use function GetEigenvector(int32_t,Real*).
+//
+// For large matrices, the divide-and-conquer algorithm can be selected at
+// construction.  The reduction to tridiagonal form is blocked as in LAPACK's
+// DSYTRD/DLATRD: the Householder reflections of a panel of columns are
+// accumulated in matrices V and W, and the trailing matrix is updated by
+// A <- A - V*W^T - W*V^T once per panel.  The tridiagonal eigenproblem is
+// solved by Cuppen's divide-and-conquer method.  The matrix is split into
+// two halves coupled by a rank-1 term, the halves are solved recursively
+// and the eigensystem of a diagonal matrix plus a rank-1 matrix is computed
+// from the roots of the secular equation.  The eigenvectors are computed
+// using the Gu-Eisenstat formula for the rank-1 vector, which keeps them
+// orthogonal when eigenvalues are close.  Blocks of at most 32 rows are
+// solved by the implicit QR algorithm.  The products of the eigenvector
+// matrices of the halves with the rank-1 eigenvector matrices and the
+// final back-transformation by the Householder reflections are computed
+// using multiple threads.  See
+//   J. J. M. Cuppen, "A divide and conquer method for the symmetric
+//   tridiagonal eigenproblem," Numerische Mathematik 36, 1981.
+//   M. Gu and S. C. Eisenstat, "A divide-and-conquer algorithm for the
+//   symmetric tridiagonal eigenproblem," SIAM J. Matrix Anal. Appl. 16(1),
+//   1995.
+// The GetEigenvectors(Real*), GetEigenvector(int32_t,Real*) and sorting
+// behave the same for both algorithms.
 
 #include <Mathematics/RangeIteration.h>
 #include <algorithm>
@@ -101,6 +124,7 @@
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include <thread>
 #include <vector>
 
 namespace gte
@@ -109,16 +133,33 @@ namespace gte
     class SymmetricEigensolver
     {
     public:
+        // The algorithm for the tridiagonal eigenproblem.  QR is the
+        // implicit symmetric QR algorithm.  DIVIDE_AND_CONQUER also uses
+        // the blocked tridiagonalization and multiple threads.
+        enum class Algorithm
+        {
+            QR,
+            DIVIDE_AND_CONQUER
+        };
+
         // The solver processes NxN symmetric matrices, where N > 1 ('size'
         // is N) and the matrix is stored in row-major order.  The maximum
         // number of iterations ('maxIterations') must be specified for the
-        // reduction of a tridiagonal matrix to a diagonal matrix.  The goal
-        // is to compute NxN orthogonal Q and NxN diagonal D for which
-        // Q^T*A*Q = D.
-        SymmetricEigensolver(int32_t size, uint32_t maxIterations)
+        // reduction of a tridiagonal matrix to a diagonal matrix.  For the
+        // divide-and-conquer algorithm, this is the maximum for each block
+        // solved by the QR algorithm.  The goal is to compute NxN orthogonal
+        // Q and NxN diagonal D for which Q^T*A*Q = D.  Set numThreads to 0
+        // or 1 to execute in the main thread.  Set numThreads to 2 or larger
+        // to use that many threads for the divide-and-conquer algorithm.
+        // The QR algorithm ignores numThreads.
+        SymmetricEigensolver(int32_t size, uint32_t maxIterations,
+            Algorithm algorithm = Algorithm::QR, std::size_t numThreads = 0)
             :
             mSize(0),
             mMaxIterations(0),
+            mAlgorithm(algorithm),
+            mNumThreads(std::max(numThreads, static_cast<std::size_t>(1))),
+            mTridiagonalReflection(false),
             mEigenvectorMatrixType(-1)
         {
             if (size > 1 && maxIterations > 0)
@@ -129,7 +170,14 @@ namespace gte
                 mMatrix.resize(szSize * szSize);
                 mDiagonal.resize(szSize);
                 mSuperdiagonal.resize(szSize - 1);
-                mGivens.reserve(static_cast<size_t>(maxIterations) * (szSize - 1));
+                if (mAlgorithm == Algorithm::QR)
+                {
+                    mGivens.reserve(static_cast<size_t>(maxIterations) * (szSize - 1));
+                }
+                else
+                {
+                    mTridiagonalEigenvectors.resize(szSize * szSize);
+                }
                 mPermutation.resize(szSize);
                 mVisited.resize(szSize);
                 mPVector.resize(szSize);
@@ -151,51 +199,36 @@ namespace gte
             if (mSize > 0)
             {
                 std::copy(input, input + static_cast<size_t>(mSize) * static_cast<size_t>(mSize), mMatrix.begin());
-                Tridiagonalize();
 
-                mGivens.clear();
-                for (uint32_t j = 0; j < mMaxIterations; ++j)
+                uint32_t numIterations;
+                if (mAlgorithm == Algorithm::QR)
                 {
-                    int32_t imin = -1, imax = -1;
-                    for (int32_t i = mSize - 2; i >= 0; --i)
-                    {
-                        // When a01 is much smaller than its diagonal
-                        // neighbors, it is effectively zero.
-                        Real a00 = mDiagonal[i];
-                        Real a01 = mSuperdiagonal[i];
-                        Real a11 = mDiagonal[static_cast<size_t>(i) + 1];
-                        Real sum = std::fabs(a00) + std::fabs(a11);
-                        if (sum + std::fabs(a01) != sum)
-                        {
-                            if (imax == -1)
-                            {
-                                imax = i;
-                            }
-                            imin = i;
-                        }
-                        else
+                    Tridiagonalize();
+
+                    mGivens.clear();
+                    numIterations = ReduceTridiagonal(mSize, mMaxIterations,
+                        mDiagonal.data(), mSuperdiagonal.data(),
+                        [this](int32_t index, Real cs, Real sn)
                         {
-                            // The superdiagonal term is effectively zero
-                            // compared to the neighboring diagonal terms.
-                            if (imin >= 0)
-                            {
-                                break;
-                            }
-                        }
-                    }
+                            mGivens.push_back(GivensRotation(index, cs, sn));
+                        });
+                }
+                else
+                {
+                    TridiagonalizeBlocked();
 
-                    if (imax == -1)
-                    {
-                        // The algorithm has converged.
-                        ComputePermutation(sortType);
-                        return j;
-                    }
+                    numIterations = DivideAndConquer(static_cast<std::size_t>(mSize),
+                        mDiagonal.data(), mSuperdiagonal.data(),
+                        mTridiagonalEigenvectors.data(), mNumThreads,
+                        mTridiagonalReflection);
+                }
 
-                    // Process the lower-right-most unreduced tridiagonal
-                    // block.
-                    DoQRImplicitShift(imin, imax);
+                if (numIterations != 0xFFFFFFFF)
+                {
+                    // The algorithm has converged.
+                    ComputePermutation(sortType);
                 }
-                return 0xFFFFFFFF;
+                return numIterations;
             }
             else
             {
@@ -241,64 +274,75 @@ namespace gte
 
             if (eigenvectors && mSize > 0)
             {
-                // Start with the identity matrix.
-                std::fill(eigenvectors, eigenvectors + static_cast<size_t>(mSize) * static_cast<size_t>(mSize), (Real)0);
-                for (int32_t d = 0; d < mSize; ++d)
+                if (mAlgorithm == Algorithm::DIVIDE_AND_CONQUER)
                 {
-                    eigenvectors[d + mSize * d] = (Real)1;
+                    // Start with the eigenvectors of the tridiagonal matrix
+                    // and apply the Householder reflections.
+                    std::copy(mTridiagonalEigenvectors.begin(),
+                        mTridiagonalEigenvectors.end(), eigenvectors);
+                    ApplyHouseholderReflections(eigenvectors);
                 }
-
-                // Multiply the Householder reflections using backward
-                // accumulation.
-                int32_t r, c;
-                for (int32_t i = mSize - 3, rmin = i + 1; i >= 0; --i, --rmin)
+                else
                 {
-                    // Copy the v vector and 2/Dot(v,v) from the matrix.
-                    Real const* column = &mMatrix[i];
-                    Real twoinvvdv = column[mSize * (i + 1)];
-                    for (r = 0; r < i + 1; ++r)
-                    {
-                        mVVector[r] = (Real)0;
-                    }
-                    mVVector[r] = (Real)1;
-                    for (++r; r < mSize; ++r)
+                    // Start with the identity matrix.
+                    std::fill(eigenvectors, eigenvectors + static_cast<size_t>(mSize) * static_cast<size_t>(mSize), (Real)0);
+                    for (int32_t d = 0; d < mSize; ++d)
                     {
-                        mVVector[r] = column[mSize * r];
+                        eigenvectors[d + mSize * d] = (Real)1;
                     }
 
-                    // Compute the w vector.
-                    for (r = 0; r < mSize; ++r)
+                    // Multiply the Householder reflections using backward
+                    // accumulation.
+                    int32_t r, c;
+                    for (int32_t i = mSize - 3, rmin = i + 1; i >= 0; --i, --rmin)
                     {
-                        mWVector[r] = (Real)0;
-                        for (c = rmin; c < mSize; ++c)
+                        // Copy the v vector and 2/Dot(v,v) from the matrix.
+                        Real const* column = &mMatrix[i];
+                        Real twoinvvdv = column[mSize * (i + 1)];
+                        for (r = 0; r < i + 1; ++r)
                         {
-                            mWVector[r] += mVVector[c] * eigenvectors[r + mSize * c];
+                            mVVector[r] = (Real)0;
+                        }
+                        mVVector[r] = (Real)1;
+                        for (++r; r < mSize; ++r)
+                        {
+                            mVVector[r] = column[mSize * r];
                         }
-                        mWVector[r] *= twoinvvdv;
-                    }
 
-                    // Update the matrix, Q <- Q - v*w^T.
-                    for (r = rmin; r < mSize; ++r)
-                    {
-                        for (c = 0; c < mSize; ++c)
+                        // Compute the w vector.
+                        for (r = 0; r < mSize; ++r)
                         {
-                            eigenvectors[c + mSize * r] -= mVVector[r] * mWVector[c];
+                            mWVector[r] = (Real)0;
+                            for (c = rmin; c < mSize; ++c)
+                            {
+                                mWVector[r] += mVVector[c] * eigenvectors[r + mSize * c];
+                            }
+                            mWVector[r] *= twoinvvdv;
+                        }
+
+                        // Update the matrix, Q <- Q - v*w^T.
+                        for (r = rmin; r < mSize; ++r)
+                        {
+                            for (c = 0; c < mSize; ++c)
+                            {
+                                eigenvectors[c + mSize * r] -= mVVector[r] * mWVector[c];
+                            }
                         }
                     }
-                }
 
-                // Multiply the Givens rotations.
-                for (auto const& givens : mGivens)
-                {
-                    for (r = 0; r < mSize; ++r)
+                    // Multiply the Givens rotations.
+                    for (auto const& givens : mGivens)
                     {
-                        int32_t j = givens.index + mSize * r;
-                        Real& q0 = eigenvectors[j];
-                        Real& q1 = eigenvectors[j + 1];
-                        Real prd0 = givens.cs * q0 - givens.sn * q1;
-                        Real prd1 = givens.sn * q0 + givens.cs * q1;
-                        q0 = prd0;
-                        q1 = prd1;
+                        for (r = 0; r < mSize; ++r)
+                        {
+                            int32_t j = givens.index + mSize * r;
+                            Real& q0 = eigenvectors[j];
+                            Real& q1 = eigenvectors[j + 1];
+                            Real prd0 = givens.cs * q0 - givens.sn * q1;
+                            Real prd1 = givens.sn * q0 + givens.cs * q1;
+                            q0 = prd0;
+                            q1 = prd1;
+                        }
                     }
                 }
 
@@ -307,8 +351,13 @@ namespace gte
                 // rotation; otherwise, H is odd and the product is a
                 // reflection.  The number of Givens rotations does not
                 // influence the type of the product of Householder
-                // reflections.
+                // reflections.  The eigenvector matrix of the tridiagonal
+                // matrix computed by divide-and-conquer can be a reflection.
                 mEigenvectorMatrixType = 1 - (mSize & 1);
+                if (mTridiagonalReflection)
+                {
+                    mEigenvectorMatrixType = 1 - mEigenvectorMatrixType;
+                }
 
                 if (mPermutation[0] >= 0)
                 {
@@ -368,16 +417,20 @@ namespace gte
                 Real* x = eigenvector;
                 Real* y = &mPVector[0];
 
-                // Start with the Euclidean basis vector.
-                std::memset(x, 0, mSize * sizeof(Real));
-                if (mPermutation[0] >= 0)
+                int32_t const p = (mPermutation[0] >= 0 ? mPermutation[c] : c);
+                if (mAlgorithm == Algorithm::DIVIDE_AND_CONQUER)
                 {
-                    // Sorting was requested.
-                    x[mPermutation[c]] = (Real)1;
+                    // Start with the eigenvector of the tridiagonal matrix.
+                    for (int32_t r = 0; r < mSize; ++r)
+                    {
+                        x[r] = mTridiagonalEigenvectors[p + static_cast<size_t>(mSize) * r];
+                    }
                 }
                 else
                 {
-                    x[c] = (Real)1;
+                    // Start with the Euclidean basis vector.
+                    std::memset(x, 0, mSize * sizeof(Real));
+                    x[p] = (Real)1;
                 }
 
                 // Apply the Givens rotations.
@@ -512,6 +565,14 @@ namespace gte
                         vdv += vr * vr;
                     }
                 }
+                else
+                {
+                    // The column is already zero below the subdiagonal.
+                    // The eigenvector construction assumes the reflection
+                    // for v = (0,...,0,1,0,...,0) with 1 at index i+1, so
+                    // that reflection must also be applied to the matrix.
+                    mVVector[ip1] = (Real)1;
+                }
 
                 // Compute the rank-1 offsets v*w^T and w*v^T.
                 Real invvdv = (Real)1 / vdv;
@@ -577,7 +638,7 @@ namespace gte
         }
 
         // A helper for generating Givens rotation sine and cosine robustly.
-        void GetSinCos(Real x, Real y, Real& cs, Real& sn)
+        static void GetSinCos(Real x, Real y, Real& cs, Real& sn)
         {
             // Solves sn*x + cs*y = 0 robustly.
             Real tau;
@@ -611,20 +672,24 @@ namespace gte
         // allows for parallelization of the algorithm.  The inputs imin and
         // imax identify the subblock of T to be processed.   That block has
         // upper-left element T(imin,imin) and lower-right element
-        // T(imax,imax).
-        void DoQRImplicitShift(int32_t imin, int32_t imax)
+        // T(imax,imax).  The diagonal and superdiagonal of T are passed as
+        // arrays and each Givens rotation is reported by the call
+        // onGivens(index, cs, sn).
+        template <typename OnGivens>
+        static void DoQRImplicitShift(int32_t imin, int32_t imax,
+            Real* diagonal, Real* superdiagonal, OnGivens const& onGivens)
         {
             // The implicit shift.  Compute the eigenvalue u of the
             // lower-right 2x2 block that is closer to a11.
-            Real a00 = mDiagonal[imax];
-            Real a01 = mSuperdiagonal[imax];
-            Real a11 = mDiagonal[static_cast<size_t>(imax) + 1];
+            Real a00 = diagonal[imax];
+            Real a01 = superdiagonal[imax];
+            Real a11 = diagonal[static_cast<size_t>(imax) + 1];
             Real dif = (a00 - a11) * (Real)0.5;
             Real sgn = (dif >= (Real)0 ? (Real)1 : (Real)-1);
             Real a01sqr = a01 * a01;
             Real u = a11 - a01sqr / (dif + sgn * std::sqrt(dif * dif + a01sqr));
-            Real x = mDiagonal[imin] - u;
-            Real y = mSuperdiagonal[imin];
+            Real x = diagonal[imin] - u;
+            Real y = superdiagonal[imin];
 
             Real a12, a22, a23, tmp11, tmp12, tmp21, tmp22, cs, sn;
             Real a02 = (Real)0;
@@ -634,7 +699,7 @@ namespace gte
                 // Compute the Givens rotation and save it for use in
                 // computing the eigenvectors.
                 GetSinCos(x, y, cs, sn);
-                mGivens.push_back(GivensRotation(i1, cs, sn));
+                onGivens(i1, cs, sn);
 
                 // Update the tridiagonal matrix.  This amounts to updating a
                 // 4x4 subblock,
@@ -651,33 +716,940 @@ namespace gte
                 // values (b01, b02, b13, b23) change.
                 if (i1 > imin)
                 {
-                    mSuperdiagonal[i0] = cs * mSuperdiagonal[i0] - sn * a02;
+                    superdiagonal[i0] = cs * superdiagonal[i0] - sn * a02;
                 }
 
-                a11 = mDiagonal[i1];
-                a12 = mSuperdiagonal[i1];
-                a22 = mDiagonal[i2];
+                a11 = diagonal[i1];
+                a12 = superdiagonal[i1];
+                a22 = diagonal[i2];
                 tmp11 = cs * a11 - sn * a12;
                 tmp12 = cs * a12 - sn * a22;
                 tmp21 = sn * a11 + cs * a12;
                 tmp22 = sn * a12 + cs * a22;
-                mDiagonal[i1] = cs * tmp11 - sn * tmp12;
-                mSuperdiagonal[i1] = sn * tmp11 + cs * tmp12;
-                mDiagonal[i2] = sn * tmp21 + cs * tmp22;
+                diagonal[i1] = cs * tmp11 - sn * tmp12;
+                superdiagonal[i1] = sn * tmp11 + cs * tmp12;
+                diagonal[i2] = sn * tmp21 + cs * tmp22;
 
                 if (i1 < imax)
                 {
-                    a23 = mSuperdiagonal[i2];
+                    a23 = superdiagonal[i2];
                     a02 = -sn * a23;
-                    mSuperdiagonal[i2] = cs * a23;
+                    superdiagonal[i2] = cs * a23;
 
                     // Update the parameters for the next Givens rotation.
-                    x = mSuperdiagonal[i1];
+                    x = superdiagonal[i1];
                     y = a02;
                 }
             }
         }
 
+        // Reduce the tridiagonal matrix with the specified diagonal and
+        // superdiagonal to a diagonal matrix using implicit QR steps.  Each
+        // Givens rotation is reported by the call onGivens(index, cs, sn).
+        // The return value is the number of iterations consumed when
+        // convergence occurred or 0xFFFFFFFF when convergence did not occur.
+        template <typename OnGivens>
+        static uint32_t ReduceTridiagonal(int32_t size, uint32_t maxIterations,
+            Real* diagonal, Real* superdiagonal, OnGivens const& onGivens)
+        {
+            for (uint32_t j = 0; j < maxIterations; ++j)
+            {
+                int32_t imin = -1, imax = -1;
+                for (int32_t i = size - 2; i >= 0; --i)
+                {
+                    // When a01 is much smaller than its diagonal
+                    // neighbors, it is effectively zero.
+                    Real a00 = diagonal[i];
+                    Real a01 = superdiagonal[i];
+                    Real a11 = diagonal[static_cast<size_t>(i) + 1];
+                    Real sum = std::fabs(a00) + std::fabs(a11);
+                    if (sum + std::fabs(a01) != sum)
+                    {
+                        if (imax == -1)
+                        {
+                            imax = i;
+                        }
+                        imin = i;
+                    }
+                    else
+                    {
+                        // The superdiagonal term is effectively zero
+                        // compared to the neighboring diagonal terms.
+                        if (imin >= 0)
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                if (imax == -1)
+                {
+                    // The algorithm has converged.
+                    return j;
+                }
+
+                // Process the lower-right-most unreduced tridiagonal
+                // block.
+                DoQRImplicitShift(imin, imax, diagonal, superdiagonal, onGivens);
+            }
+            return 0xFFFFFFFF;
+        }
+
+        // Support for the divide-and-conquer algorithm.
+
+        // The number of Householder reflections accumulated in a panel of
+        // the blocked tridiagonalization.
+        static std::size_t constexpr panelSize = 32;
+
+        // Tridiagonal blocks with at most this many rows are solved by the
+        // QR algorithm.
+        static std::size_t constexpr leafSize = 32;
+
+        // The number of columns of a block in the matrix products.
+        static std::size_t constexpr columnBlockSize = 256;
+
+        // The number of rows of a block in the matrix products.
+        static std::size_t constexpr rowBlockSize = 128;
+
+        // Matrix operations on fewer rows than this are not distributed
+        // among threads.
+        static std::size_t constexpr minThreadedSize = 256;
+
+        // Execute function(t) for 0 <= t < numThreads, each call in its own
+        // thread when numThreads > 1.
+        template <typename Function>
+        static void RunThreads(std::size_t numThreads, Function const& function)
+        {
+            if (numThreads <= 1)
+            {
+                function(0);
+                return;
+            }
+
+            std::vector<std::thread> process(numThreads);
+            for (std::size_t t = 0; t < numThreads; ++t)
+            {
+                process[t] = std::thread([&function, t]() { function(t); });
+            }
+            for (std::size_t t = 0; t < numThreads; ++t)
+            {
+                process[t].join();
+            }
+        }
+
+        // Tridiagonalize using Householder reflections that are applied to
+        // the trailing matrix in panels of panelSize reflections.  Only the
+        // upper-triangular part of the trailing matrix is updated.  On
+        // output, the Householder vectors and 2/Dot(v,v) are stored in
+        // mMatrix as described for Tridiagonalize() and the tridiagonal
+        // matrix is stored in mDiagonal and mSuperdiagonal.
+        void TridiagonalizeBlocked()
+        {
+            std::size_t const n = static_cast<std::size_t>(mSize);
+            std::size_t const numReflections = n - 2;
+            Real* A = mMatrix.data();
+
+            // V and W store the vectors v and w of the reflections of the
+            // current panel, each in n contiguous elements.  After the
+            // panel is processed, the trailing matrix is updated by
+            // A <- A - V*W^T - W*V^T.  Within the panel, the entries of the
+            // trailing matrix are not updated, so the products of the
+            // trailing matrix with v are corrected by the terms V*W^T*v and
+            // W*V^T*v.
+            std::vector<Real> V(panelSize * n), W(panelSize * n), P(n);
+            std::vector<Real> partial(mNumThreads * n);
+            for (std::size_t i0 = 0; i0 < numReflections; i0 += panelSize)
+            {
+                std::size_t const i1 = std::min(i0 + panelSize, numReflections);
+                for (std::size_t j = i0; j < i1; ++j)
+                {
+                    // Apply the previous reflections of the panel to row j,
+                    // which is column j by symmetry.
+                    std::size_t const k = j - i0;
+                    Real* rowJ = A + j * n;
+                    for (std::size_t l = 0; l < k; ++l)
+                    {
+                        Real const* Vl = &V[l * n];
+                        Real const* Wl = &W[l * n];
+                        Real const vj = Vl[j], wj = Wl[j];
+                        for (std::size_t c = j; c < n; ++c)
+                        {
+                            rowJ[c] -= vj * Wl[c] + wj * Vl[c];
+                        }
+                    }
+                    mDiagonal[j] = rowJ[j];
+
+                    // Compute the Householder vector for the entries of
+                    // row j after the diagonal.  If they are all zero, the
+                    // reflection for v = (0,...,0,1,0,...,0) is used as in
+                    // Tridiagonalize().
+                    Real* v = &V[k * n];
+                    std::fill(v, v + j + 1, (Real)0);
+                    Real length = (Real)0;
+                    for (std::size_t c = j + 1; c < n; ++c)
+                    {
+                        length += rowJ[c] * rowJ[c];
+                    }
+                    length = std::sqrt(length);
+                    Real vdv = (Real)1;
+                    v[j + 1] = (Real)1;
+                    if (length > (Real)0)
+                    {
+                        Real const v1 = rowJ[j + 1];
+                        Real const sgn = (v1 >= (Real)0 ? (Real)1 : (Real)-1);
+                        Real const invDenom = ((Real)1) / (v1 + sgn * length);
+                        for (std::size_t c = j + 2; c < n; ++c)
+                        {
+                            v[c] = rowJ[c] * invDenom;
+                            vdv += v[c] * v[c];
+                        }
+                        mSuperdiagonal[j] = -sgn * length;
+                    }
+                    else
+                    {
+                        std::fill(v + j + 2, v + n, (Real)0);
+                        mSuperdiagonal[j] = (Real)0;
+                    }
+                    Real const invvdv = (Real)1 / vdv;
+                    Real const twoinvvdv = invvdv * (Real)2;
+
+                    // Compute p = (2/Dot(v,v))*(A - V*W^T - W*V^T)*v for the
+                    // trailing rows, where A is the trailing matrix at the
+                    // beginning of the panel.
+                    Real* p = P.data();
+                    MultiplySymmetric(j + 1, v, p, partial);
+                    for (std::size_t l = 0; l < k; ++l)
+                    {
+                        Real const* Vl = &V[l * n];
+                        Real const* Wl = &W[l * n];
+                        Real wldv = (Real)0, vldv = (Real)0;
+                        for (std::size_t r = j + 1; r < n; ++r)
+                        {
+                            wldv += Wl[r] * v[r];
+                            vldv += Vl[r] * v[r];
+                        }
+                        for (std::size_t r = j + 1; r < n; ++r)
+                        {
+                            p[r] -= Vl[r] * wldv + Wl[r] * vldv;
+                        }
+                    }
+
+                    // Compute w = p - (Dot(p,v)/Dot(v,v))*v.
+                    Real pdvtvdv = (Real)0;
+                    for (std::size_t r = j + 1; r < n; ++r)
+                    {
+                        p[r] *= twoinvvdv;
+                        pdvtvdv += p[r] * v[r];
+                    }
+                    pdvtvdv *= invvdv;
+                    Real* w = &W[k * n];
+                    std::fill(w, w + j + 1, (Real)0);
+                    for (std::size_t r = j + 1; r < n; ++r)
+                    {
+                        w[r] = p[r] - pdvtvdv * v[r];
+                    }
+
+                    // Copy the vector to column j of the matrix.
+                    A[(j + 1) * n + j] = twoinvvdv;
+                    for (std::size_t r = j + 2; r < n; ++r)
+                    {
+                        A[r * n + j] = v[r];
+                    }
+                }
+
+                // Update the upper-triangular part of the trailing matrix.
+                // The rows are interleaved among the threads, which
+                // balances the work for the triangular part.
+                std::size_t const numPanel = i1 - i0;
+                std::size_t const numThreads = (n - i1 >= minThreadedSize ? mNumThreads : 1);
+                RunThreads(numThreads, [&](std::size_t t)
+                {
+                    for (std::size_t r = i1 + t; r < n; r += numThreads)
+                    {
+                        Real* row = A + r * n;
+                        for (std::size_t l = 0; l < numPanel; ++l)
+                        {
+                            Real const* Vl = &V[l * n];
+                            Real const* Wl = &W[l * n];
+                            Real const vr = Vl[r], wr = Wl[r];
+                            for (std::size_t c = r; c < n; ++c)
+                            {
+                                row[c] -= vr * Wl[c] + wr * Vl[c];
+                            }
+                        }
+                    }
+                });
+            }
+
+            // Copy the last 2x2 block of the tridiagonal matrix.
+            mDiagonal[n - 2] = A[(n - 2) * n + n - 2];
+            mSuperdiagonal[n - 2] = A[(n - 2) * n + n - 1];
+            mDiagonal[n - 1] = A[(n - 1) * n + n - 1];
+        }
+
+        // Compute p = A*v for the rows and columns of A with indices at
+        // least rowMin, where A is the symmetric matrix whose
+        // upper-triangular part is stored in mMatrix.  Each entry of the
+        // upper-triangular part is read once and contributes to two
+        // components of p.  The rows are interleaved among the threads,
+        // each thread accumulating into its own part of 'partial', and the
+        // parts are added in thread order.
+        void MultiplySymmetric(std::size_t rowMin, Real const* v, Real* p,
+            std::vector<Real>& partial) const
+        {
+            std::size_t const n = static_cast<std::size_t>(mSize);
+            Real const* A = mMatrix.data();
+            std::size_t const numThreads = (n - rowMin >= minThreadedSize ? mNumThreads : 1);
+            RunThreads(numThreads, [&](std::size_t t)
+            {
+                Real* sum = &partial[t * n];
+                std::fill(sum + rowMin, sum + n, (Real)0);
+                for (std::size_t r = rowMin + t; r < n; r += numThreads)
+                {
+                    Real const* row = A + r * n;
+                    Real const vr = v[r];
+                    Real dot = row[r] * vr;
+                    for (std::size_t c = r + 1; c < n; ++c)
+                    {
+                        dot += row[c] * v[c];
+                        sum[c] += row[c] * vr;
+                    }
+                    sum[r] += dot;
+                }
+            });
+
+            std::copy(partial.begin() + rowMin, partial.begin() + n, p + rowMin);
+            for (std::size_t t = 1; t < numThreads; ++t)
+            {
+                Real const* sum = &partial[t * n];
+                for (std::size_t r = rowMin; r < n; ++r)
+                {
+                    p[r] += sum[r];
+                }
+            }
+        }
+
+        // Compute the eigenvalues and eigenvectors of the m x m tridiagonal
+        // matrix with diagonal d and superdiagonal e.  On output, d stores
+        // the eigenvalues and the columns of the row-major matrix Q store
+        // the corresponding eigenvectors.  The 'reflection' output is true
+        // when Q is a reflection.  The return value is the total number of
+        // QR iterations for the blocks with at most leafSize rows or
+        // 0xFFFFFFFF when one of them did not converge.
+        uint32_t DivideAndConquer(std::size_t m, Real* d, Real const* e,
+            Real* Q, std::size_t numThreads, bool& reflection) const
+        {
+            if (m <= leafSize)
+            {
+                // The Givens rotations are accumulated as in
+                // GetEigenvectors(Real*), so Q is a rotation.
+                std::fill(Q, Q + m * m, (Real)0);
+                for (std::size_t i = 0; i < m; ++i)
+                {
+                    Q[i * m + i] = (Real)1;
+                }
+                reflection = false;
+
+                std::vector<Real> superdiagonal(e, e + m - 1);
+                return ReduceTridiagonal(static_cast<int32_t>(m), mMaxIterations,
+                    d, superdiagonal.data(),
+                    [m, Q](int32_t index, Real cs, Real sn)
+                    {
+                        for (std::size_t r = 0; r < m; ++r)
+                        {
+                            Real* q = Q + r * m + index;
+                            Real const q0 = q[0], q1 = q[1];
+                            q[0] = cs * q0 - sn * q1;
+                            q[1] = sn * q0 + cs * q1;
+                        }
+                    });
+            }
+
+            // T = diag(T0, T1) + rho*u*u^T, where u has 1 at index m0 - 1
+            // and sign(beta) at index m0, and where T0 and T1 are the
+            // diagonal blocks of T with rho = |beta| subtracted from the
+            // adjacent corner entries.
+            std::size_t const m0 = m / 2, m1 = m - m0;
+            Real const beta = e[m0 - 1];
+            Real const rho = std::fabs(beta);
+            std::vector<Real> d0(d, d + m0), d1(d + m0, d + m);
+            d0[m0 - 1] -= rho;
+            d1[0] -= rho;
+
+            std::vector<Real> Q0(m0 * m0), Q1(m1 * m1);
+            bool reflection0 = false, reflection1 = false;
+            uint32_t numIterations0 = 0, numIterations1 = 0;
+            if (numThreads > 1)
+            {
+                std::size_t const numThreads0 = numThreads / 2;
+                std::thread process([&]()
+                {
+                    numIterations0 = DivideAndConquer(m0, d0.data(), e, Q0.data(),
+                        numThreads0, reflection0);
+                });
+                numIterations1 = DivideAndConquer(m1, d1.data(), e + m0, Q1.data(),
+                    numThreads - numThreads0, reflection1);
+                process.join();
+            }
+            else
+            {
+                numIterations0 = DivideAndConquer(m0, d0.data(), e, Q0.data(), 1, reflection0);
+                numIterations1 = DivideAndConquer(m1, d1.data(), e + m0, Q1.data(), 1, reflection1);
+            }
+
+            if (numIterations0 == 0xFFFFFFFF || numIterations1 == 0xFFFFFFFF)
+            {
+                return 0xFFFFFFFF;
+            }
+
+            reflection = Merge(d0, Q0, d1, Q1, rho, beta < (Real)0, d, Q, numThreads);
+            reflection = (reflection != (reflection0 != reflection1));
+            return numIterations0 + numIterations1;
+        }
+
+        // Compute the eigensystem of T = diag(T0, T1) + rho*u*u^T from the
+        // eigensystems T0 = Q0*diag(d0)*Q0^T and T1 = Q1*diag(d1)*Q1^T.
+        // With Qhat = diag(Q0, Q1) and z = Qhat^T*u, which is the last row
+        // of Q0 followed by the first row of Q1 (negated when beta < 0),
+        //   T = Qhat*(diag(d0, d1) + rho*z*z^T)*Qhat^T.
+        // The return value is true when the product of Qhat^T with the
+        // output eigenvector matrix Q is a reflection.
+        bool Merge(std::vector<Real> const& d0, std::vector<Real>& Q0,
+            std::vector<Real> const& d1, std::vector<Real>& Q1, Real rho,
+            bool negate, Real* d, Real* Q, std::size_t numThreads) const
+        {
+            std::size_t const m0 = d0.size(), m1 = d1.size(), m = m0 + m1;
+
+            // Qhat is stored as an m x m matrix, because the deflation
+            // rotations can combine columns of Q0 and Q1.  The type of a
+            // column is 0 when it is nonzero only in the rows of Q0, 2 when
+            // it is nonzero only in the rows of Q1 or 1 otherwise.
+            std::vector<Real> Qhat(m * m, (Real)0), D(m), z(m);
+            std::vector<int32_t> type(m);
+            for (std::size_t r = 0; r < m0; ++r)
+            {
+                std::copy(&Q0[r * m0], &Q0[r * m0] + m0, &Qhat[r * m]);
+            }
+            for (std::size_t r = 0; r < m1; ++r)
+            {
+                std::copy(&Q1[r * m1], &Q1[r * m1] + m1, &Qhat[(m0 + r) * m + m0]);
+            }
+            for (std::size_t c = 0; c < m0; ++c)
+            {
+                D[c] = d0[c];
+                z[c] = Q0[(m0 - 1) * m0 + c];
+                type[c] = 0;
+            }
+            for (std::size_t c = 0; c < m1; ++c)
+            {
+                D[m0 + c] = d1[c];
+                z[m0 + c] = (negate ? -Q1[c] : Q1[c]);
+                type[m0 + c] = 2;
+            }
+            std::vector<Real>().swap(Q0);
+            std::vector<Real>().swap(Q1);
+
+            // Normalize z and scale rho accordingly.
+            Real zLength = (Real)0;
+            for (auto const& value : z)
+            {
+                zLength += value * value;
+            }
+            zLength = std::sqrt(zLength);
+            for (auto& value : z)
+            {
+                value /= zLength;
+            }
+            rho *= zLength * zLength;
+
+            // Deflation.  In increasing order of D, an index is deflated
+            // when rho*|z[i]| is negligible, in which case D[i] is an
+            // eigenvalue with eigenvector column i of Qhat.  When the
+            // previous nondeflated index j has D[j] close to D[i], the
+            // rotation of columns j and i of Qhat that zeroes z[j] makes
+            // the off-diagonal term negligible and j is deflated.  The
+            // rotations preserve the increasing order of D for the
+            // nondeflated indices.
+            std::vector<std::size_t> order(m);
+            for (std::size_t i = 0; i < m; ++i)
+            {
+                order[i] = i;
+            }
+            std::stable_sort(order.begin(), order.end(),
+                [&D](std::size_t i0, std::size_t i1)
+                {
+                    return D[i0] < D[i1];
+                });
+
+            Real maxD = (Real)0;
+            for (auto const& value : D)
+            {
+                maxD = std::max(maxD, std::fabs(value));
+            }
+            Real const tolerance = (Real)8 * std::numeric_limits<Real>::epsilon() * std::max(maxD, rho);
+
+            std::vector<std::size_t> nondeflated, deflated;
+            nondeflated.reserve(m);
+            deflated.reserve(m);
+            for (auto i : order)
+            {
+                if (rho * std::fabs(z[i]) <= tolerance)
+                {
+                    deflated.push_back(i);
+                    continue;
+                }
+
+                if (nondeflated.size() > 0)
+                {
+                    std::size_t const j = nondeflated.back();
+                    Real const length = std::sqrt(z[i] * z[i] + z[j] * z[j]);
+                    Real const cs = z[i] / length, sn = z[j] / length;
+                    if (std::fabs(cs * sn * (D[j] - D[i])) <= tolerance)
+                    {
+                        for (std::size_t r = 0; r < m; ++r)
+                        {
+                            Real* row = &Qhat[r * m];
+                            Real const qj = row[j], qi = row[i];
+                            row[j] = cs * qj - sn * qi;
+                            row[i] = sn * qj + cs * qi;
+                        }
+                        Real const Dj = D[j], Di = D[i];
+                        D[j] = cs * cs * Dj + sn * sn * Di;
+                        D[i] = sn * sn * Dj + cs * cs * Di;
+                        z[j] = (Real)0;
+                        z[i] = length;
+                        if (type[j] != type[i])
+                        {
+                            type[j] = 1;
+                            type[i] = 1;
+                        }
+                        nondeflated.pop_back();
+                        deflated.push_back(j);
+                    }
+                }
+                nondeflated.push_back(i);
+            }
+
+            // The eigenvalues and eigenvectors for the nondeflated indices
+            // are stored first, followed by those of the deflated indices.
+            std::size_t const K = nondeflated.size();
+            for (std::size_t t = 0; t < deflated.size(); ++t)
+            {
+                std::size_t const i = deflated[t];
+                d[K + t] = D[i];
+                for (std::size_t r = 0; r < m; ++r)
+                {
+                    Q[r * m + K + t] = Qhat[r * m + i];
+                }
+            }
+
+            // The output is Q = Qhat*M, where M is the identity on the
+            // deflated indices and the eigenvector matrix X of
+            // diag(dd) + rho*zz*zz^T on the nondeflated indices.  The
+            // determinant of M is that of X times the sign of the
+            // permutation that maps the nondeflated indices to 0..K-1 and
+            // the deflated indices to K..m-1.  X is a Cauchy matrix with
+            // row scales zhat[s] and positive column scales, and because
+            // the eigenvalues interlace with dd, the sign of the
+            // determinant of the Cauchy matrix is (-1)^K.
+            std::vector<std::size_t> permutation(nondeflated);
+            permutation.insert(permutation.end(), deflated.begin(), deflated.end());
+            bool reflection = (GetPermutationParity(permutation) != ((K & 1) != 0));
+            if (K == 0)
+            {
+                return reflection;
+            }
+
+            std::vector<Real> dd(K), zz(K);
+            for (std::size_t s = 0; s < K; ++s)
+            {
+                dd[s] = D[nondeflated[s]];
+                zz[s] = z[nondeflated[s]];
+                if (zz[s] < (Real)0)
+                {
+                    reflection = !reflection;
+                }
+            }
+
+            // Solve the secular equation.  Root j is dd[origin[j]]+mu[j].
+            std::vector<std::size_t> origin(K);
+            std::vector<Real> mu(K);
+            std::size_t numLocalThreads = (K >= minThreadedSize ? numThreads : 1);
+            RunThreads(numLocalThreads, [&](std::size_t t)
+            {
+                for (std::size_t j = t; j < K; j += numLocalThreads)
+                {
+                    SolveSecularEquation(dd, zz, rho, j, origin[j], mu[j]);
+                }
+            });
+            for (std::size_t j = 0; j < K; ++j)
+            {
+                d[j] = dd[origin[j]] + mu[j];
+            }
+
+            // delta(s,j) = dd[s] - lambda[j], computed relative to the
+            // pole closest to lambda[j].
+            auto delta = [&dd, &origin, &mu](std::size_t s, std::size_t j)
+            {
+                return (dd[s] - dd[origin[j]]) - mu[j];
+            };
+
+            // Compute zhat by the Gu-Eisenstat formula
+            //   zhat[s]^2 = prod_j (lambda[j] - dd[s])
+            //     / (rho * prod_{j != s} (dd[j] - dd[s])),
+            // for which the computed eigenvalues are the exact eigenvalues
+            // of diag(dd) + rho*zhat*zhat^T.  The factors are paired so
+            // that each ratio is positive.
+            std::vector<Real> zhat(K);
+            RunThreads(numLocalThreads, [&](std::size_t t)
+            {
+                for (std::size_t s = t; s < K; s += numLocalThreads)
+                {
+                    Real product = -delta(s, K - 1) / rho;
+                    for (std::size_t j = 0; j < s; ++j)
+                    {
+                        product *= delta(s, j) / (dd[s] - dd[j]);
+                    }
+                    for (std::size_t j = s; j + 1 < K; ++j)
+                    {
+                        product *= -delta(s, j) / (dd[j + 1] - dd[s]);
+                    }
+                    Real const length = std::sqrt(std::max(product, (Real)0));
+                    zhat[s] = (zz[s] >= (Real)0 ? length : -length);
+                }
+            });
+
+            // The eigenvector for lambda[j] has components
+            // zhat[s]/delta(s,j), stored in column j of X after
+            // normalization.
+            std::vector<Real> X(K * K);
+            RunThreads(numLocalThreads, [&](std::size_t t)
+            {
+                for (std::size_t j = t; j < K; j += numLocalThreads)
+                {
+                    Real sqrLength = (Real)0;
+                    for (std::size_t s = 0; s < K; ++s)
+                    {
+                        Real const value = zhat[s] / delta(s, j);
+                        X[s * K + j] = value;
+                        sqrLength += value * value;
+                    }
+                    Real const invLength = (Real)1 / std::sqrt(sqrLength);
+                    for (std::size_t s = 0; s < K; ++s)
+                    {
+                        X[s * K + j] *= invLength;
+                    }
+                }
+            });
+
+            // Compute the first K columns of Q = Qhat*M.  The nondeflated
+            // columns of Qhat are grouped by type, so the rows of Q0 use
+            // only the columns of types 0 and 1 and the rows of Q1 use only
+            // the columns of types 1 and 2.  The products are computed in
+            // blocks of rowBlockSize rows of X by columnBlockSize columns
+            // of X, which remain in cache while the rows of Q are updated.
+            std::vector<std::size_t> group;
+            group.reserve(K);
+            std::size_t numType[3] = { 0, 0, 0 };
+            for (int32_t k = 0; k < 3; ++k)
+            {
+                for (std::size_t s = 0; s < K; ++s)
+                {
+                    if (type[nondeflated[s]] == k)
+                    {
+                        group.push_back(s);
+                        ++numType[k];
+                    }
+                }
+            }
+            std::size_t const lSup0 = numType[0] + numType[1];
+            std::size_t const lMin1 = numType[0];
+
+            for (std::size_t r = 0; r < m; ++r)
+            {
+                std::fill(Q + r * m, Q + r * m + K, (Real)0);
+            }
+
+            numLocalThreads = (m >= minThreadedSize ? numThreads : 1);
+            RunThreads(numLocalThreads, [&](std::size_t t)
+            {
+                for (std::size_t l0 = 0; l0 < K; l0 += rowBlockSize)
+                {
+                    std::size_t const l1 = std::min(l0 + rowBlockSize, K);
+                    for (std::size_t j0 = 0; j0 < K; j0 += columnBlockSize)
+                    {
+                        std::size_t const j1 = std::min(j0 + columnBlockSize, K);
+                        for (std::size_t r = t; r < m; r += numLocalThreads)
+                        {
+                            std::size_t const lMin = std::max(l0, (r < m0 ? 0 : lMin1));
+                            std::size_t const lSup = std::min(l1, (r < m0 ? lSup0 : K));
+                            Real* row = Q + r * m;
+                            Real const* qhat = &Qhat[r * m];
+                            for (std::size_t l = lMin; l < lSup; ++l)
+                            {
+                                std::size_t const s = group[l];
+                                Real const value = qhat[nondeflated[s]];
+                                Real const* xRow = &X[s * K];
+                                for (std::size_t j = j0; j < j1; ++j)
+                                {
+                                    row[j] += value * xRow[j];
+                                }
+                            }
+                        }
+                    }
+                }
+            });
+
+            return reflection;
+        }
+
+        // Compute root j of the secular equation
+        //   f(lambda) = 1/rho + sum_s zz[s]^2/(dd[s] - lambda) = 0
+        // for increasing dd, nonzero zz and rho > 0.  The root is in the
+        // interval (dd[j], dd[j+1]) for j < K-1 or (dd[K-1], dd[K-1] +
+        // rho*|zz|^2) for j = K-1.  It is represented as dd[origin] + mu,
+        // where origin is the index of the closer endpoint, so that the
+        // differences dd[s] - lambda = (dd[s] - dd[origin]) - mu are
+        // computed accurately.  The iteration uses the rational model
+        // c + q/(dd[j] - lambda) + r/(dd[j+1] - lambda) of f that matches
+        // the value and derivative of the sums for the poles on each side
+        // of the interval, safeguarded by bisection of the interval on
+        // which f changes sign.
+        static void SolveSecularEquation(std::vector<Real> const& dd,
+            std::vector<Real> const& zz, Real rho, std::size_t j,
+            std::size_t& origin, Real& mu)
+        {
+            std::size_t const K = dd.size();
+            Real const zero = (Real)0, half = (Real)0.5;
+            Real const invRho = (Real)1 / rho;
+            Real const epsilon = std::numeric_limits<Real>::epsilon();
+
+            Real lower, upper;
+            if (j + 1 < K)
+            {
+                Real const gap = dd[j + 1] - dd[j];
+                Real const middle = half * gap;
+                Real f = invRho;
+                for (std::size_t s = 0; s < K; ++s)
+                {
+                    f += zz[s] * zz[s] / ((dd[s] - dd[j]) - middle);
+                }
+
+                // The function f is increasing on the interval.
+                if (f >= zero)
+                {
+                    origin = j;
+                    lower = zero;
+                    upper = middle;
+                }
+                else
+                {
+                    origin = j + 1;
+                    lower = middle - gap;
+                    upper = zero;
+                }
+            }
+            else
+            {
+                Real sqrLength = zero;
+                for (std::size_t s = 0; s < K; ++s)
+                {
+                    sqrLength += zz[s] * zz[s];
+                }
+                origin = j;
+                lower = zero;
+                upper = rho * sqrLength;
+            }
+
+            Real const dOrigin = dd[origin];
+            mu = half * (lower + upper);
+            for (uint32_t iteration = 0; iteration < 128; ++iteration)
+            {
+                // The sums and derivatives for the poles on the left
+                // (psi) and on the right (phi) of the interval.
+                Real psi = zero, dpsi = zero, phi = zero, dphi = zero;
+                for (std::size_t s = 0; s <= j; ++s)
+                {
+                    Real const ratio = zz[s] / ((dd[s] - dOrigin) - mu);
+                    psi += zz[s] * ratio;
+                    dpsi += ratio * ratio;
+                }
+                for (std::size_t s = j + 1; s < K; ++s)
+                {
+                    Real const ratio = zz[s] / ((dd[s] - dOrigin) - mu);
+                    phi += zz[s] * ratio;
+                    dphi += ratio * ratio;
+                }
+
+                Real const f = invRho + psi + phi;
+                if (f < zero)
+                {
+                    lower = mu;
+                }
+                else if (f > zero)
+                {
+                    upper = mu;
+                }
+                else
+                {
+                    break;
+                }
+
+                Real const fTolerance = (Real)8 * epsilon *
+                    (invRho + std::fabs(psi) + std::fabs(phi));
+                if (std::fabs(f) <= fTolerance ||
+                    upper - lower <= (Real)2 * epsilon * std::max(std::fabs(lower), std::fabs(upper)))
+                {
+                    break;
+                }
+
+                // Solve the rational model for the step h, where a and b
+                // are the differences of the poles and mu.  The model value
+                // at h = 0 is f, so its numerator polynomial is
+                // c*h^2 - B*h + a*b*f.
+                Real const a = (dd[j] - dOrigin) - mu;
+                Real h;
+                bool valid = false;
+                if (j + 1 < K)
+                {
+                    Real const b = (dd[j + 1] - dOrigin) - mu;
+                    Real const c = f - dpsi * a - dphi * b;
+                    Real const B = c * (a + b) + dpsi * a * a + dphi * b * b;
+                    Real const C = a * b * f;
+                    Real const discriminant = std::max(B * B - (Real)4 * c * C, zero);
+                    Real const denom = (B >= zero ? B + std::sqrt(discriminant) : B - std::sqrt(discriminant));
+                    if (denom != zero)
+                    {
+                        // The root of smaller magnitude, which is the
+                        // root in (a,b) for a step near the solution.
+                        h = (Real)2 * C / denom;
+                        valid = (a < h && h < b);
+                        if (!valid && c != zero)
+                        {
+                            h = denom / ((Real)2 * c);
+                            valid = (a < h && h < b);
+                        }
+                    }
+                }
+                else
+                {
+                    Real const c = f - dpsi * a;
+                    if (c > zero)
+                    {
+                        h = a + dpsi * a * a / c;
+                        valid = true;
+                    }
+                }
+
+                Real next = (valid ? mu + h : mu);
+                if (!(lower < next && next < upper))
+                {
+                    next = half * (lower + upper);
+                }
+                if (next == mu)
+                {
+                    break;
+                }
+                mu = next;
+            }
+        }
+
+        // Return true when the permutation is odd.
+        static bool GetPermutationParity(std::vector<std::size_t> const& permutation)
+        {
+            std::size_t const m = permutation.size();
+            std::vector<uint8_t> visited(m, 0);
+            std::size_t numCycles = 0;
+            for (std::size_t i = 0; i < m; ++i)
+            {
+                if (visited[i] == 0)
+                {
+                    ++numCycles;
+                    for (std::size_t k = i; visited[k] == 0; k = permutation[k])
+                    {
+                        visited[k] = 1;
+                    }
+                }
+            }
+            return ((m - numCycles) & 1) != 0;
+        }
+
+        // Replace the row-major NxN matrix X by H*X, where H is the product
+        // of the Householder reflections stored in mMatrix.  The columns of
+        // X are processed in independent blocks of columnBlockSize/4
+        // columns that are distributed among the threads.  All reflections
+        // are applied to a block while it is in cache.
+        void ApplyHouseholderReflections(Real* X) const
+        {
+            std::size_t const n = static_cast<std::size_t>(mSize);
+            if (n < 3)
+            {
+                return;
+            }
+
+            // Copy each vector v, without its leading zeros, to contiguous
+            // memory.  The component at index i+1 is 1.
+            std::size_t const numReflections = n - 2;
+            std::vector<std::size_t> offset(numReflections + 1);
+            offset[0] = 0;
+            for (std::size_t i = 0; i < numReflections; ++i)
+            {
+                offset[i + 1] = offset[i] + (n - 1 - i);
+            }
+            std::vector<Real> vectors(offset[numReflections]), twoinvvdv(numReflections);
+            for (std::size_t i = 0; i < numReflections; ++i)
+            {
+                Real* v = &vectors[offset[i]] - (i + 1);
+                twoinvvdv[i] = mMatrix[(i + 1) * n + i];
+                v[i + 1] = (Real)1;
+                for (std::size_t r = i + 2; r < n; ++r)
+                {
+                    v[r] = mMatrix[r * n + i];
+                }
+            }
+
+            std::size_t constexpr blockSize = columnBlockSize / 4;
+            std::size_t const numBlocks = (n + blockSize - 1) / blockSize;
+            std::size_t const numThreads = std::min(mNumThreads, numBlocks);
+            RunThreads(numThreads, [&](std::size_t t)
+            {
+                std::vector<Real> w(blockSize);
+                for (std::size_t block = t; block < numBlocks; block += numThreads)
+                {
+                    std::size_t const c0 = block * blockSize;
+                    std::size_t const width = std::min(blockSize, n - c0);
+                    for (std::size_t i = numReflections; i-- > 0; )
+                    {
+                        // X <- X - v*((2/Dot(v,v))*v^T*X)
+                        Real const* v = &vectors[offset[i]] - (i + 1);
+                        std::fill(w.begin(), w.begin() + width, (Real)0);
+                        for (std::size_t r = i + 1; r < n; ++r)
+                        {
+                            Real const vr = v[r];
+                            Real const* x = X + r * n + c0;
+                            for (std::size_t c = 0; c < width; ++c)
+                            {
+                                w[c] += vr * x[c];
+                            }
+                        }
+                        for (std::size_t c = 0; c < width; ++c)
+                        {
+                            w[c] *= twoinvvdv[i];
+                        }
+                        for (std::size_t r = i + 1; r < n; ++r)
+                        {
+                            Real const vr = v[r];
+                            Real* x = X + r * n + c0;
+                            for (std::size_t c = 0; c < width; ++c)
+                            {
+                                x[c] -= vr * w[c];
+                            }
+                        }
+                    }
+                }
+            });
+        }
+
         // Sort the eigenvalues and compute the corresponding permutation of
         // the indices of the array storing the eigenvalues.  The permutation
         // is used for reordering the eigenvalues and eigenvectors in the
@@ -772,6 +1744,18 @@ namespace gte
         // matrix to a diagonal matrix.
         uint32_t mMaxIterations;
 
+        // The algorithm selected at construction and the number of threads
+        // for the divide-and-conquer algorithm.
+        Algorithm mAlgorithm;
+        std::size_t mNumThreads;
+
+        // The eigenvectors of the tridiagonal matrix computed by the
+        // divide-and-conquer algorithm, stored as the columns of an NxN
+        // matrix in row-major order, and whether that matrix is a
+        // reflection.
+        std::vector<Real> mTridiagonalEigenvectors;
+        bool mTridiagonalReflection;
+
         // The internal copy of a matrix passed to the solver.  See the
         // comments about function Tridiagonalize() about what is stored in
         // the matrix.
@@ -0,0 +1,283 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2026
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 8.3.2026.10.18
+
+#pragma once
+
+// Eigensystems of many 3x3 symmetric real-valued matrices. The matrices are
+// stored as a structure of arrays, one array per unique entry, and are
+// processed in groups of NumLanes matrices. Within a group, each step of the
+// algorithm is a loop over the lanes without branches, so the compiler can
+// vectorize it. The loops contain square roots; the compiler vectorizes
+// them only when errno is not required for std::sqrt (for example, with
+// -fno-math-errno for GCC and Clang).
+//
+// The algorithm is the cyclic Jacobi method with a fixed number of sweeps.
+// Each matrix is first scaled by the reciprocal of its maximum-magnitude
+// entry. A Jacobi rotation for (p,q) zeroes the entry a(p,q) of the scaled
+// matrix. The rotation angle is the smaller of the two choices, which
+// ensures convergence. The cyclic Jacobi method converges quadratically
+// for 3x3 matrices, including those with repeated eigenvalues, and the
+// number of sweeps is chosen so that the off-diagonal entries of the scaled
+// matrix are negligible for all inputs.
+//
+// Let m be the maximum magnitude of the entries of A and let e be the
+// machine epsilon of T. For the computed eigenvalues d[i] and the
+// orthonormal eigenvectors v[i],
+//   |A*v[i] - d[i]*v[i]| <= 8*e*m,
+//   |Dot(v[i],v[j]) - delta(i,j)| <= 16*e,
+//   |d[i] - lambda[i]| <= 8*e*m,
+// where lambda[i] are the exact eigenvalues. These bounds were measured on
+// millions of random matrices, including matrices with nearly repeated and
+// exactly repeated eigenvalues and matrices with entries of widely varying
+// magnitudes; the largest observed values were about 6*e*m, 10*e and
+// 6*e*m, respectively. The eigenvalues differ from those computed by
+// SymmetricEigensolver3x3 by at most the sum of the errors of the two
+// solvers. An eigenvector for an eigenvalue of multiplicity 1 agrees up to
+// sign with that of SymmetricEigensolver3x3 to within an error proportional
+// to e*m divided by the distance to the other eigenvalues. For a repeated
+// eigenvalue, the eigenvectors can be a different orthonormal basis of the
+// eigenspace.
+//
+// The eigenvectors form a right-handed orthonormal set for every sortType.
+// The eigenvalues are not sorted when sortType is 0, in which case their
+// order is that of the diagonal entries after the Jacobi iterations.
+
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace gte
+{
+    template <typename T, std::size_t NumLanes = 16>
+    class SymmetricEigensolver3x3Batch
+    {
+    public:
+        static_assert(
+            NumLanes == 4 || NumLanes == 8 || NumLanes == 16,
+            "The number of lanes must be 4, 8 or 16.");
+
+        // The input matrices are (a00[k], a01[k], a02[k], a11[k], a12[k],
+        // a22[k]) for 0 <= k < numMatrices. The output eigenvalues are
+        // eval[i][k] for 0 <= i < 3 and the eigenvector for eval[i][k] is
+        // (evec[3*i][k], evec[3*i+1][k], evec[3*i+2][k]), the same order as
+        // the outputs eval[i] and evec[i] of SymmetricEigensolver3x3. The
+        // order of the eigenvalues is specified by sortType: -1 (decreasing),
+        // 0 (no sorting) or +1 (increasing). Set numThreads to 0 or 1 to
+        // execute in the main thread. Set numThreads to 2 or larger to
+        // distribute the groups of matrices among that many threads. The
+        // results do not depend on the number of threads.
+        void operator()(std::size_t numMatrices,
+            T const* a00, T const* a01, T const* a02,
+            T const* a11, T const* a12, T const* a22,
+            int32_t sortType, std::array<T*, 3> const& eval,
+            std::array<T*, 9> const& evec, std::size_t numThreads = 0) const
+        {
+            LogAssert(
+                sortType >= -1 && sortType <= 1,
+                "Invalid sortType.");
+
+            std::array<T const*, 6> const input{ a00, a01, a02, a11, a12, a22 };
+            std::size_t const numGroups = (numMatrices + NumLanes - 1) / NumLanes;
+            numThreads = std::min(numThreads, numGroups);
+            if (numThreads <= 1)
+            {
+                for (std::size_t group = 0; group < numGroups; ++group)
+                {
+                    ProcessGroup(numMatrices, group * NumLanes, input, sortType, eval, evec);
+                }
+            }
+            else
+            {
+                // Each thread processes a contiguous range of groups.
+                std::vector<std::thread> process(numThreads);
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    std::size_t const gMin = t * numGroups / numThreads;
+                    std::size_t const gSup = (t + 1) * numGroups / numThreads;
+                    process[t] = std::thread([this, numMatrices, &input, sortType,
+                        &eval, &evec, gMin, gSup]()
+                    {
+                        for (std::size_t group = gMin; group < gSup; ++group)
+                        {
+                            ProcessGroup(numMatrices, group * NumLanes, input, sortType, eval, evec);
+                        }
+                    });
+                }
+                for (std::size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+        }
+
+        // The number of Jacobi sweeps, each consisting of the rotations for
+        // (0,1), (0,2) and (1,2).
+        static int32_t constexpr numSweeps = (std::numeric_limits<T>::digits <= 53 ? 4 : 5);
+
+    private:
+        typedef std::array<T, NumLanes> Lanes;
+
+        // Compute the eigensystems of the matrices with indices in
+        // [kMin,kMin+NumLanes) that are smaller than numMatrices. The unused
+        // lanes of the last group are processed with the zero matrix.
+        void ProcessGroup(std::size_t numMatrices, std::size_t kMin,
+            std::array<T const*, 6> const& input, int32_t sortType,
+            std::array<T*, 3> const& eval, std::array<T*, 9> const& evec) const
+        {
+            T const zero = static_cast<T>(0);
+            T const one = static_cast<T>(1);
+            std::size_t const count = std::min(NumLanes, numMatrices - kMin);
+
+            // The entries of the matrices, indexed as a00, a01, a02, a11,
+            // a12 and a22, and the columns of the eigenvector matrices,
+            // V[3*c+r] storing row r of column c.
+            std::array<Lanes, 6> A{};
+            std::array<Lanes, 9> V{};
+            for (std::size_t i = 0; i < 6; ++i)
+            {
+                std::copy(input[i] + kMin, input[i] + kMin + count, A[i].begin());
+                std::fill(A[i].begin() + count, A[i].end(), zero);
+            }
+            for (std::size_t i = 0; i < 9; ++i)
+            {
+                V[i].fill((i % 4 == 0) ? one : zero);
+            }
+
+            // Scale the matrices so that the maximum magnitude of the
+            // entries is 1, which avoids overflow and underflow in the
+            // rotations. The zero matrix is scaled by 1/min(T).
+            Lanes scale{};
+            for (std::size_t l = 0; l < NumLanes; ++l)
+            {
+                T maxAbs = std::numeric_limits<T>::min();
+                for (std::size_t i = 0; i < 6; ++i)
+                {
+                    maxAbs = std::max(maxAbs, std::fabs(A[i][l]));
+                }
+                scale[l] = maxAbs;
+            }
+            for (std::size_t i = 0; i < 6; ++i)
+            {
+                for (std::size_t l = 0; l < NumLanes; ++l)
+                {
+                    A[i][l] /= scale[l];
+                }
+            }
+
+            for (int32_t sweep = 0; sweep < numSweeps; ++sweep)
+            {
+                // The arguments are app, aqq, apq, arp, arq, where r is the
+                // index different from p and q, and the columns p and q of
+                // the eigenvector matrix.
+                Rotate(A[0], A[3], A[1], A[2], A[4], &V[0], &V[3]);
+                Rotate(A[0], A[5], A[2], A[1], A[4], &V[0], &V[6]);
+                Rotate(A[3], A[5], A[4], A[1], A[2], &V[3], &V[6]);
+            }
+
+            std::array<Lanes, 3> D{};
+            for (std::size_t l = 0; l < NumLanes; ++l)
+            {
+                D[0][l] = A[0][l] * scale[l];
+                D[1][l] = A[3][l] * scale[l];
+                D[2][l] = A[5][l] * scale[l];
+            }
+
+            if (sortType != 0)
+            {
+                // A sorting network of three compare-exchange operations.
+                Sort(sortType, 0, 1, D, V);
+                Sort(sortType, 1, 2, D, V);
+                Sort(sortType, 0, 1, D, V);
+            }
+
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                std::copy(D[i].begin(), D[i].begin() + count, eval[i] + kMin);
+            }
+            for (std::size_t i = 0; i < 9; ++i)
+            {
+                std::copy(V[i].begin(), V[i].begin() + count, evec[i] + kMin);
+            }
+        }
+
+        // Apply the Jacobi rotation that zeroes apq. With d = aqq - app, the
+        // tangent of the rotation angle is
+        //   t = sign(d)*2*apq/(|d| + sqrt(d^2 + 4*apq^2)),
+        // which satisfies |t| <= 1. The smallest normal number is added to
+        // the denominator so that t = 0 when d = apq = 0. The entries of the
+        // scaled matrix are at most 1 in magnitude, so an apq smaller than
+        // e^2 is replaced by zero. This perturbation is much smaller than
+        // the rounding errors and it prevents the quadratically decreasing
+        // off-diagonal entries from becoming subnormal, which is slow on
+        // many processors.
+        static void Rotate(Lanes& app, Lanes& aqq, Lanes& apq, Lanes& arp,
+            Lanes& arq, Lanes* vp, Lanes* vq)
+        {
+            T const zero = static_cast<T>(0);
+            T const one = static_cast<T>(1);
+            T const two = static_cast<T>(2);
+            T const tiny = std::numeric_limits<T>::min();
+            T const threshold = std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon();
+            for (std::size_t l = 0; l < NumLanes; ++l)
+            {
+                T const d = aqq[l] - app[l];
+                T const a = (std::fabs(apq[l]) >= threshold ? apq[l] : zero);
+                T const root = std::sqrt(d * d + two * two * a * a);
+                T const t = std::copysign(one, d) * two * a / (std::fabs(d) + root + tiny);
+                T const c = one / std::sqrt(one + t * t);
+                T const s = t * c;
+                T const ta = t * a;
+                app[l] -= ta;
+                aqq[l] += ta;
+                apq[l] = zero;
+
+                T const rp = arp[l], rq = arq[l];
+                arp[l] = c * rp - s * rq;
+                arq[l] = s * rp + c * rq;
+
+                for (std::size_t r = 0; r < 3; ++r)
+                {
+                    T const qp = vp[r][l], qq = vq[r][l];
+                    vp[r][l] = c * qp - s * qq;
+                    vq[r][l] = s * qp + c * qq;
+                }
+            }
+        }
+
+        // Exchange the eigenvalues i < j when they are out of order. The
+        // eigenvector j is replaced by the negated eigenvector i, which
+        // preserves the right-handedness of the eigenvectors.
+        static void Sort(int32_t sortType, std::size_t i, std::size_t j,
+            std::array<Lanes, 3>& D, std::array<Lanes, 9>& V)
+        {
+            Lanes& di = D[i];
+            Lanes& dj = D[j];
+            Lanes* vi = &V[3 * i];
+            Lanes* vj = &V[3 * j];
+            T const sign = static_cast<T>(sortType);
+            for (std::size_t l = 0; l < NumLanes; ++l)
+            {
+                bool const exchange = (sign * di[l] > sign * dj[l]);
+                T const valueI = di[l], valueJ = dj[l];
+                di[l] = (exchange ? valueJ : valueI);
+                dj[l] = (exchange ? valueI : valueJ);
+                for (std::size_t r = 0; r < 3; ++r)
+                {
+                    T const qi = vi[r][l], qj = vj[r][l];
+                    vi[r][l] = (exchange ? qj : qi);
+                    vj[r][l] = (exchange ? -qi : qj);
+                }
+            }
+        }
+    };
+}